@@ -178,12 +178,12 @@ void z_arm64_secondary_start(void)
 
 #ifdef CONFIG_SMP
 
-static void broadcast_ipi(unsigned int ipi)
+static void send_ipi(unsigned int ipi, uint32_t cpu_bitmap)
 {
 	uint64_t mpidr = MPIDR_TO_CORE(GET_MPIDR());
 
 	/*
-	 * Send SGI to all cores except itself
+	 * Send SGI to the cores of the bitmap except itself
 	 */
 	unsigned int num_cpus = arch_num_cpus();
 
@@ -191,7 +191,8 @@ static void broadcast_ipi(unsigned int ipi)
 		uint64_t target_mpidr = cpu_map[i];
 		uint8_t aff0;
 
-		if (mpidr == target_mpidr || target_mpidr == INV_MPID) {
+		if (mpidr == target_mpidr || target_mpidr == INV_MPID ||
+		    (cpu_bitmap & BIT(i)) == 0) {
 			continue;
 		}
 
@@ -207,12 +208,22 @@ void sched_ipi_handler(const void *unused)
 	z_sched_ipi();
 }
 
+static void broadcast_ipi(unsigned int ipi)
+{
+	send_ipi(ipi, UINT32_MAX);
+}
+
 /* arch implementation of sched_ipi */
 void arch_sched_ipi(void)
 {
 	broadcast_ipi(SGI_SCHED_IPI);
 }
 
+void arch_sched_directed_ipi(uint32_t cpu_bitmap)
+{
+	send_ipi(SGI_SCHED_IPI, cpu_bitmap);
+}
+
 #ifdef CONFIG_USERSPACE
 void mem_cfg_ipi_handler(const void *unused)
 {
@@ -32,6 +32,9 @@ static int currently_running_irq = -1;
 static inline void vector_to_irq(int irq_nbr, int *may_swap)
 {
 	sys_trace_isr_enter();
+#ifdef CONFIG_SCHED_ISR_USAGE_HISTOGRAM
+	z_sched_usage_isr_start();
+#endif
 
 	if (irq_vector_table[irq_nbr].func == NULL) { /* LCOV_EXCL_BR_LINE */
 		/* LCOV_EXCL_START */
@@ -53,6 +56,9 @@ static inline void vector_to_irq(int irq_nbr, int *may_swap)
 		}
 	}
 
+#ifdef CONFIG_SCHED_ISR_USAGE_HISTOGRAM
+	z_sched_usage_isr_stop(irq_nbr);
+#endif
 	sys_trace_isr_exit();
 }
 
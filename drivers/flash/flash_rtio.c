@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_REGISTER(flash_rtio, CONFIG_FLASH_LOG_LEVEL);
+
+static K_THREAD_STACK_DEFINE(flash_rtio_stack, CONFIG_FLASH_RTIO_FALLBACK_STACK_SIZE);
+static struct k_work_q flash_rtio_work_q;
+static struct rtio_mpsc flash_rtio_q = RTIO_MPSC_INIT((flash_rtio_q));
+
+static int flash_rtio_exec(const struct device *dev, const struct rtio_sqe *sqe)
+{
+	switch (sqe->op) {
+	case RTIO_OP_NOP:
+		return 0;
+	case RTIO_OP_FLASH_READ:
+		return flash_read(dev, sqe->flash_off, sqe->flash_buf, sqe->flash_len);
+	case RTIO_OP_FLASH_WRITE:
+		return flash_write(dev, sqe->flash_off, sqe->flash_buf, sqe->flash_len);
+	case RTIO_OP_FLASH_ERASE:
+		return flash_erase(dev, sqe->flash_off, sqe->flash_len);
+	default:
+		LOG_ERR("Unsupported op %u", sqe->op);
+		return -EINVAL;
+	}
+}
+
+/*
+ * Executes queued requests, one transaction at a time, using the blocking
+ * driver API. The single work queue thread keeps the submission order.
+ */
+static void flash_rtio_fallback_handler(struct k_work *work)
+{
+	struct rtio_mpsc_node *node;
+
+	ARG_UNUSED(work);
+
+	while ((node = rtio_mpsc_pop(&flash_rtio_q)) != NULL) {
+		struct rtio_iodev_sqe *iodev_sqe =
+			CONTAINER_OF(node, struct rtio_iodev_sqe, q);
+		const struct device *dev = iodev_sqe->sqe.iodev->data;
+		struct rtio_iodev_sqe *curr = iodev_sqe;
+		int rc;
+
+		do {
+			rc = flash_rtio_exec(dev, &curr->sqe);
+			curr = rtio_txn_next(curr);
+		} while (rc == 0 && curr != NULL);
+
+		if (rc < 0) {
+			rtio_iodev_sqe_err(iodev_sqe, rc);
+		} else {
+			rtio_iodev_sqe_ok(iodev_sqe, 0);
+		}
+	}
+}
+
+static K_WORK_DEFINE(flash_rtio_work, flash_rtio_fallback_handler);
+
+static void flash_iodev_submit(struct rtio_iodev_sqe *iodev_sqe)
+{
+	const struct device *dev = iodev_sqe->sqe.iodev->data;
+	const struct flash_driver_api *api = dev->api;
+
+	if (api->iodev_submit != NULL) {
+		api->iodev_submit(dev, iodev_sqe);
+		return;
+	}
+
+	rtio_mpsc_push(&flash_rtio_q, &iodev_sqe->q);
+	k_work_submit_to_queue(&flash_rtio_work_q, &flash_rtio_work);
+}
+
+const struct rtio_iodev_api flash_iodev_api = {
+	.submit = flash_iodev_submit,
+};
+
+static int flash_rtio_work_q_init(void)
+{
+	k_work_queue_start(&flash_rtio_work_q, flash_rtio_stack,
+			   K_THREAD_STACK_SIZEOF(flash_rtio_stack),
+			   CONFIG_FLASH_RTIO_FALLBACK_PRIORITY, NULL);
+	k_thread_name_set(&flash_rtio_work_q.thread, "flash_rtio");
+
+	return 0;
+}
+
+SYS_INIT(flash_rtio_work_q_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
@@ -178,9 +178,9 @@ static int flash_range_is_valid(const struct device *dev, off_t offset,
 	return 1;
 }
 
-static int flash_sim_read(const struct device *dev, const off_t offset,
-			  void *data,
-			  const size_t len)
+static int flash_sim_do_read(const struct device *dev, const off_t offset,
+			     void *data,
+			     const size_t len)
 {
 	ARG_UNUSED(dev);
 
@@ -201,7 +201,6 @@ static int flash_sim_read(const struct device *dev, const off_t offset,
 	FLASH_SIM_STATS_INCN(flash_sim_stats, bytes_read, len);
 
 #ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
-	k_busy_wait(CONFIG_FLASH_SIMULATOR_MIN_READ_TIME_US);
 	FLASH_SIM_STATS_INCN(flash_sim_stats, flash_read_time_us,
 		   CONFIG_FLASH_SIMULATOR_MIN_READ_TIME_US);
 #endif
@@ -209,8 +208,23 @@ static int flash_sim_read(const struct device *dev, const off_t offset,
 	return 0;
 }
 
-static int flash_sim_write(const struct device *dev, const off_t offset,
-			   const void *data, const size_t len)
+static int flash_sim_read(const struct device *dev, const off_t offset,
+			  void *data,
+			  const size_t len)
+{
+	int rc = flash_sim_do_read(dev, offset, data, len);
+
+#ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
+	if (rc == 0) {
+		k_busy_wait(CONFIG_FLASH_SIMULATOR_MIN_READ_TIME_US);
+	}
+#endif
+
+	return rc;
+}
+
+static int flash_sim_do_write(const struct device *dev, const off_t offset,
+			      const void *data, const size_t len)
 {
 	uint8_t buf[FLASH_SIMULATOR_PROG_UNIT];
 	ARG_UNUSED(dev);
@@ -275,8 +289,6 @@ static int flash_sim_write(const struct device *dev, const off_t offset,
 	FLASH_SIM_STATS_INCN(flash_sim_stats, bytes_written, len);
 
 #ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
-	/* wait before returning */
-	k_busy_wait(CONFIG_FLASH_SIMULATOR_MIN_WRITE_TIME_US);
 	FLASH_SIM_STATS_INCN(flash_sim_stats, flash_write_time_us,
 		   CONFIG_FLASH_SIMULATOR_MIN_WRITE_TIME_US);
 #endif
@@ -284,6 +296,21 @@ static int flash_sim_write(const struct device *dev, const off_t offset,
 	return 0;
 }
 
+static int flash_sim_write(const struct device *dev, const off_t offset,
+			   const void *data, const size_t len)
+{
+	int rc = flash_sim_do_write(dev, offset, data, len);
+
+#ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
+	/* wait before returning */
+	if (rc == 0) {
+		k_busy_wait(CONFIG_FLASH_SIMULATOR_MIN_WRITE_TIME_US);
+	}
+#endif
+
+	return rc;
+}
+
 static void unit_erase(const uint32_t unit)
 {
 	const off_t unit_addr = FLASH_SIMULATOR_BASE_OFFSET +
@@ -294,8 +321,8 @@ static void unit_erase(const uint32_t unit)
 	       FLASH_SIMULATOR_ERASE_UNIT);
 }
 
-static int flash_sim_erase(const struct device *dev, const off_t offset,
-			   const size_t len)
+static int flash_sim_do_erase(const struct device *dev, const off_t offset,
+			      const size_t len)
 {
 	ARG_UNUSED(dev);
 
@@ -329,8 +356,6 @@ static int flash_sim_erase(const struct device *dev, const off_t offset,
 	}
 
 #ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
-	/* wait before returning */
-	k_busy_wait(CONFIG_FLASH_SIMULATOR_MIN_ERASE_TIME_US);
 	FLASH_SIM_STATS_INCN(flash_sim_stats, flash_erase_time_us,
 		   CONFIG_FLASH_SIMULATOR_MIN_ERASE_TIME_US);
 #endif
@@ -338,6 +363,138 @@ static int flash_sim_erase(const struct device *dev, const off_t offset,
 	return 0;
 }
 
+static int flash_sim_erase(const struct device *dev, const off_t offset,
+			   const size_t len)
+{
+	int rc = flash_sim_do_erase(dev, offset, len);
+
+#ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
+	/* wait before returning */
+	if (rc == 0) {
+		k_busy_wait(CONFIG_FLASH_SIMULATOR_MIN_ERASE_TIME_US);
+	}
+#endif
+
+	return rc;
+}
+
+#ifdef CONFIG_FLASH_RTIO
+/*
+ * Requests are executed one at a time, in submission order. The memory is
+ * updated when a request starts and, with timing simulation enabled, the
+ * completion is reported from a timer once the simulated operation time has
+ * elapsed, leaving the CPU free in the meantime.
+ */
+static struct rtio_mpsc flash_sim_rtio_q = RTIO_MPSC_INIT((flash_sim_rtio_q));
+static struct rtio_iodev_sqe *flash_sim_rtio_cur;
+static struct k_spinlock flash_sim_rtio_lock;
+
+static int flash_sim_rtio_exec(const struct device *dev,
+			       const struct rtio_sqe *sqe, uint32_t *time_us)
+{
+	switch (sqe->op) {
+	case RTIO_OP_NOP:
+		return 0;
+	case RTIO_OP_FLASH_READ:
+#ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
+		*time_us += CONFIG_FLASH_SIMULATOR_MIN_READ_TIME_US;
+#endif
+		return flash_sim_do_read(dev, sqe->flash_off, sqe->flash_buf,
+					 sqe->flash_len);
+	case RTIO_OP_FLASH_WRITE:
+#ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
+		*time_us += CONFIG_FLASH_SIMULATOR_MIN_WRITE_TIME_US;
+#endif
+		return flash_sim_do_write(dev, sqe->flash_off, sqe->flash_buf,
+					  sqe->flash_len);
+	case RTIO_OP_FLASH_ERASE:
+#ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
+		*time_us += CONFIG_FLASH_SIMULATOR_MIN_ERASE_TIME_US;
+#endif
+		return flash_sim_do_erase(dev, sqe->flash_off, sqe->flash_len);
+	default:
+		return -EINVAL;
+	}
+}
+
+/* Makes the next queued request current, returns NULL if there is none */
+static struct rtio_iodev_sqe *flash_sim_rtio_next(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&flash_sim_rtio_lock);
+	struct rtio_mpsc_node *node = rtio_mpsc_pop(&flash_sim_rtio_q);
+
+	flash_sim_rtio_cur = (node != NULL) ?
+		CONTAINER_OF(node, struct rtio_iodev_sqe, q) : NULL;
+	k_spin_unlock(&flash_sim_rtio_lock, key);
+
+	return flash_sim_rtio_cur;
+}
+
+static void flash_sim_rtio_timeout(struct k_timer *timer);
+
+static K_TIMER_DEFINE(flash_sim_rtio_timer, flash_sim_rtio_timeout, NULL);
+
+/*
+ * Runs requests until one has to wait for its simulated time to elapse.
+ * The request stays current while it is being completed, so that chained
+ * requests submitted from the completion are queued behind it.
+ */
+static void flash_sim_rtio_run(struct rtio_iodev_sqe *iodev_sqe)
+{
+	while (iodev_sqe != NULL) {
+		const struct device *dev = iodev_sqe->sqe.iodev->data;
+		struct rtio_iodev_sqe *curr = iodev_sqe;
+		uint32_t time_us = 0;
+		int rc;
+
+		do {
+			rc = flash_sim_rtio_exec(dev, &curr->sqe, &time_us);
+			curr = rtio_txn_next(curr);
+		} while (rc == 0 && curr != NULL);
+
+		if (rc < 0) {
+			rtio_iodev_sqe_err(iodev_sqe, rc);
+		} else if (time_us > 0) {
+			k_timer_start(&flash_sim_rtio_timer, K_USEC(time_us),
+				      K_NO_WAIT);
+			return;
+		} else {
+			rtio_iodev_sqe_ok(iodev_sqe, 0);
+		}
+
+		iodev_sqe = flash_sim_rtio_next();
+	}
+}
+
+static void flash_sim_rtio_timeout(struct k_timer *timer)
+{
+	ARG_UNUSED(timer);
+
+	rtio_iodev_sqe_ok(flash_sim_rtio_cur, 0);
+	flash_sim_rtio_run(flash_sim_rtio_next());
+}
+
+static void flash_sim_iodev_submit(const struct device *dev,
+				   struct rtio_iodev_sqe *iodev_sqe)
+{
+	k_spinlock_key_t key = k_spin_lock(&flash_sim_rtio_lock);
+	bool idle = (flash_sim_rtio_cur == NULL);
+
+	ARG_UNUSED(dev);
+
+	if (idle) {
+		flash_sim_rtio_cur = iodev_sqe;
+	} else {
+		rtio_mpsc_push(&flash_sim_rtio_q, &iodev_sqe->q);
+	}
+	k_spin_unlock(&flash_sim_rtio_lock, key);
+
+	if (idle) {
+		flash_sim_rtio_run(iodev_sqe);
+	}
+}
+#endif /* CONFIG_FLASH_RTIO */
+
 #ifdef CONFIG_FLASH_PAGE_LAYOUT
 static const struct flash_pages_layout flash_sim_pages_layout = {
 	.pages_count = FLASH_SIMULATOR_PAGE_COUNT,
@@ -369,6 +526,9 @@ static const struct flash_driver_api flash_sim_api = {
 #ifdef CONFIG_FLASH_PAGE_LAYOUT
 	.page_layout = flash_sim_page_layout,
 #endif
+#ifdef CONFIG_FLASH_RTIO
+	.iodev_submit = flash_sim_iodev_submit,
+#endif
 };
 
 #ifdef CONFIG_ARCH_POSIX
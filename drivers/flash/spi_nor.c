@@ -170,6 +170,25 @@ struct spi_nor_data {
 #endif /* CONFIG_FLASH_PAGE_LAYOUT */
 #endif /* CONFIG_SPI_NOR_SFDP_RUNTIME */
 #endif /* CONFIG_SPI_NOR_SFDP_MINIMAL */
+
+#ifdef CONFIG_FLASH_RTIO
+	const struct device *dev;
+	/* Queued RTIO requests, protected by rtio_lock */
+	struct rtio_mpsc rtio_q;
+	struct k_spinlock rtio_lock;
+	/* First request of the transaction being executed */
+	struct rtio_iodev_sqe *rtio_cur;
+	/* Request being executed and its remaining part */
+	struct rtio_iodev_sqe *rtio_sqe;
+	off_t rtio_addr;
+	uint8_t *rtio_buf;
+	size_t rtio_len;
+	/* Set when the device has been acquired for the transaction */
+	bool rtio_acquired;
+	/* Set while a program or erase command is in progress */
+	bool rtio_wip;
+	struct k_work_delayable rtio_work;
+#endif /* CONFIG_FLASH_RTIO */
 };
 
 #ifdef CONFIG_SPI_NOR_SFDP_MINIMAL
@@ -702,12 +721,40 @@ static int spi_nor_read(const struct device *dev, off_t addr, void *dest,
 	return ret;
 }
 
+/**
+ * @brief Get the number of bytes a single page program command can write
+ *
+ * @param dev Device struct
+ * @param addr The address to start programming at
+ * @param size The number of bytes remaining to be written
+ *
+ * @return the number of bytes to write with the next page program command
+ */
+static size_t spi_nor_program_size(const struct device *dev, off_t addr,
+				   size_t size)
+{
+	const uint16_t page_size = dev_page_size(dev);
+	size_t to_write = size;
+
+	/* Don't write more than a page. */
+	if (to_write >= page_size) {
+		to_write = page_size;
+	}
+
+	/* Don't write across a page boundary */
+	if (((addr + to_write - 1U) / page_size)
+	!= (addr / page_size)) {
+		to_write = page_size - (addr % page_size);
+	}
+
+	return to_write;
+}
+
 static int spi_nor_write(const struct device *dev, off_t addr,
 			 const void *src,
 			 size_t size)
 {
 	const size_t flash_size = dev_flash_size(dev);
-	const uint16_t page_size = dev_page_size(dev);
 	int ret = 0;
 
 	/* should be between 0 and flash size */
@@ -719,18 +766,7 @@ static int spi_nor_write(const struct device *dev, off_t addr,
 	ret = spi_nor_write_protection_set(dev, false);
 	if (ret == 0) {
 		while (size > 0) {
-			size_t to_write = size;
-
-			/* Don't write more than a page. */
-			if (to_write >= page_size) {
-				to_write = page_size;
-			}
-
-			/* Don't write across a page boundary */
-			if (((addr + to_write - 1U) / page_size)
-			!= (addr / page_size)) {
-				to_write = page_size - (addr % page_size);
-			}
+			size_t to_write = spi_nor_program_size(dev, addr, size);
 
 			spi_nor_cmd_write(dev, SPI_NOR_CMD_WREN);
 			ret = spi_nor_cmd_addr_write(dev, SPI_NOR_CMD_PP, addr,
@@ -757,6 +793,56 @@ static int spi_nor_write(const struct device *dev, off_t addr,
 	return ret;
 }
 
+/**
+ * @brief Start erasing the largest possible region at a given address
+ *
+ * @note The device must be externally acquired before invoking this
+ * function. The caller has to wait for the device to be ready before
+ * issuing further commands.
+ *
+ * @param dev Device struct
+ * @param addr The address to start erasing at
+ * @param size The number of bytes remaining to be erased
+ * @param erased Set to the number of bytes being erased
+ *
+ * @return 0 on success, negative errno code otherwise
+ */
+static int spi_nor_erase_start(const struct device *dev, off_t addr,
+			       size_t size, size_t *erased)
+{
+	spi_nor_cmd_write(dev, SPI_NOR_CMD_WREN);
+
+	if (size == dev_flash_size(dev)) {
+		/* chip erase */
+		*erased = size;
+		return spi_nor_cmd_write(dev, SPI_NOR_CMD_CE);
+	}
+
+	const struct jesd216_erase_type *erase_types = dev_erase_types(dev);
+	const struct jesd216_erase_type *bet = NULL;
+
+	for (uint8_t ei = 0; ei < JESD216_NUM_ERASE_TYPES; ++ei) {
+		const struct jesd216_erase_type *etp = &erase_types[ei];
+
+		if ((etp->exp != 0)
+		    && SPI_NOR_IS_ALIGNED(addr, etp->exp)
+		    && (size >= BIT(etp->exp))
+		    && ((bet == NULL)
+			|| (etp->exp > bet->exp))) {
+			bet = etp;
+		}
+	}
+
+	if (bet == NULL) {
+		LOG_DBG("Can't erase %zu at 0x%lx", size, (long)addr);
+		return -EINVAL;
+	}
+
+	*erased = BIT(bet->exp);
+
+	return spi_nor_cmd_addr_write(dev, bet->cmd, addr, NULL, 0);
+}
+
 static int spi_nor_erase(const struct device *dev, off_t addr, size_t size)
 {
 	const size_t flash_size = dev_flash_size(dev);
@@ -781,38 +867,12 @@ static int spi_nor_erase(const struct device *dev, off_t addr, size_t size)
 	ret = spi_nor_write_protection_set(dev, false);
 
 	while ((size > 0) && (ret == 0)) {
-		spi_nor_cmd_write(dev, SPI_NOR_CMD_WREN);
+		size_t erased;
 
-		if (size == flash_size) {
-			/* chip erase */
-			spi_nor_cmd_write(dev, SPI_NOR_CMD_CE);
-			size -= flash_size;
-		} else {
-			const struct jesd216_erase_type *erase_types =
-				dev_erase_types(dev);
-			const struct jesd216_erase_type *bet = NULL;
-
-			for (uint8_t ei = 0; ei < JESD216_NUM_ERASE_TYPES; ++ei) {
-				const struct jesd216_erase_type *etp =
-					&erase_types[ei];
-
-				if ((etp->exp != 0)
-				    && SPI_NOR_IS_ALIGNED(addr, etp->exp)
-				    && (size >= BIT(etp->exp))
-				    && ((bet == NULL)
-					|| (etp->exp > bet->exp))) {
-					bet = etp;
-				}
-			}
-			if (bet != NULL) {
-				spi_nor_cmd_addr_write(dev, bet->cmd, addr, NULL, 0);
-				addr += BIT(bet->exp);
-				size -= BIT(bet->exp);
-			} else {
-				LOG_DBG("Can't erase %zu at 0x%lx",
-					size, (long)addr);
-				ret = -EINVAL;
-			}
+		ret = spi_nor_erase_start(dev, addr, size, &erased);
+		if (ret == 0) {
+			addr += erased;
+			size -= erased;
 		}
 
 #ifdef __XCC__
@@ -839,6 +899,200 @@ static int spi_nor_erase(const struct device *dev, off_t addr, size_t size)
 	return ret;
 }
 
+#ifdef CONFIG_FLASH_RTIO
+/*
+ * RTIO requests are executed from the system work queue, one command at a
+ * time. While a program or erase command is in progress the status register
+ * is polled from delayed work, so no thread is blocked waiting on the
+ * device. The device lock is held for the duration of a transaction.
+ */
+
+static int spi_nor_rtio_load(const struct device *dev,
+			     struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct spi_nor_data *const data = dev->data;
+	const struct rtio_sqe *sqe = &iodev_sqe->sqe;
+	const size_t flash_size = dev_flash_size(dev);
+
+	data->rtio_sqe = iodev_sqe;
+	data->rtio_addr = sqe->flash_off;
+	data->rtio_buf = sqe->flash_buf;
+	data->rtio_len = sqe->flash_len;
+
+	switch (sqe->op) {
+	case RTIO_OP_NOP:
+		data->rtio_len = 0;
+		return 0;
+	case RTIO_OP_FLASH_READ:
+	case RTIO_OP_FLASH_WRITE:
+		break;
+	case RTIO_OP_FLASH_ERASE:
+		if (!SPI_NOR_IS_SECTOR_ALIGNED(sqe->flash_off) ||
+		    ((sqe->flash_len % SPI_NOR_SECTOR_SIZE) != 0)) {
+			return -EINVAL;
+		}
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	if ((sqe->flash_off < 0) ||
+	    ((sqe->flash_off + sqe->flash_len) > flash_size)) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/* Issue the next command of the request being executed */
+static int spi_nor_rtio_step(const struct device *dev)
+{
+	struct spi_nor_data *const data = dev->data;
+	size_t len = data->rtio_len;
+	int ret;
+
+	switch (data->rtio_sqe->sqe.op) {
+	case RTIO_OP_FLASH_READ:
+		ret = spi_nor_cmd_addr_read(dev, SPI_NOR_CMD_READ, data->rtio_addr,
+					    data->rtio_buf, len);
+		break;
+	case RTIO_OP_FLASH_WRITE:
+		len = spi_nor_program_size(dev, data->rtio_addr, len);
+		spi_nor_cmd_write(dev, SPI_NOR_CMD_WREN);
+		ret = spi_nor_cmd_addr_write(dev, SPI_NOR_CMD_PP, data->rtio_addr,
+					     data->rtio_buf, len);
+		data->rtio_wip = true;
+		break;
+	case RTIO_OP_FLASH_ERASE:
+		ret = spi_nor_erase_start(dev, data->rtio_addr, len, &len);
+		data->rtio_wip = true;
+		break;
+	default:
+		ret = -EINVAL;
+		break;
+	}
+
+	if (ret == 0) {
+		data->rtio_addr += len;
+		data->rtio_len -= len;
+		if (data->rtio_buf != NULL) {
+			data->rtio_buf += len;
+		}
+	}
+
+	return ret;
+}
+
+static void spi_nor_rtio_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct spi_nor_data *const data =
+		CONTAINER_OF(dwork, struct spi_nor_data, rtio_work);
+	const struct device *dev = data->dev;
+	struct rtio_iodev_sqe *done;
+	struct rtio_mpsc_node *node;
+	k_spinlock_key_t key;
+	int ret = 0;
+
+	if (!data->rtio_acquired) {
+		/* Retry later if a blocking call is using the device */
+		if (k_sem_take(&data->sem, K_NO_WAIT) != 0) {
+			k_work_reschedule(dwork, K_USEC(CONFIG_SPI_NOR_RTIO_POLL_INTERVAL));
+			return;
+		}
+		if (IS_ENABLED(CONFIG_SPI_NOR_IDLE_IN_DPD)) {
+			exit_dpd(dev);
+		}
+		data->rtio_acquired = true;
+		data->rtio_wip = false;
+
+		ret = spi_nor_rtio_load(dev, data->rtio_cur);
+		if (ret == 0) {
+			ret = spi_nor_write_protection_set(dev, false);
+		}
+	}
+
+	while (ret == 0) {
+		if (data->rtio_wip) {
+			ret = spi_nor_rdsr(dev);
+			if (ret < 0) {
+				break;
+			}
+			if ((ret & SPI_NOR_WIP_BIT) != 0U) {
+				k_work_reschedule(dwork,
+						  K_USEC(CONFIG_SPI_NOR_RTIO_POLL_INTERVAL));
+				return;
+			}
+			data->rtio_wip = false;
+			ret = 0;
+		}
+
+		if (data->rtio_len == 0) {
+			struct rtio_iodev_sqe *next = rtio_txn_next(data->rtio_sqe);
+
+			if (next == NULL) {
+				break;
+			}
+			ret = spi_nor_rtio_load(dev, next);
+			continue;
+		}
+
+		ret = spi_nor_rtio_step(dev);
+	}
+
+	/* Transaction done, leave the device in a known state */
+	if (data->rtio_wip) {
+		spi_nor_wait_until_ready(dev);
+		data->rtio_wip = false;
+	}
+
+	int ret2 = spi_nor_write_protection_set(dev, true);
+
+	if (ret == 0) {
+		ret = ret2;
+	}
+
+	data->rtio_acquired = false;
+	release_device(dev);
+
+	key = k_spin_lock(&data->rtio_lock);
+	done = data->rtio_cur;
+	node = rtio_mpsc_pop(&data->rtio_q);
+	data->rtio_cur = (node != NULL) ?
+		CONTAINER_OF(node, struct rtio_iodev_sqe, q) : NULL;
+	k_spin_unlock(&data->rtio_lock, key);
+
+	if (data->rtio_cur != NULL) {
+		k_work_reschedule(dwork, K_NO_WAIT);
+	}
+
+	if (ret < 0) {
+		rtio_iodev_sqe_err(done, ret);
+	} else {
+		rtio_iodev_sqe_ok(done, 0);
+	}
+}
+
+static void spi_nor_iodev_submit(const struct device *dev,
+				 struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct spi_nor_data *const data = dev->data;
+	k_spinlock_key_t key = k_spin_lock(&data->rtio_lock);
+	bool idle = (data->rtio_cur == NULL);
+
+	if (idle) {
+		data->rtio_cur = iodev_sqe;
+	} else {
+		rtio_mpsc_push(&data->rtio_q, &iodev_sqe->q);
+	}
+	k_spin_unlock(&data->rtio_lock, key);
+
+	if (idle) {
+		k_work_reschedule(&data->rtio_work, K_NO_WAIT);
+	}
+}
+#endif /* CONFIG_FLASH_RTIO */
+
 /* @note The device must be externally acquired before invoking this
  * function.
  */
@@ -1356,6 +1610,14 @@ static int spi_nor_init(const struct device *dev)
 		k_sem_init(&driver_data->sem, 1, K_SEM_MAX_LIMIT);
 	}
 
+#ifdef CONFIG_FLASH_RTIO
+	struct spi_nor_data *const driver_data = dev->data;
+
+	driver_data->dev = dev;
+	rtio_mpsc_init(&driver_data->rtio_q);
+	k_work_init_delayable(&driver_data->rtio_work, spi_nor_rtio_handler);
+#endif /* CONFIG_FLASH_RTIO */
+
 #if ANY_INST_HAS_WP_GPIOS
 	if (DEV_CFG(dev)->wp) {
 		if (!device_is_ready(DEV_CFG(dev)->wp->port)) {
@@ -1426,6 +1688,9 @@ static const struct flash_driver_api spi_nor_api = {
 	.sfdp_read = spi_nor_sfdp_read,
 	.read_jedec_id = spi_nor_read_jedec_id,
 #endif
+#if defined(CONFIG_FLASH_RTIO)
+	.iodev_submit = spi_nor_iodev_submit,
+#endif
 };
 
 #ifndef CONFIG_SPI_NOR_SFDP_RUNTIME
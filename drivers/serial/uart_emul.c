@@ -45,6 +45,25 @@ struct uart_emul_data {
 	uart_irq_callback_user_data_t irq_cb;
 	void *irq_cb_udata;
 #endif /* CONFIG_UART_INTERRUPT_DRIVEN */
+
+#ifdef CONFIG_UART_ASYNC_API
+	uart_callback_t async_cb;
+	void *async_cb_udata;
+
+	struct uart_emul_work tx_work;
+	const uint8_t *tx_buf;
+	size_t tx_len;
+
+	struct uart_emul_work rx_work;
+	bool rx_async_en;
+	bool rx_buf_requested;
+	bool rx_stopping;
+	uint8_t *rx_buf;
+	size_t rx_buf_len;
+	size_t rx_buf_offset;
+	uint8_t *rx_buf_next;
+	size_t rx_buf_next_len;
+#endif /* CONFIG_UART_ASYNC_API */
 };
 
 static int uart_emul_poll_in(const struct device *dev, unsigned char *p_char)
@@ -230,6 +249,281 @@ static int uart_emul_irq_update(const struct device *dev)
 }
 #endif /* CONFIG_UART_INTERRUPT_DRIVEN */
 
+#ifdef CONFIG_UART_ASYNC_API
+static void uart_emul_async_event(const struct device *dev, struct uart_event *evt)
+{
+	struct uart_emul_data *data = dev->data;
+
+	if (data->async_cb != NULL) {
+		data->async_cb(dev, evt, data->async_cb_udata);
+	}
+}
+
+static int uart_emul_callback_set(const struct device *dev, uart_callback_t cb, void *user_data)
+{
+	struct uart_emul_data *data = dev->data;
+
+	data->async_cb = cb;
+	data->async_cb_udata = user_data;
+
+	return 0;
+}
+
+static void uart_emul_async_tx_handler(struct k_work *work)
+{
+	struct uart_emul_work *uwork = CONTAINER_OF(work, struct uart_emul_work, work);
+	const struct device *dev = uwork->dev;
+	const struct uart_emul_config *cfg = dev->config;
+	struct uart_emul_data *data = dev->data;
+	struct uart_event evt = {
+		.type = UART_TX_DONE,
+		.data.tx.buf = data->tx_buf,
+	};
+	size_t sent = 0;
+
+	/* The receiving end may drain the TX FIFO from the data ready callback */
+	while (sent < data->tx_len) {
+		uint32_t written;
+
+		K_SPINLOCK(&data->tx_lock) {
+			written = ring_buf_put(data->tx_rb, &data->tx_buf[sent],
+					       data->tx_len - sent);
+		}
+
+		if (written == 0) {
+			LOG_DBG("Tx buffer is full");
+			evt.type = UART_TX_ABORTED;
+			break;
+		}
+
+		if (cfg->loopback) {
+			uart_emul_put_rx_data(dev, (uint8_t *)&data->tx_buf[sent], written);
+		}
+		sent += written;
+
+		if (data->tx_data_ready_cb) {
+			data->tx_data_ready_cb(dev, ring_buf_size_get(data->tx_rb),
+					       data->user_data);
+		}
+	}
+
+	evt.data.tx.len = sent;
+	data->tx_buf = NULL;
+
+	uart_emul_async_event(dev, &evt);
+}
+
+static int uart_emul_tx(const struct device *dev, const uint8_t *buf, size_t len,
+			int32_t timeout)
+{
+	struct uart_emul_data *data = dev->data;
+	int ret = 0;
+
+	ARG_UNUSED(timeout);
+
+	K_SPINLOCK(&data->tx_lock) {
+		if (data->tx_buf != NULL) {
+			ret = -EBUSY;
+			K_SPINLOCK_BREAK;
+		}
+
+		data->tx_buf = buf;
+		data->tx_len = len;
+	}
+
+	if (ret == 0) {
+		(void)k_work_submit(&data->tx_work.work);
+	}
+
+	return ret;
+}
+
+static int uart_emul_tx_abort(const struct device *dev)
+{
+	struct uart_emul_data *data = dev->data;
+	struct uart_event evt = {
+		.type = UART_TX_ABORTED,
+	};
+
+	if (data->tx_buf == NULL) {
+		return -EFAULT;
+	}
+
+	/* Transfers already being copied to the FIFO run to completion */
+	if (k_work_cancel(&data->tx_work.work) != 0) {
+		return 0;
+	}
+
+	evt.data.tx.buf = data->tx_buf;
+	evt.data.tx.len = 0;
+	data->tx_buf = NULL;
+
+	uart_emul_async_event(dev, &evt);
+
+	return 0;
+}
+
+static void uart_emul_async_rx_handler(struct k_work *work)
+{
+	struct uart_emul_work *uwork = CONTAINER_OF(work, struct uart_emul_work, work);
+	const struct device *dev = uwork->dev;
+	struct uart_emul_data *data = dev->data;
+	struct uart_event evt;
+	k_spinlock_key_t key;
+	uint32_t len;
+
+	key = k_spin_lock(&data->rx_lock);
+
+	while (data->rx_async_en) {
+		if (!data->rx_buf_requested) {
+			data->rx_buf_requested = true;
+			k_spin_unlock(&data->rx_lock, key);
+
+			evt = (struct uart_event){ .type = UART_RX_BUF_REQUEST };
+			uart_emul_async_event(dev, &evt);
+
+			key = k_spin_lock(&data->rx_lock);
+			continue;
+		}
+
+		if (data->rx_stopping) {
+			len = 0;
+		} else {
+			len = ring_buf_get(data->rx_rb, &data->rx_buf[data->rx_buf_offset],
+					   data->rx_buf_len - data->rx_buf_offset);
+		}
+
+		if (len > 0) {
+			evt = (struct uart_event){
+				.type = UART_RX_RDY,
+				.data.rx.buf = data->rx_buf,
+				.data.rx.offset = data->rx_buf_offset,
+				.data.rx.len = len,
+			};
+			data->rx_buf_offset += len;
+			k_spin_unlock(&data->rx_lock, key);
+
+			uart_emul_async_event(dev, &evt);
+
+			key = k_spin_lock(&data->rx_lock);
+			continue;
+		}
+
+		if (data->rx_buf_offset < data->rx_buf_len && !data->rx_stopping) {
+			/* Wait for more data */
+			break;
+		}
+
+		/* The current buffer is full, or reception is being stopped */
+		evt = (struct uart_event){
+			.type = UART_RX_BUF_RELEASED,
+			.data.rx_buf.buf = data->rx_buf,
+		};
+		data->rx_buf = data->rx_buf_next;
+		data->rx_buf_len = data->rx_buf_next_len;
+		data->rx_buf_offset = 0;
+		data->rx_buf_next = NULL;
+		data->rx_buf_requested = false;
+
+		if (data->rx_buf == NULL) {
+			data->rx_async_en = false;
+		}
+		k_spin_unlock(&data->rx_lock, key);
+
+		uart_emul_async_event(dev, &evt);
+
+		key = k_spin_lock(&data->rx_lock);
+		if (!data->rx_async_en) {
+			data->rx_stopping = false;
+			k_spin_unlock(&data->rx_lock, key);
+
+			evt = (struct uart_event){ .type = UART_RX_DISABLED };
+			uart_emul_async_event(dev, &evt);
+			return;
+		}
+
+		/* No buffer request for the remaining buffer when stopping */
+		data->rx_buf_requested = data->rx_stopping;
+	}
+
+	k_spin_unlock(&data->rx_lock, key);
+}
+
+static int uart_emul_rx_enable(const struct device *dev, uint8_t *buf, size_t len,
+			       int32_t timeout)
+{
+	struct uart_emul_data *data = dev->data;
+	int ret = 0;
+
+	ARG_UNUSED(timeout);
+
+	K_SPINLOCK(&data->rx_lock) {
+		if (data->rx_async_en) {
+			ret = -EBUSY;
+			K_SPINLOCK_BREAK;
+		}
+
+		data->rx_async_en = true;
+		data->rx_buf_requested = false;
+		data->rx_stopping = false;
+		data->rx_buf = buf;
+		data->rx_buf_len = len;
+		data->rx_buf_offset = 0;
+		data->rx_buf_next = NULL;
+	}
+
+	if (ret == 0) {
+		(void)k_work_submit(&data->rx_work.work);
+	}
+
+	return ret;
+}
+
+static int uart_emul_rx_buf_rsp(const struct device *dev, uint8_t *buf, size_t len)
+{
+	struct uart_emul_data *data = dev->data;
+	int ret = 0;
+
+	K_SPINLOCK(&data->rx_lock) {
+		if (!data->rx_async_en || data->rx_stopping) {
+			ret = -EACCES;
+			K_SPINLOCK_BREAK;
+		}
+
+		if (data->rx_buf_next != NULL) {
+			ret = -EBUSY;
+			K_SPINLOCK_BREAK;
+		}
+
+		data->rx_buf_next = buf;
+		data->rx_buf_next_len = len;
+	}
+
+	return ret;
+}
+
+static int uart_emul_rx_disable(const struct device *dev)
+{
+	struct uart_emul_data *data = dev->data;
+	int ret = 0;
+
+	K_SPINLOCK(&data->rx_lock) {
+		if (!data->rx_async_en) {
+			ret = -EFAULT;
+			K_SPINLOCK_BREAK;
+		}
+
+		data->rx_stopping = true;
+	}
+
+	if (ret == 0) {
+		(void)k_work_submit(&data->rx_work.work);
+	}
+
+	return ret;
+}
+#endif /* CONFIG_UART_ASYNC_API */
+
 static const struct uart_driver_api uart_emul_api = {
 	.poll_in = uart_emul_poll_in,
 	.poll_out = uart_emul_poll_out,
@@ -247,6 +541,14 @@ static const struct uart_driver_api uart_emul_api = {
 	.irq_update = uart_emul_irq_update,
 	.irq_is_pending = uart_emul_irq_is_pending,
 #endif /* CONFIG_UART_INTERRUPT_DRIVEN */
+#ifdef CONFIG_UART_ASYNC_API
+	.callback_set = uart_emul_callback_set,
+	.tx = uart_emul_tx,
+	.tx_abort = uart_emul_tx_abort,
+	.rx_enable = uart_emul_rx_enable,
+	.rx_buf_rsp = uart_emul_rx_buf_rsp,
+	.rx_disable = uart_emul_rx_disable,
+#endif /* CONFIG_UART_ASYNC_API */
 };
 
 void uart_emul_callback_tx_data_ready_set(const struct device *dev,
@@ -264,11 +566,13 @@ uint32_t uart_emul_put_rx_data(const struct device *dev, uint8_t *data, size_t s
 	uint32_t count;
 	__unused bool empty;
 	__unused bool irq_en;
+	__unused bool async_en;
 
 	K_SPINLOCK(&drv_data->rx_lock) {
 		count = ring_buf_put(drv_data->rx_rb, data, size);
 		empty = ring_buf_is_empty(drv_data->rx_rb);
 		IF_ENABLED(CONFIG_UART_INTERRUPT_DRIVEN, (irq_en = drv_data->rx_irq_en;));
+		IF_ENABLED(CONFIG_UART_ASYNC_API, (async_en = drv_data->rx_async_en;));
 	}
 
 	IF_ENABLED(CONFIG_UART_INTERRUPT_DRIVEN, (
@@ -277,6 +581,12 @@ uint32_t uart_emul_put_rx_data(const struct device *dev, uint8_t *data, size_t s
 		}
 	))
 
+	IF_ENABLED(CONFIG_UART_ASYNC_API, (
+		if (count > 0 && async_en && !empty) {
+			(void)k_work_submit(&drv_data->rx_work.work);
+		}
+	))
+
 	return count;
 }
 
@@ -326,6 +636,13 @@ uint32_t uart_emul_flush_tx_data(const struct device *dev)
 		   (.irq_work = {.dev = DEVICE_DT_INST_GET(inst),                                  \
 				 .work = Z_WORK_INITIALIZER(uart_emul_irq_handler)},))
 
+#define UART_EMUL_ASYNC_WORK_INIT(inst)                                                            \
+	IF_ENABLED(CONFIG_UART_ASYNC_API,                                                          \
+		   (.tx_work = {.dev = DEVICE_DT_INST_GET(inst),                                   \
+				.work = Z_WORK_INITIALIZER(uart_emul_async_tx_handler)},           \
+		    .rx_work = {.dev = DEVICE_DT_INST_GET(inst),                                   \
+				.work = Z_WORK_INITIALIZER(uart_emul_async_rx_handler)},))
+
 #define DEFINE_UART_EMUL(inst)                                                                     \
                                                                                                    \
 	RING_BUF_DECLARE(uart_emul_##inst##_rx_rb, UART_EMUL_RX_FIFO_SIZE(inst));                  \
@@ -338,6 +655,7 @@ uint32_t uart_emul_flush_tx_data(const struct device *dev)
 		.rx_rb = &uart_emul_##inst##_rx_rb,                                                \
 		.tx_rb = &uart_emul_##inst##_tx_rb,                                                \
 		UART_EMUL_IRQ_WORK_INIT(inst)                                                      \
+		UART_EMUL_ASYNC_WORK_INIT(inst)                                                    \
 	};                                                                                         \
                                                                                                    \
 	DEVICE_DT_INST_DEFINE(inst, NULL, NULL, &uart_emul_data_##inst, &uart_emul_cfg_##inst,     \
@@ -30,7 +30,7 @@ extern "C" {
 #endif
 
 struct flash_img_context {
-	uint8_t buf[CONFIG_IMG_BLOCK_BUF_SIZE];
+	uint8_t buf[CONFIG_IMG_BLOCK_BUF_SIZE * CONFIG_IMG_BLOCK_BUF_COUNT];
 	const struct flash_area *flash_area;
 	struct stream_flash_ctx stream;
 };
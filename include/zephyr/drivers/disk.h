@@ -75,6 +75,10 @@ struct disk_info {
 	const struct disk_operations *ops;
 	/** Device associated to this disk */
 	const struct device *dev;
+#if defined(CONFIG_DISK_CACHE) || defined(__DOXYGEN__)
+	/** Internally used sector size of the cached disk, 0 if not cached */
+	uint32_t cache_sector_size;
+#endif
 };
 
 /**
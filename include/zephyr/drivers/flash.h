@@ -26,6 +26,9 @@
 #include <stddef.h>
 #include <sys/types.h>
 #include <zephyr/device.h>
+#if defined(CONFIG_FLASH_RTIO)
+#include <zephyr/rtio/rtio.h>
+#endif /* CONFIG_FLASH_RTIO */
 
 #ifdef __cplusplus
 extern "C" {
@@ -128,6 +131,19 @@ typedef int (*flash_api_read_jedec_id)(const struct device *dev, uint8_t *id);
 typedef int (*flash_api_ex_op)(const struct device *dev, uint16_t code,
 			       const uintptr_t in, void *out);
 
+#if defined(CONFIG_FLASH_RTIO) || defined(__DOXYGEN__)
+/**
+ * @brief Submit a flash operation to the driver
+ *
+ * The driver must complete the request, and any transaction linked to it,
+ * with rtio_iodev_sqe_ok() or rtio_iodev_sqe_err(). Drivers not providing
+ * this callback are served by a generic adapter calling the blocking API
+ * from a dedicated thread.
+ */
+typedef void (*flash_api_iodev_submit)(const struct device *dev,
+				       struct rtio_iodev_sqe *iodev_sqe);
+#endif /* CONFIG_FLASH_RTIO */
+
 __subsystem struct flash_driver_api {
 	flash_api_read read;
 	flash_api_write write;
@@ -143,6 +159,9 @@ __subsystem struct flash_driver_api {
 #if defined(CONFIG_FLASH_EX_OP_ENABLED)
 	flash_api_ex_op ex_op;
 #endif /* CONFIG_FLASH_EX_OP_ENABLED */
+#if defined(CONFIG_FLASH_RTIO)
+	flash_api_iodev_submit iodev_submit;
+#endif /* CONFIG_FLASH_RTIO */
 };
 
 /**
@@ -493,6 +512,41 @@ static inline int z_impl_flash_ex_op(const struct device *dev, uint16_t code,
 #endif /* CONFIG_FLASH_EX_OP_ENABLED */
 }
 
+#if defined(CONFIG_FLASH_RTIO) || defined(__DOXYGEN__)
+
+/**
+ * @brief RTIO iodev API for flash devices
+ *
+ * Requests are prepared with rtio_sqe_prep_flash_read(),
+ * rtio_sqe_prep_flash_write() and rtio_sqe_prep_flash_erase(). Requests
+ * submitted to the same device are executed in submission order.
+ */
+extern const struct rtio_iodev_api flash_iodev_api;
+
+/**
+ * @brief Define an iodev for a given flash device node
+ *
+ * @param name Symbolic name to use for defining the iodev
+ * @param node_id Devicetree node identifier of the flash device
+ */
+#define FLASH_DT_IODEV_DEFINE(name, node_id)					\
+	RTIO_IODEV_DEFINE(name, &flash_iodev_api, (void *)DEVICE_DT_GET(node_id))
+
+/**
+ * @brief Validate that the flash device of an iodev is ready.
+ *
+ * @param flash_iodev Flash iodev defined with FLASH_DT_IODEV_DEFINE
+ *
+ * @retval true if the flash device is ready for use.
+ * @retval false if the flash device is not ready for use.
+ */
+static inline bool flash_is_ready_iodev(const struct rtio_iodev *flash_iodev)
+{
+	return device_is_ready(flash_iodev->data);
+}
+
+#endif /* CONFIG_FLASH_RTIO */
+
 #ifdef __cplusplus
 }
 #endif
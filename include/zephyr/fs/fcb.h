@@ -139,6 +139,32 @@ struct fcb {
 	const uint8_t f_flags;
 	/**< Flags for configuring the FCB. */
 #endif
+#ifdef CONFIG_FCB_READ_AHEAD
+	struct flash_sector *f_rd_sector;
+	/**< Sector the read-ahead buffer has been filled from, internal state */
+
+	uint32_t f_rd_off;
+	/**< Offset within f_rd_sector of the read-ahead buffer, internal state */
+
+	uint16_t f_rd_len;
+	/**< Number of valid bytes in the read-ahead buffer, internal state */
+
+	uint8_t f_rd_buf[CONFIG_FCB_READ_AHEAD_SIZE];
+	/**< Read-ahead buffer, internal state */
+#endif
+#ifdef CONFIG_FCB_BACKGROUND_ERASE
+	struct k_work f_erase_work;
+	/**< Work item erasing rotated out sector, internal state */
+
+	struct flash_sector *f_erase_sector;
+	/**< Sector with erase pending or not yet collected, internal state */
+
+	int f_erase_rc;
+	/**< Result of the last background erase, internal state */
+
+	bool f_erase_init;
+	/**< Set once f_erase_work has been initialized, internal state */
+#endif
 };
 
 /**
@@ -248,6 +274,9 @@ int fcb_getnext(struct fcb *fcb, struct fcb_entry *loc);
  * Function erases the data from oldest sector. Upon that the next sector
  * becomes the oldest. Active sector is also switched if needed.
  *
+ * With CONFIG_FCB_BACKGROUND_ERASE the erase is only scheduled; its failure
+ * is reported by the next operation that needs the sector erased.
+ *
  * @param[in] fcb FCB instance structure.
  */
 int fcb_rotate(struct fcb *fcb);
@@ -68,8 +68,10 @@ BUILD_ASSERT(sizeof(intptr_t) == sizeof(long));
 
 struct k_thread;
 struct k_mutex;
+struct k_rwlock;
 struct k_sem;
 struct k_msgq;
+struct k_ringq;
 struct k_mbox;
 struct k_pipe;
 struct k_queue;
@@ -2875,6 +2877,7 @@ __syscall int k_stack_pop(struct k_stack *stack, stack_data_t *data,
 
 struct k_work;
 struct k_work_q;
+struct k_work_q_worker;
 struct k_work_queue_config;
 extern struct k_work_q k_sys_work_q;
 
@@ -3089,6 +3092,159 @@ __syscall int k_condvar_wait(struct k_condvar *condvar, struct k_mutex *mutex,
  * @cond INTERNAL_HIDDEN
  */
 
+/* Lock state: zero when free, the owner thread when write locked, or
+ * Z_RWLOCK_READ_LOCKED and the reader count in units of Z_RWLOCK_READER when
+ * read locked. Z_RWLOCK_WAITERS is set while threads wait, which sends all
+ * the operations through the slow path.
+ */
+#define Z_RWLOCK_WAITERS	BIT(0)
+#define Z_RWLOCK_READ_LOCKED	BIT(1)
+#define Z_RWLOCK_READER		BIT(2)
+
+struct k_rwlock {
+	atomic_t state;
+	_wait_q_t read_q;
+	_wait_q_t write_q;
+	struct k_spinlock lock;
+	uint32_t flags;
+
+	/* Writer whose priority is raised by the waiters, and its priority
+	 * before that
+	 */
+	struct k_thread *boosted;
+	int boosted_orig_prio;
+};
+
+#define Z_RWLOCK_INITIALIZER(obj, rwlock_flags)				\
+	{								\
+		.state = ATOMIC_INIT(0),				\
+		.read_q = Z_WAIT_Q_INIT(&obj.read_q),			\
+		.write_q = Z_WAIT_Q_INIT(&obj.write_q),			\
+		.flags = rwlock_flags,					\
+	}
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @defgroup rwlock_apis Reader-Writer Lock APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Fair reader-writer lock.
+ *
+ * By default, a writer releasing the lock hands it over to the next waiting
+ * writer, and readers only get it once no writer waits. With this flag, the
+ * lock alternates between all the waiting readers and the next writer, so
+ * that neither readers nor writers starve.
+ */
+#define K_RWLOCK_FAIR	BIT(0)
+
+/**
+ * @brief Statically define and initialize a reader-writer lock.
+ *
+ * The lock can be accessed outside the module where it is defined using:
+ *
+ * @code extern struct k_rwlock <name>; @endcode
+ *
+ * @param name Name of the reader-writer lock.
+ * @param flags K_RWLOCK_* flags, zero for writer preference.
+ */
+#define K_RWLOCK_DEFINE(name, flags)					\
+	STRUCT_SECTION_ITERABLE(k_rwlock, name) =			\
+		Z_RWLOCK_INITIALIZER(name, flags)
+
+/**
+ * @brief Initialize a reader-writer lock.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ * @param flags K_RWLOCK_* flags, zero for writer preference.
+ *
+ * @retval 0 Reader-writer lock initialized.
+ * @retval -EINVAL Invalid flags.
+ */
+__syscall int k_rwlock_init(struct k_rwlock *rwlock, uint32_t flags);
+
+/**
+ * @brief Lock a reader-writer lock for reading.
+ *
+ * Any number of threads may hold the lock for reading at the same time. The
+ * calling thread waits while a writer holds the lock, or waits for it.
+ * Taking the read lock of an idle or read locked lock is a single atomic
+ * operation, which does not serialize the readers on a kernel lock.
+ *
+ * Read locks are not recursive: a reader locking again waits behind the
+ * waiting writers, which wait for it.
+ *
+ * Reader-writer locks may not be locked in ISRs.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ * @param timeout Waiting period to lock the reader-writer lock,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Locked for reading.
+ * @retval -EBUSY Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EDEADLK The calling thread holds the write lock.
+ */
+__syscall int k_rwlock_read_lock(struct k_rwlock *rwlock, k_timeout_t timeout);
+
+/**
+ * @brief Unlock a reader-writer lock locked for reading.
+ *
+ * The last reader hands the lock over to the first waiting writer.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ *
+ * @retval 0 Read lock released.
+ * @retval -EPERM The lock is not locked for reading.
+ */
+__syscall int k_rwlock_read_unlock(struct k_rwlock *rwlock);
+
+/**
+ * @brief Lock a reader-writer lock for writing.
+ *
+ * The calling thread waits until no thread holds the lock. While it holds
+ * the lock for writing, its priority is raised to the one of the highest
+ * priority waiting thread, as for a mutex.
+ *
+ * Write locks are not recursive, and may not be locked in ISRs.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ * @param timeout Waiting period to lock the reader-writer lock,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Locked for writing.
+ * @retval -EBUSY Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EDEADLK The calling thread already holds the write lock.
+ */
+__syscall int k_rwlock_write_lock(struct k_rwlock *rwlock, k_timeout_t timeout);
+
+/**
+ * @brief Unlock a reader-writer lock locked for writing.
+ *
+ * The lock is handed over to the waiting threads, as selected by the
+ * K_RWLOCK_FAIR flag.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ *
+ * @retval 0 Write lock released.
+ * @retval -EPERM The calling thread does not hold the write lock.
+ */
+__syscall int k_rwlock_write_unlock(struct k_rwlock *rwlock);
+
+/**
+ * @}
+ */
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
 struct k_sem {
 	_wait_q_t wait_q;
 	unsigned int count;
@@ -3336,6 +3492,43 @@ int k_work_submit_to_queue(struct k_work_q *queue,
  */
 extern int k_work_submit(struct k_work *work);
 
+/** @brief Submit several work items to a queue.
+ *
+ * This is equivalent to calling k_work_submit_to_queue() for each item,
+ * except that the work queue is notified and the caller rescheduled once
+ * for the whole batch rather than once per item.  This reduces the cost
+ * of submitting bursts of work, e.g. from an interrupt handler.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param queue pointer to the work queue on which the items should run.
+ * If NULL the queue from the most recent submission of each item will be
+ * used.
+ *
+ * @param works array of pointers to the work items.
+ *
+ * @param count number of work items in @p works.
+ *
+ * @return the number of items which were not yet queued and have been
+ * queued by this call, i.e. for which k_work_submit_to_queue() would have
+ * returned a positive value.  Items which could not be submitted are
+ * skipped.
+ */
+int k_work_submit_batch_to_queue(struct k_work_q *queue,
+				 struct k_work **works, size_t count);
+
+/** @brief Submit several work items to the system queue.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param works array of pointers to the work items.
+ *
+ * @param count number of work items in @p works.
+ *
+ * @return as with k_work_submit_batch_to_queue().
+ */
+int k_work_submit_batch(struct k_work **works, size_t count);
+
 /** @brief Wait for last-submitted instance to complete.
  *
  * Resubmissions may occur while waiting, including chained submissions (from
@@ -3450,6 +3643,44 @@ void k_work_queue_start(struct k_work_q *queue,
 			k_thread_stack_t *stack, size_t stack_size,
 			int prio, const struct k_work_queue_config *cfg);
 
+/** @brief Add a worker thread to a work queue.
+ *
+ * The work items of a queue with workers are processed concurrently by
+ * the queue thread and all its workers, each taking the items submitted
+ * to itself first and stealing items submitted to the others when it
+ * has nothing left.  Items submitted from a thread of the queue go to
+ * that thread, other submissions are spread over all threads.  A work
+ * item is never run by two threads at once, and the flush, cancel and
+ * drain operations keep their semantics.  Work items are however no
+ * longer run one at a time nor in submission order, so a queue should
+ * only be given workers when its items are independent.
+ *
+ * Workers should be added right after the queue is started, before
+ * any work is submitted to it.  The worker runs at the priority of the
+ * queue thread.
+ *
+ * @kconfig_dep{CONFIG_WORKQUEUE_POOL}
+ *
+ * @param queue pointer to the started queue.
+ *
+ * @param worker pointer to the worker structure, in zeroed/bss memory.
+ *
+ * @param stack pointer to the worker thread stack area.
+ *
+ * @param stack_size size of the the worker thread stack area, in bytes.
+ *
+ * @param cpu CPU the worker thread is pinned to, or -1 to let it run on
+ *        any CPU.  Pinning requires @kconfig{CONFIG_SCHED_CPU_MASK}.
+ *
+ * @retval 0 if the worker was added.
+ * @retval -ENODEV if the queue is not started.
+ * @retval -ENOTSUP if @p cpu is not -1 and CPU masks are not supported.
+ */
+int k_work_queue_add_worker(struct k_work_q *queue,
+			    struct k_work_q_worker *worker,
+			    k_thread_stack_t *stack, size_t stack_size,
+			    int cpu);
+
 /** @brief Access the thread that animates a work queue.
  *
  * This is necessary to grant a work queue thread access to things the work
@@ -3926,6 +4157,14 @@ struct k_work_delayable {
 struct z_work_flusher {
 	struct k_work work;
 	struct k_sem sem;
+#ifdef CONFIG_WORKQUEUE_POOL
+	/* On queues with workers the flusher is not queued but waits in
+	 * a global list for the given number of runs of the work item to
+	 * complete.
+	 */
+	struct k_work *target;
+	uint32_t runs;
+#endif
 };
 
 /* Record used to wait for work to complete a cancellation.
@@ -3990,6 +4229,19 @@ struct k_work_queue_config {
 	 * control.
 	 */
 	bool no_yield;
+
+#ifdef CONFIG_WORKQUEUE_NOTIFY_DELAY
+	/** Delay the wakeup of an idle work queue after a submission.
+	 *
+	 * With the default of @c K_NO_WAIT every submission to an idle
+	 * queue wakes the work queue thread immediately.  Otherwise the
+	 * first submission to an idle queue arms a timeout which wakes the
+	 * thread, so that the items submitted until then are processed
+	 * after a single wakeup.  Flushing or draining the queue still
+	 * wakes the thread immediately.
+	 */
+	k_timeout_t notify_delay;
+#endif
 };
 
 /** @brief A structure used to hold work until it can be processed. */
@@ -4012,6 +4264,49 @@ struct k_work_q {
 
 	/* Flags describing queue state. */
 	uint32_t flags;
+
+#ifdef CONFIG_WORKQUEUE_POOL
+	/* Additional threads processing the work of the queue. */
+	sys_slist_t workers;
+
+	/* Worker getting the next item submitted from outside the
+	 * queue, or NULL for the queue thread.
+	 */
+	struct k_work_q_worker *next_worker;
+
+	/* Number of queue threads running a work item. */
+	uint8_t num_busy;
+#endif
+
+#ifdef CONFIG_WORKQUEUE_NOTIFY_DELAY
+	/* Timeout waking the queue after a delayed notification. */
+	struct _timeout notify_timeout;
+
+	/* Delay of the notification of the queue after a submission. */
+	k_timeout_t notify_delay;
+#endif
+};
+
+/** @brief A structure holding an additional work queue thread.
+ *
+ * See k_work_queue_add_worker().
+ */
+struct k_work_q_worker {
+	/* The thread that animates the worker. */
+	struct k_thread thread;
+
+	/* All the following fields must be accessed only while the
+	 * work module spinlock is held.
+	 */
+
+	/* The queue the worker belongs to. */
+	struct k_work_q *queue;
+
+	/* Node in the list of workers of the queue. */
+	sys_snode_t node;
+
+	/* List of k_work items submitted to the worker. */
+	sys_slist_t pending;
 };
 
 /* Provide the implementation for inline functions declared above */
@@ -4669,6 +4964,180 @@ static inline uint32_t z_impl_k_msgq_num_used_get(struct k_msgq *msgq)
 
 /** @} */
 
+/**
+ * @defgroup ringq_apis Ring Queue APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Ring Queue Structure
+ *
+ * A ring queue passes fixed size messages like a message queue, but
+ * through a bounded lock-free ring: putting and getting messages only
+ * involve the scheduler if a thread is waiting on the other end.
+ */
+struct k_ringq {
+	/** Position of the next message to put */
+	atomic_t head;
+	/** Position of the next message to get */
+	atomic_t tail;
+	/** Number of threads and poll events waiting for messages */
+	atomic_t get_waiters;
+	/** Number of threads waiting for free space */
+	atomic_t put_waiters;
+	/** Message slots, each a sequence word followed by the message */
+	atomic_t *buffer;
+	/** Message size */
+	size_t msg_size;
+	/** Maximal number of messages minus one */
+	uint32_t mask;
+	/** Ring queue flags */
+	uint32_t flags;
+	/** Lock protecting the wait queues */
+	struct k_spinlock lock;
+	/** Threads waiting for messages */
+	_wait_q_t get_wait_q;
+	/** Threads waiting for free space */
+	_wait_q_t put_wait_q;
+
+	_POLL_EVENT;
+};
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+#define Z_RINGQ_SLOT_WORDS(msg_size) \
+	(1U + DIV_ROUND_UP(msg_size, sizeof(atomic_t)))
+
+#define Z_RINGQ_INITIALIZER(obj, q_buffer, q_msg_size, q_max_msgs, q_flags) \
+	{ \
+	.buffer = q_buffer, \
+	.msg_size = q_msg_size, \
+	.mask = (q_max_msgs) - 1U, \
+	.flags = q_flags, \
+	.get_wait_q = Z_WAIT_Q_INIT(&obj.get_wait_q), \
+	.put_wait_q = Z_WAIT_Q_INIT(&obj.put_wait_q), \
+	_POLL_EVENT_OBJ_INIT(obj) \
+	}
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/** Several threads or ISRs may put messages concurrently. */
+#define K_RINGQ_FLAG_MULTI_PRODUCER	BIT(0)
+
+/** Several threads may get messages concurrently. */
+#define K_RINGQ_FLAG_MULTI_CONSUMER	BIT(1)
+
+/** Several producers and several consumers. */
+#define K_RINGQ_FLAG_MPMC \
+	(K_RINGQ_FLAG_MULTI_PRODUCER | K_RINGQ_FLAG_MULTI_CONSUMER)
+
+/**
+ * @brief Size of the buffer of a ring queue.
+ *
+ * @param msg_size Message size (in bytes).
+ * @param max_msgs Maximum number of messages that can be queued.
+ */
+#define K_RINGQ_BUF_SIZE(msg_size, max_msgs) \
+	((max_msgs) * Z_RINGQ_SLOT_WORDS(msg_size) * sizeof(atomic_t))
+
+/**
+ * @brief Statically define and initialize a ring queue.
+ *
+ * The ring queue can be accessed outside the module where it is defined
+ * using:
+ *
+ * @code extern struct k_ringq <name>; @endcode
+ *
+ * @param q_name Name of the ring queue.
+ * @param q_msg_size Message size (in bytes).
+ * @param q_max_msgs Maximum number of messages that can be queued, which
+ * must be a power of two.
+ * @param q_flags K_RINGQ_FLAG_* flags, zero for a single producer and a
+ * single consumer.
+ */
+#define K_RINGQ_DEFINE(q_name, q_msg_size, q_max_msgs, q_flags)		\
+	BUILD_ASSERT(IS_POWER_OF_TWO(q_max_msgs),			\
+		     "ring queue size must be a power of two");		\
+	static atomic_t _k_ringq_buf_##q_name[(q_max_msgs) *		\
+					      Z_RINGQ_SLOT_WORDS(q_msg_size)]; \
+	struct k_ringq q_name =						\
+		Z_RINGQ_INITIALIZER(q_name, _k_ringq_buf_##q_name,	\
+				    q_msg_size, q_max_msgs, q_flags)
+
+/**
+ * @brief Initialize a ring queue.
+ *
+ * Unless @ref K_RINGQ_FLAG_MULTI_PRODUCER is set, messages must only be
+ * put by one thread or ISR at a time.  Unless
+ * @ref K_RINGQ_FLAG_MULTI_CONSUMER is set, messages must only be got by
+ * one thread at a time, which may block.  Ring queues are supervisor only
+ * objects.
+ *
+ * @param q Address of the ring queue.
+ * @param buffer Buffer of K_RINGQ_BUF_SIZE() bytes, aligned to atomic_t.
+ * @param msg_size Message size (in bytes).
+ * @param max_msgs Maximum number of messages that can be queued, which
+ * must be a power of two.
+ * @param flags K_RINGQ_FLAG_* flags.
+ */
+void k_ringq_init(struct k_ringq *q, void *buffer, size_t msg_size,
+		  uint32_t max_msgs, uint32_t flags);
+
+/**
+ * @brief Put a message into a ring queue.
+ *
+ * The message content is copied from @a data into the ring queue.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param q Address of the ring queue.
+ * @param data Pointer to the message.
+ * @param timeout Waiting period to add the message, or one of the special
+ *                values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Message sent.
+ * @retval -ENOMSG Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+int k_ringq_put(struct k_ringq *q, const void *data, k_timeout_t timeout);
+
+/**
+ * @brief Get a message from a ring queue.
+ *
+ * The message content is copied from the ring queue into @a data.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param q Address of the ring queue.
+ * @param data Address of area to hold the received message.
+ * @param timeout Waiting period to receive the message, or one of the
+ *                special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Message received.
+ * @retval -ENOMSG Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+int k_ringq_get(struct k_ringq *q, void *data, k_timeout_t timeout);
+
+/**
+ * @brief Get the number of messages in a ring queue.
+ *
+ * The result is a snapshot which may be out of date as soon as it is
+ * returned when other threads or ISRs use the ring queue.
+ *
+ * @param q Address of the ring queue.
+ *
+ * @return Number of messages.
+ */
+uint32_t k_ringq_num_used_get(struct k_ringq *q);
+
+/** @} */
+
 /**
  * @defgroup mailbox_apis Mailbox APIs
  * @ingroup kernel_apis
@@ -5532,6 +6001,9 @@ enum _poll_types_bits {
 	/* pipe data availability */
 	_POLL_TYPE_PIPE_DATA_AVAILABLE,
 
+	/* ring queue data availability */
+	_POLL_TYPE_RINGQ_DATA_AVAILABLE,
+
 	_POLL_NUM_TYPES
 };
 
@@ -5560,6 +6032,9 @@ enum _poll_states_bits {
 	/* data is available to read from a pipe */
 	_POLL_STATE_PIPE_DATA_AVAILABLE,
 
+	/* data is available to read from a ring queue */
+	_POLL_STATE_RINGQ_DATA_AVAILABLE,
+
 	_POLL_NUM_STATES
 };
 
@@ -5592,6 +6067,7 @@ enum _poll_states_bits {
 #define K_POLL_TYPE_FIFO_DATA_AVAILABLE K_POLL_TYPE_DATA_AVAILABLE
 #define K_POLL_TYPE_MSGQ_DATA_AVAILABLE Z_POLL_TYPE_BIT(_POLL_TYPE_MSGQ_DATA_AVAILABLE)
 #define K_POLL_TYPE_PIPE_DATA_AVAILABLE Z_POLL_TYPE_BIT(_POLL_TYPE_PIPE_DATA_AVAILABLE)
+#define K_POLL_TYPE_RINGQ_DATA_AVAILABLE Z_POLL_TYPE_BIT(_POLL_TYPE_RINGQ_DATA_AVAILABLE)
 
 /* public - polling modes */
 enum k_poll_modes {
@@ -5609,6 +6085,7 @@ enum k_poll_modes {
 #define K_POLL_STATE_FIFO_DATA_AVAILABLE K_POLL_STATE_DATA_AVAILABLE
 #define K_POLL_STATE_MSGQ_DATA_AVAILABLE Z_POLL_STATE_BIT(_POLL_STATE_MSGQ_DATA_AVAILABLE)
 #define K_POLL_STATE_PIPE_DATA_AVAILABLE Z_POLL_STATE_BIT(_POLL_STATE_PIPE_DATA_AVAILABLE)
+#define K_POLL_STATE_RINGQ_DATA_AVAILABLE Z_POLL_STATE_BIT(_POLL_STATE_RINGQ_DATA_AVAILABLE)
 #define K_POLL_STATE_CANCELLED Z_POLL_STATE_BIT(_POLL_STATE_CANCELLED)
 
 /* public - poll signal object */
@@ -5668,8 +6145,16 @@ struct k_poll_event {
 		struct k_msgq *msgq;
 #ifdef CONFIG_PIPES
 		struct k_pipe *pipe;
+#endif
+#ifdef CONFIG_RINGQ
+		struct k_ringq *ringq;
 #endif
 	};
+
+#ifdef CONFIG_POLL_SET
+	/** PRIVATE - DO NOT TOUCH */
+	sys_dnode_t _ready_node;
+#endif
 };
 
 #define K_POLL_EVENT_INITIALIZER(_event_type, _event_mode, _event_obj) \
@@ -5817,6 +6302,88 @@ __syscall void k_poll_signal_check(struct k_poll_signal *sig,
 
 __syscall int k_poll_signal_raise(struct k_poll_signal *sig, int result);
 
+#if defined(CONFIG_POLL_SET) || defined(__DOXYGEN__)
+
+/**
+ * @brief Persistent set of poll events
+ *
+ * Events are registered with their kernel objects once, when added to the
+ * set, and stay registered across waits. The objects record the readiness
+ * of their events in the set, so that waiting costs in the number of ready
+ * events instead of the number of watched ones.
+ */
+struct k_poll_set {
+	/** PRIVATE - DO NOT TOUCH */
+	struct z_poller poller;
+
+	/** Events signaled by their objects, not returned yet */
+	sys_dlist_t ready;
+
+	/** Events returned by the last wait */
+	sys_dlist_t returned;
+
+	/** Threads waiting for events */
+	_wait_q_t wait_q;
+};
+
+/**
+ * @brief Initialize a poll set.
+ *
+ * @param set Address of the poll set.
+ */
+void k_poll_set_init(struct k_poll_set *set);
+
+/**
+ * @brief Add an event to a poll set.
+ *
+ * The event, initialized with k_poll_event_init() or
+ * K_POLL_EVENT_INITIALIZER(), is registered with its kernel object until
+ * removed from the set, and must not be passed to k_poll() or to another set
+ * meanwhile. Other threads should not poll the object with k_poll() either,
+ * as an object only notifies the first of its pollers.
+ *
+ * @param set Address of the poll set.
+ * @param event Address of the event.
+ *
+ * @retval 0 Event added.
+ * @retval -EBUSY The event is already registered.
+ */
+int k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event);
+
+/**
+ * @brief Remove an event from a poll set.
+ *
+ * @param set Address of the poll set.
+ * @param event Address of the event.
+ *
+ * @retval 0 Event removed.
+ * @retval -EINVAL The event is not in the set.
+ */
+int k_poll_set_remove(struct k_poll_set *set, struct k_poll_event *event);
+
+/**
+ * @brief Wait for events of a poll set.
+ *
+ * Returns the ready events of the set, in the order they became ready, with
+ * their state field set as by k_poll(). Like k_poll(), the objects are not
+ * acquired. Events are level triggered: an event returned by a wait is
+ * returned again by the next one if its condition still holds then, e.g. if
+ * the semaphore was not taken, or the poll signal was not reset.
+ *
+ * @param set Address of the poll set.
+ * @param events Array receiving the addresses of the ready events.
+ * @param max_events Size of the array.
+ * @param timeout Waiting period for an event to be ready,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of events stored in @p events, at least 1.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **events,
+		    int max_events, k_timeout_t timeout);
+
+#endif /* CONFIG_POLL_SET */
+
 /** @} */
 
 /**
@@ -6082,6 +6649,29 @@ extern void k_sys_runtime_stats_enable(void);
  */
 extern void k_sys_runtime_stats_disable(void);
 
+/**
+ * @brief Get the histogram of the durations of an interrupt handler
+ *
+ * This routine copies the histogram of the number of cycles spent in the
+ * handler of the given IRQ, made of CONFIG_SCHED_USAGE_HISTOGRAM_BUCKETS
+ * buckets. Bucket 0 counts durations of 0 cycles, bucket n counts durations
+ * from 2^(n-1) to 2^n - 1 cycles and the last bucket counts all longer
+ * durations. Only available with CONFIG_SCHED_ISR_USAGE_HISTOGRAM.
+ *
+ * @param irq IRQ number
+ * @param hist Array of CONFIG_SCHED_USAGE_HISTOGRAM_BUCKETS entries to copy
+ *             the histogram into.
+ * @return -EINVAL if the IRQ number is invalid or hist is NULL, otherwise 0
+ */
+int k_isr_usage_histogram_get(unsigned int irq, uint32_t *hist);
+
+/**
+ * @brief Reset the histograms of the durations of interrupt handlers
+ *
+ * Only available with CONFIG_SCHED_ISR_USAGE_HISTOGRAM.
+ */
+void k_isr_usage_histogram_reset(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -26,6 +26,18 @@ struct k_cycle_stats {
 	uint64_t  longest;      /**< \# of cycles in longest usage window */
 	uint32_t  num_windows;  /**< \# of usage windows */
 	/** @} */
+#endif
+#if defined(CONFIG_SCHED_THREAD_USAGE_HISTOGRAM) || defined(__DOXYGEN__)
+	/**
+	 * @name Fields available when CONFIG_SCHED_THREAD_USAGE_HISTOGRAM is selected.
+	 * @{
+	 */
+	uint32_t  ready;        /**< cycle count when made ready, 0 if not pending */
+	/** histogram of the length of usage windows */
+	uint32_t  run_hist[CONFIG_SCHED_USAGE_HISTOGRAM_BUCKETS];
+	/** histogram of the cycles from being made ready to running */
+	uint32_t  latency_hist[CONFIG_SCHED_USAGE_HISTOGRAM_BUCKETS];
+	/** @} */
 #endif
 	bool      track_usage;  /**< true if gathering usage stats */
 };
@@ -117,6 +117,11 @@ struct _thread_base {
 	/* Recursive count of irq_lock() calls */
 	uint8_t global_lock_count;
 
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	/* CPU whose run queue holds the thread when it is queued */
+	uint8_t home_cpu;
+#endif
+
 #endif
 
 #ifdef CONFIG_SCHED_CPU_MASK
@@ -218,6 +223,20 @@ typedef struct k_thread_runtime_stats {
 	uint64_t average_cycles;      /* average # of non-idle cycles */
 #endif
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_HISTOGRAM
+	/*
+	 * Histograms of the number of cycles the thread ran each time it was
+	 * scheduled, and of the number of cycles from being made ready to
+	 * running. For CPUs, they hold the values of all the threads with
+	 * usage statistics enabled which ran on them, idle threads excepted.
+	 * Bucket 0 counts 0 cycles, bucket n counts 2^(n-1) to 2^n - 1 cycles
+	 * and the last bucket counts all longer durations.
+	 */
+
+	uint32_t run_histogram[CONFIG_SCHED_USAGE_HISTOGRAM_BUCKETS];
+	uint32_t latency_histogram[CONFIG_SCHED_USAGE_HISTOGRAM_BUCKETS];
+#endif
+
 #ifdef CONFIG_SCHED_THREAD_USAGE_ALL
 	/*
 	 * This field is always zero for individual threads. It only comes
@@ -228,6 +247,15 @@ typedef struct k_thread_runtime_stats {
 	uint64_t idle_cycles;
 #endif
 
+#ifdef CONFIG_SCHED_IPI_STATS
+	/*
+	 * Always zero for individual threads. For CPUs, the number of
+	 * scheduler IPIs received.
+	 */
+
+	uint32_t ipi_count;
+#endif
+
 #if defined(__cplusplus) && !defined(CONFIG_SCHED_THREAD_USAGE) &&                                 \
 	!defined(CONFIG_SCHED_THREAD_USAGE_ANALYSIS) && !defined(CONFIG_SCHED_THREAD_USAGE_ALL)
 	/* If none of the above Kconfig values are defined, this struct will have a size 0 in C
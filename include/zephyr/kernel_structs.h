@@ -87,6 +87,11 @@ struct _ready_q {
 	struct k_thread *cache;
 #endif
 
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	/* head of runq, NULL when empty */
+	struct k_thread *best;
+#endif
+
 #if defined(CONFIG_SCHED_DUMB)
 	sys_dlist_t runq;
 #elif defined(CONFIG_SCHED_SCALABLE)
@@ -111,10 +116,6 @@ struct _cpu {
 	/* one assigned idle thread per CPU */
 	struct k_thread *idle_thread;
 
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
-	struct _ready_q ready_q;
-#endif
-
 #if (CONFIG_NUM_METAIRQ_PRIORITIES > 0) &&                                                         \
 	(CONFIG_NUM_COOP_PRIORITIES > CONFIG_NUM_METAIRQ_PRIORITIES)
 	/* Coop thread preempted by current metairq, or NULL */
@@ -146,12 +147,25 @@ struct _cpu {
 #endif
 #endif
 
+#ifdef CONFIG_SCHED_IPI_STATS
+	/* Number of scheduler IPIs received */
+	uint32_t ipi_count;
+#endif
+
 #ifdef CONFIG_OBJ_CORE_SYSTEM
 	struct k_obj_core  obj_core;
 #endif
 
 	/* Per CPU architecture specifics */
 	struct _cpu_arch arch;
+
+#if defined(CONFIG_SCHED_CPU_MASK) || defined(CONFIG_SCHED_CPU_RUNQ)
+	/*
+	 * ready queue: can be big, keep after all other fields, since some
+	 * assembly (e.g. ARC) are limited in the encoding of the offset
+	 */
+	struct _ready_q ready_q;
+#endif
 };
 
 typedef struct _cpu _cpu_t;
@@ -167,7 +181,7 @@ struct z_kernel {
 	 * ready queue: can be big, keep after small fields, since some
 	 * assembly (e.g. ARC) are limited in the encoding of the offset
 	 */
-#ifndef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if !defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) && !defined(CONFIG_SCHED_CPU_RUNQ)
 	struct _ready_q ready_q;
 #endif
 
@@ -197,8 +211,8 @@ struct z_kernel {
 #endif
 
 #if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED)
-	/* Need to signal an IPI at the next scheduling point */
-	bool pending_ipi;
+	/* Bitmap of CPUs to signal an IPI at the next scheduling point */
+	atomic_t pending_ipi;
 #endif
 };
 
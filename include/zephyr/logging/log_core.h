@@ -190,6 +190,76 @@ static inline char z_log_minimal_level_to_char(int level)
 
 #define Z_LOG_INST(_inst) COND_CODE_1(CONFIG_LOG, (_inst), NULL)
 
+/*****************************************************************************/
+/****************** Definitions used by rate limiting ************************/
+/*****************************************************************************/
+#ifdef CONFIG_LOG_RATELIMIT
+/* Rate limiting parameters can be overridden by the module by defining them
+ * before including the logging header.
+ */
+#ifndef LOG_RATELIMIT_BURST
+#define LOG_RATELIMIT_BURST CONFIG_LOG_RATELIMIT_BURST
+#endif
+
+#ifndef LOG_RATELIMIT_RATE
+#define LOG_RATELIMIT_RATE CONFIG_LOG_RATELIMIT_RATE
+#endif
+
+#ifndef LOG_RATELIMIT_LEVEL
+#define LOG_RATELIMIT_LEVEL CONFIG_LOG_RATELIMIT_LEVEL
+#endif
+#endif /* CONFIG_LOG_RATELIMIT */
+
+/** @internal
+ * @brief Token bucket of a log message call site.
+ *
+ * The bucket is kept as the time at which it would be full again, so that it
+ * is updated with a single compare-and-swap.
+ */
+struct log_ratelimit {
+	/* Time (in system ticks) at which the bucket is full again. */
+	atomic_t full_at;
+	/* Number of messages suppressed since the last one passed. */
+	atomic_t suppressed;
+};
+
+/** @internal
+ * @brief Take a token from the bucket of a log message call site.
+ *
+ * If messages were suppressed since the last message which passed, a message
+ * with the number of suppressed messages is created before returning.
+ *
+ * @param rl       Token bucket of the call site.
+ * @param source   Source of the message.
+ * @param level    Level of the message.
+ * @param burst    Capacity of the bucket.
+ * @param interval Number of system ticks after which a token is added to the
+ *                 bucket.
+ *
+ * @retval true if message shall be created.
+ * @retval false if message shall be suppressed.
+ */
+bool z_log_ratelimit_check(struct log_ratelimit *rl, const void *source,
+			   uint8_t level, uint32_t burst, uint32_t interval);
+
+/* Number of system ticks between two tokens, computed at build time. */
+#define Z_LOG_RATELIMIT_INTERVAL(_rate) \
+	MAX(1, CONFIG_SYS_CLOCK_TICKS_PER_SEC / (_rate))
+
+/* Breaks from the enclosing loop if message shall be suppressed. Messages
+ * from user mode are not limited as the state cannot be written from there.
+ */
+#define Z_LOG_RATELIMIT(_level, _src, _is_user_context) \
+	IF_ENABLED(CONFIG_LOG_RATELIMIT, ( \
+	if (((_level) >= LOG_RATELIMIT_LEVEL) && !(_is_user_context)) { \
+		static struct log_ratelimit _ratelimit; \
+		if (!z_log_ratelimit_check(&_ratelimit, _src, _level, \
+			LOG_RATELIMIT_BURST, \
+			Z_LOG_RATELIMIT_INTERVAL(LOG_RATELIMIT_RATE))) { \
+			break; \
+		} \
+	}))
+
 /*****************************************************************************/
 /****************** Macros for standard logging ******************************/
 /*****************************************************************************/
@@ -234,6 +304,7 @@ static inline char z_log_minimal_level_to_char(int level)
 	int _mode; \
 	void *_src = IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ? \
 		(void *)_dsource : (void *)_source; \
+	Z_LOG_RATELIMIT(_level, _src, is_user_context) \
 	Z_LOG_MSG_CREATE(UTIL_NOT(IS_ENABLED(CONFIG_USERSPACE)), _mode, \
 				  Z_LOG_LOCAL_DOMAIN_ID, _src, _level, NULL,\
 			  0, __VA_ARGS__); \
@@ -312,6 +383,7 @@ static inline char z_log_minimal_level_to_char(int level)
 	int mode; \
 	void *_src = IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ? \
 		(void *)_dsource : (void *)_source; \
+	Z_LOG_RATELIMIT(_level, _src, is_user_context) \
 	Z_LOG_MSG_CREATE(UTIL_NOT(IS_ENABLED(CONFIG_USERSPACE)), mode, \
 				  Z_LOG_LOCAL_DOMAIN_ID, _src, _level, \
 			  _data, _len, \
@@ -47,6 +47,23 @@ struct log_dict_output_dropped_msg_t {
 	uint16_t num_dropped_messages;
 } __packed;
 
+/** First byte of the frame sync word. */
+#define LOG_DICT_OUTPUT_FRAME_SYNC0 0x5A
+
+/** Second byte of the frame sync word. */
+#define LOG_DICT_OUTPUT_FRAME_SYNC1 0xA5
+
+/**
+ * Header of a frame holding one dictionary based log message, used when
+ * CONFIG_LOG_DICTIONARY_FRAMING is enabled. The message follows the header
+ * and is followed by its CRC-16/CCITT, computed with crc16_ccitt() and a
+ * seed of 0xffff. The length and the CRC are little endian.
+ */
+struct log_dict_output_frame_hdr_t {
+	uint8_t sync[2];
+	uint16_t len;
+} __packed;
+
 /** @brief Process log messages v2 for dictionary-based logging.
  *
  * Function is using provided context with the buffer and output function to
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Sampling profiler API
+ */
+
+#ifndef ZEPHYR_INCLUDE_PROFILING_PERF_H_
+#define ZEPHYR_INCLUDE_PROFILING_PERF_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Sampling profiler
+ * @defgroup profiling_perf Sampling profiler
+ * @ingroup os_services
+ * @{
+ */
+
+/** Magic number starting a profiler dump, in the byte order of the target. */
+#define PERF_DUMP_MAGIC 0x46524550
+
+/** Version of the dump format. */
+#define PERF_DUMP_VERSION 1
+
+/**
+ * @brief Header of a profiler dump.
+ *
+ * The header is followed by a @ref perf_dump_cpu_header and the samples of
+ * each CPU. Samples are stored as words of @p word_size bytes: the number of
+ * frames of the sample followed by the frames, starting with the interrupted
+ * program counter and going up the call stack with return addresses.
+ */
+struct perf_dump_header {
+	uint32_t magic;
+	uint8_t version;
+	uint8_t word_size;
+	uint8_t num_cpus;
+	uint8_t reserved;
+	/** Sampling frequency in Hz. */
+	uint32_t frequency;
+};
+
+/** @brief Header of the samples of a CPU in a profiler dump. */
+struct perf_dump_cpu_header {
+	uint32_t cpu;
+	/** Number of samples recorded. */
+	uint32_t samples;
+	/** Number of samples dropped because the buffer was full. */
+	uint32_t dropped;
+	/** Number of words following the header. */
+	uint32_t words;
+};
+
+/**
+ * @brief Callback receiving chunks of a profiler dump.
+ *
+ * @param data Dump data.
+ * @param len Length of the data.
+ * @param user_data User data given to @ref perf_dump.
+ */
+typedef void (*perf_dump_cb_t)(const uint8_t *data, size_t len,
+			       void *user_data);
+
+/**
+ * @brief Start sampling.
+ *
+ * Samples recorded by a previous run are discarded. The sampling period is
+ * rounded to system clock ticks.
+ *
+ * @param frequency Sampling frequency in Hz.
+ * @param duration Time after which sampling stops, or K_FOREVER to sample
+ *		   until @ref perf_stop is called.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if the frequency is 0 or higher than the tick rate.
+ * @retval -EALREADY if sampling is already running.
+ */
+int perf_start(uint32_t frequency, k_timeout_t duration);
+
+/**
+ * @brief Stop sampling.
+ *
+ * @retval 0 on success.
+ * @retval -EALREADY if sampling is not running.
+ */
+int perf_stop(void);
+
+/**
+ * @brief Check if sampling is running.
+ *
+ * @return true if sampling is running.
+ */
+bool perf_is_running(void);
+
+/**
+ * @brief Get the number of samples recorded on a CPU.
+ *
+ * @param cpu CPU index.
+ * @param stats Filled with the statistics of the CPU.
+ */
+void perf_stats_get(unsigned int cpu, struct perf_dump_cpu_header *stats);
+
+/**
+ * @brief Dump the recorded samples.
+ *
+ * @param cb Callback called with consecutive chunks of the dump.
+ * @param user_data User data passed to the callback.
+ *
+ * @retval 0 on success.
+ * @retval -EBUSY if sampling is running.
+ */
+int perf_dump(perf_dump_cb_t cb, void *user_data);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_PROFILING_PERF_H_ */
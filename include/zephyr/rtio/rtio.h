@@ -27,6 +27,7 @@
 #define ZEPHYR_INCLUDE_RTIO_RTIO_H_
 
 #include <string.h>
+#include <sys/types.h>
 
 #include <zephyr/app_memory/app_memdomain.h>
 #include <zephyr/device.h>
@@ -276,6 +277,13 @@ struct rtio_sqe {
 			uint8_t *rx_buf;
 		};
 
+		/** OP_FLASH_READ, OP_FLASH_WRITE, OP_FLASH_ERASE */
+		struct {
+			uint32_t flash_len; /**< Length of the buffer or region */
+			uint8_t *flash_buf; /**< Buffer to use, unused for erase */
+			off_t flash_off; /**< Offset in the flash device */
+		};
+
 	};
 };
 
@@ -470,6 +478,15 @@ struct rtio_iodev {
 /** An operation that transceives (reads and writes simultaneously) */
 #define RTIO_OP_TXRX (RTIO_OP_CALLBACK+1)
 
+/** An operation that reads from a given offset of a flash device */
+#define RTIO_OP_FLASH_READ (RTIO_OP_TXRX+1)
+
+/** An operation that writes to a given offset of a flash device */
+#define RTIO_OP_FLASH_WRITE (RTIO_OP_FLASH_READ+1)
+
+/** An operation that erases a region of a flash device */
+#define RTIO_OP_FLASH_ERASE (RTIO_OP_FLASH_WRITE+1)
+
 
 /**
  * @brief Prepare a nop (no op) submission
@@ -614,6 +631,67 @@ static inline void rtio_sqe_prep_transceive(struct rtio_sqe *sqe,
 	sqe->userdata = userdata;
 }
 
+/**
+ * @brief Prepare a flash read op submission
+ */
+static inline void rtio_sqe_prep_flash_read(struct rtio_sqe *sqe,
+					    const struct rtio_iodev *iodev,
+					    int8_t prio,
+					    off_t offset,
+					    uint8_t *buf,
+					    uint32_t len,
+					    void *userdata)
+{
+	memset(sqe, 0, sizeof(struct rtio_sqe));
+	sqe->op = RTIO_OP_FLASH_READ;
+	sqe->prio = prio;
+	sqe->iodev = iodev;
+	sqe->flash_off = offset;
+	sqe->flash_buf = buf;
+	sqe->flash_len = len;
+	sqe->userdata = userdata;
+}
+
+/**
+ * @brief Prepare a flash write op submission
+ */
+static inline void rtio_sqe_prep_flash_write(struct rtio_sqe *sqe,
+					     const struct rtio_iodev *iodev,
+					     int8_t prio,
+					     off_t offset,
+					     const uint8_t *buf,
+					     uint32_t len,
+					     void *userdata)
+{
+	memset(sqe, 0, sizeof(struct rtio_sqe));
+	sqe->op = RTIO_OP_FLASH_WRITE;
+	sqe->prio = prio;
+	sqe->iodev = iodev;
+	sqe->flash_off = offset;
+	sqe->flash_buf = (uint8_t *)buf;
+	sqe->flash_len = len;
+	sqe->userdata = userdata;
+}
+
+/**
+ * @brief Prepare a flash erase op submission
+ */
+static inline void rtio_sqe_prep_flash_erase(struct rtio_sqe *sqe,
+					     const struct rtio_iodev *iodev,
+					     int8_t prio,
+					     off_t offset,
+					     uint32_t len,
+					     void *userdata)
+{
+	memset(sqe, 0, sizeof(struct rtio_sqe));
+	sqe->op = RTIO_OP_FLASH_ERASE;
+	sqe->prio = prio;
+	sqe->iodev = iodev;
+	sqe->flash_off = offset;
+	sqe->flash_len = len;
+	sqe->userdata = userdata;
+}
+
 static inline struct rtio_iodev_sqe *rtio_sqe_pool_alloc(struct rtio_sqe_pool *pool)
 {
 	struct rtio_mpsc_node *node = rtio_mpsc_pop(&pool->free_q);
@@ -25,6 +25,13 @@ struct shell_uart_ctrl_blk {
 	void *context;
 	atomic_t tx_busy;
 	bool blocking_tx;
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC
+	/* Number of bytes claimed from the TX ring buffer for uart_tx() */
+	uint32_t tx_len;
+	uint8_t rx_bufs[2][CONFIG_SHELL_BACKEND_SERIAL_ASYNC_RX_BUFFER_SIZE];
+	uint8_t rx_buf_idx;
+	bool rx_stop;
+#endif /* CONFIG_SHELL_BACKEND_SERIAL_ASYNC */
 #ifdef CONFIG_MCUMGR_TRANSPORT_SHELL
 	struct smp_shell_data smp;
 #endif /* CONFIG_MCUMGR_TRANSPORT_SHELL */
@@ -42,6 +49,16 @@ struct shell_uart_ctrl_blk {
 #define Z_UART_SHELL_DTR_TIMER_DECLARE(_name) static struct k_timer _name##_dtr_timer
 #define Z_UART_SHELL_DTR_TIMER_PTR(_name) (&_name##_dtr_timer)
 
+#elif defined(CONFIG_SHELL_BACKEND_SERIAL_ASYNC)
+#define Z_UART_SHELL_TX_RINGBUF_DECLARE(_name, _size) \
+	RING_BUF_DECLARE(_name##_tx_ringbuf, _size)
+
+#define Z_UART_SHELL_RX_TIMER_DECLARE(_name) /* Empty */
+#define Z_UART_SHELL_TX_RINGBUF_PTR(_name) (&_name##_tx_ringbuf)
+#define Z_UART_SHELL_RX_TIMER_PTR(_name) NULL
+#define Z_UART_SHELL_DTR_TIMER_DECLARE(_name) /* Empty */
+#define Z_UART_SHELL_DTR_TIMER_PTR(_name) NULL
+
 #else /* CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN */
 #define Z_UART_SHELL_TX_RINGBUF_DECLARE(_name, _size) /* Empty */
 #define Z_UART_SHELL_RX_TIMER_DECLARE(_name) static struct k_timer _name##_timer
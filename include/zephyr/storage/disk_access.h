@@ -107,6 +107,56 @@ int disk_access_write(const char *pdrv, const uint8_t *data_buf,
  */
 int disk_access_ioctl(const char *pdrv, uint8_t cmd, void *buff);
 
+#if defined(CONFIG_DISK_CACHE) || defined(__DOXYGEN__)
+
+/**
+ * @brief Disk access block cache statistics
+ *
+ * Counters are shared by all disks using the cache. Sector counts are in
+ * units of the sector size of the disk they were transferred from.
+ */
+struct disk_access_cache_stats {
+	/** Number of sectors read from the cache */
+	uint32_t hits;
+	/** Number of sectors read from the disk on request */
+	uint32_t misses;
+	/** Number of sectors read ahead of a sequential access */
+	uint32_t read_ahead;
+	/** Number of requests too large to go through the cache */
+	uint32_t bypasses;
+	/** Number of write commands issued to write back dirty sectors */
+	uint32_t write_backs;
+	/** Number of sectors written back */
+	uint32_t written_back;
+};
+
+/**
+ * @brief Write back the cached data of a disk
+ *
+ * Writes all sectors of the disk that are only held in the block cache.
+ * The same happens on a DISK_IOCTL_CTRL_SYNC request, which file systems
+ * issue when they sync, so this is only needed by direct disk users.
+ *
+ * @param[in] pdrv          Disk name
+ *
+ * @return 0 on success, negative errno code on fail
+ */
+int disk_access_cache_flush(const char *pdrv);
+
+/**
+ * @brief Get the block cache statistics
+ *
+ * @param[out] stats        Statistics since boot or the last reset
+ */
+void disk_access_cache_stats_get(struct disk_access_cache_stats *stats);
+
+/**
+ * @brief Reset the block cache statistics
+ */
+void disk_access_cache_stats_reset(void);
+
+#endif /* CONFIG_DISK_CACHE || __DOXYGEN__ */
+
 #ifdef __cplusplus
 }
 #endif
@@ -271,6 +271,56 @@ const char *flash_area_label(const struct flash_area *fa);
  */
 uint8_t flash_area_erased_val(const struct flash_area *fa);
 
+#if defined(CONFIG_FLASH_MAP_CACHE) || defined(__DOXYGEN__)
+/**
+ * @brief Flash area read cache statistics
+ */
+struct flash_area_cache_stats {
+	/** Reads served entirely from the cache */
+	uint32_t hits;
+	/** Reads that needed a page to be fetched from a flash device */
+	uint32_t misses;
+	/** Reads passed directly to the flash device */
+	uint32_t bypasses;
+	/** Cache pages dropped by writes, erases and explicit invalidation */
+	uint32_t invalidations;
+};
+
+/**
+ * Get flash area read cache statistics.
+ *
+ * @param[out] stats Statistics collected since boot or last reset.
+ */
+void flash_area_cache_stats_get(struct flash_area_cache_stats *stats);
+
+/**
+ * Reset flash area read cache statistics.
+ */
+void flash_area_cache_stats_reset(void);
+
+/**
+ * Drop all pages from the flash area read cache.
+ *
+ * Needs to be called after flash contents have been modified without use
+ * of flash_area_write() or flash_area_erase(), for example through
+ * the flash driver API.
+ */
+void flash_area_cache_invalidate(void);
+
+/**
+ * Drop the pages of a device range from the flash area read cache.
+ *
+ * Needs to be called after the range has been written or erased through
+ * the flash driver API, as done by stream_flash.
+ *
+ * @param dev Flash device.
+ * @param off Device offset of the range.
+ * @param len Length of the range.
+ */
+void flash_area_cache_invalidate_range(const struct device *dev, off_t off,
+				       size_t len);
+#endif /* CONFIG_FLASH_MAP_CACHE */
+
 #define FLASH_AREA_LABEL_EXISTS(label) __DEPRECATED_MACRO \
 	DT_HAS_FIXED_PARTITION_LABEL(label)
 
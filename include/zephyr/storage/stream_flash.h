@@ -23,6 +23,9 @@
 
 #include <stdbool.h>
 #include <zephyr/drivers/flash.h>
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+#include <zephyr/kernel.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -63,6 +66,18 @@ struct stream_flash_ctx {
 #ifdef CONFIG_STREAM_FLASH_ERASE
 	off_t last_erased_page_start_offset; /* Last erased offset */
 #endif
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	uint8_t *bufs; /* Base of write buffers, NULL for synchronous context */
+	uint8_t buf_cnt; /* Number of write buffers */
+	uint8_t fill_idx; /* Index of buffer being filled */
+	uint8_t write_idx; /* Index of next buffer to be written to flash */
+	atomic_t queued; /* Number of buffers queued for writing */
+	size_t queued_len[CONFIG_STREAM_FLASH_ASYNC_MAX_BUFFERS]; /* Data length of buffers */
+	size_t bytes_queued; /* Number of bytes written and queued for writing */
+	struct k_sem free_bufs; /* Buffers available for filling */
+	struct k_work work; /* Work item writing queued buffers */
+	int async_rc; /* First error reported by background writes */
+#endif
 };
 
 /**
@@ -79,11 +94,66 @@ struct stream_flash_ctx {
  *             of the flash device minus the offset.
  * @param cb Callback to be invoked on completed flash write operations.
  *
+ * With CONFIG_STREAM_FLASH_ASYNC, @p ctx must be zeroed before it is first
+ * initialized. Buffers still queued by a previous asynchronous stream are
+ * dropped, once the one being written reaches the flash.
+ *
  * @return non-negative on success, negative errno code on fail
  */
 int stream_flash_init(struct stream_flash_ctx *ctx, const struct device *fdev,
 		      uint8_t *buf, size_t buf_len, size_t offset, size_t size,
 		      stream_flash_callback_t cb);
+/**
+ * @brief Initialize context for multi-buffered, asynchronous stream writes.
+ *
+ * Works as @ref stream_flash_init but @p buf holds @p buf_cnt consecutive
+ * write buffers of @p buf_len bytes each. A filled buffer is written to flash
+ * by a dedicated work queue while the next one is being filled; the writer
+ * only blocks when all buffers are waiting to be written.
+ * Write errors are reported by subsequent calls to
+ * @ref stream_flash_buffered_write or @ref stream_flash_wait.
+ *
+ * When the callback @p cb is used, it is invoked from the work queue thread.
+ *
+ * @p ctx must be zeroed before it is first initialized. Buffers still queued
+ * by a previous asynchronous stream are dropped, once the one being written
+ * reaches the flash.
+ *
+ * @param ctx context to be initialized
+ * @param fdev Flash device to operate on
+ * @param buf Write buffers, @p buf_cnt * @p buf_len bytes
+ * @param buf_len Length of a single write buffer. Can not be larger than the
+ *                page size. Must be multiple of the flash device
+ *                write-block-size.
+ * @param buf_cnt Number of write buffers, at least 2 and at most
+ *                CONFIG_STREAM_FLASH_ASYNC_MAX_BUFFERS.
+ * @param offset Offset within flash device to start writing to
+ * @param size Number of bytes available for performing buffered write.
+ *             If this is '0', the size will be set to the total size
+ *             of the flash device minus the offset.
+ * @param cb Callback to be invoked on completed flash write operations.
+ *
+ * @return non-negative on success, negative errno code on fail
+ */
+int stream_flash_init_async(struct stream_flash_ctx *ctx,
+			    const struct device *fdev, uint8_t *buf,
+			    size_t buf_len, size_t buf_cnt, size_t offset,
+			    size_t size, stream_flash_callback_t cb);
+
+/**
+ * @brief Wait for buffers queued for writing to reach the flash.
+ *
+ * Data still held in the buffer being filled is not written; use
+ * @ref stream_flash_buffered_write with flush set for that. For contexts
+ * initialized with @ref stream_flash_init the function returns immediately.
+ *
+ * @param ctx context
+ *
+ * @return non-negative on success, negative errno code of the first failed
+ *         background write otherwise
+ */
+int stream_flash_wait(struct stream_flash_ctx *ctx);
+
 /**
  * @brief Read number of bytes written to the flash.
  *
@@ -109,6 +179,8 @@ size_t stream_flash_bytes_written(struct stream_flash_ctx *ctx);
  *        A flush write should be the last write operation in a sequence of
  *        write operations for given context (although this is not mandatory
  *        if the total data size is a multiple of the buffer size).
+ *        For asynchronous contexts flush also waits for all queued
+ *        buffers to be written.
  *
  * @return non-negative on success, negative errno code on fail
  */
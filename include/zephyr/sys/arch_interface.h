@@ -494,6 +494,18 @@ static inline uint32_t arch_proc_id(void);
  */
 void arch_sched_ipi(void);
 
+#ifdef CONFIG_ARCH_HAS_DIRECTED_IPIS
+/**
+ * Send an interrupt to a set of CPUs
+ *
+ * This will invoke z_sched_ipi() on the CPUs of the bitmap. The bit of
+ * the current CPU is ignored.
+ *
+ * @param cpu_bitmap Bitmap of the IDs of the CPUs to interrupt.
+ */
+void arch_sched_directed_ipi(uint32_t cpu_bitmap);
+#endif
+
 #endif /* CONFIG_SMP */
 
 /**
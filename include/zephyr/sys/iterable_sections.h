@@ -7,6 +7,8 @@
 #ifndef INCLUDE_ZEPHYR_SYS_ITERABLE_SECTIONS_H_
 #define INCLUDE_ZEPHYR_SYS_ITERABLE_SECTIONS_H_
 
+#include <stddef.h>
+#include <stdint.h>
 #include <zephyr/sys/__assert.h>
 #include <zephyr/toolchain.h>
 
@@ -141,6 +143,62 @@ extern "C" {
 		  (uintptr_t)TYPE_SECTION_START(secname)) / sizeof(type); \
 } while (0)
 
+/** @cond INTERNAL_HIDDEN */
+static inline void *z_section_bsearch(const void *key, const void *start,
+				      size_t count, size_t size,
+				      int (*cmp)(const void *key, const void *elem))
+{
+	const uint8_t *base = (const uint8_t *)start;
+
+	while (count > 0) {
+		const uint8_t *elem = base + (count / 2) * size;
+		int res = cmp(key, elem);
+
+		if (res == 0) {
+			return (void *)elem;
+		}
+
+		if (res > 0) {
+			base = elem + size;
+			count -= count / 2 + 1;
+		} else {
+			count /= 2;
+		}
+	}
+
+	return NULL;
+}
+/** @endcond */
+
+/**
+ * @brief Binary search of an element in a section for a generic type.
+ *
+ * @details
+ * The linker sorts the elements of an iterable section by the postfix of
+ * their section name, which is the variable name unless a custom name is
+ * given. Elements which can be compared with a key in that order can be
+ * looked up without iterating over the whole section.
+ *
+ * @note Sections created with ITERABLE_SECTION_ROM_NUMERIC() or
+ * ITERABLE_SECTION_RAM_NUMERIC() are not sorted in the plain name order.
+ *
+ * @param[in]  type type of element
+ * @param[in]  secname name of output section
+ * @param[in]  key Key passed to @p cmp.
+ * @param[in]  cmp Function comparing @p key with an element, with the
+ *		   same semantics as the comparison function of bsearch().
+ * @param[out] dst Pointer to location where pointer to the matching element
+ *		   is written, NULL if there is none.
+ */
+#define TYPE_SECTION_BSEARCH(type, secname, key, cmp, dst) do { \
+	TYPE_SECTION_START_EXTERN(type, secname); \
+	TYPE_SECTION_END_EXTERN(type, secname); \
+	*(dst) = (type *)z_section_bsearch(key, TYPE_SECTION_START(secname), \
+					   TYPE_SECTION_END(secname) - \
+					   TYPE_SECTION_START(secname), \
+					   sizeof(type), cmp); \
+} while (0)
+
 /**
  * @brief iterable section start symbol for a struct type
  *
@@ -281,6 +339,33 @@ extern "C" {
 #define STRUCT_SECTION_COUNT(struct_type, dst) \
 	TYPE_SECTION_COUNT(struct struct_type, struct_type, dst);
 
+/**
+ * @brief Binary search of an element in a section (alternate).
+ *
+ * @see TYPE_SECTION_BSEARCH
+ *
+ * @param[in]  secname name of output section
+ * @param[in]  struct_type Struct type.
+ * @param[in]  key Key passed to @p cmp.
+ * @param[in]  cmp Comparison function.
+ * @param[out] dst Pointer to location where pointer to element is written.
+ */
+#define STRUCT_SECTION_BSEARCH_ALTERNATE(secname, struct_type, key, cmp, dst) \
+	TYPE_SECTION_BSEARCH(struct struct_type, secname, key, cmp, dst)
+
+/**
+ * @brief Binary search of an element in a section.
+ *
+ * @see TYPE_SECTION_BSEARCH
+ *
+ * @param[in]  struct_type Struct type.
+ * @param[in]  key Key passed to @p cmp.
+ * @param[in]  cmp Comparison function.
+ * @param[out] dst Pointer to location where pointer to element is written.
+ */
+#define STRUCT_SECTION_BSEARCH(struct_type, key, cmp, dst) \
+	STRUCT_SECTION_BSEARCH_ALTERNATE(struct_type, struct_type, key, cmp, dst)
+
 /**
  * @}
  */ /* end of struct_section_apis */
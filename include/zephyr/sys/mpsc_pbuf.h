@@ -39,6 +39,10 @@ extern "C" {
  * Reading packets is performed in two steps. First packet is claimed. Claiming
  * returns pointer to the packet within the buffer. Packet is freed when no
  * longer in use.
+ *
+ * If overwrite mode is not selected, producers reserve space with atomic
+ * operations and take the lock only when the buffer is about to wrap or to
+ * fill up. Free space of such a buffer is kept zeroed.
  */
 
 /**@defgroup MPSC_PBUF_FLAGS MPSC packet buffer flags
@@ -89,10 +93,10 @@ typedef void (*mpsc_pbuf_notify_drop)(const struct mpsc_pbuf_buffer *buffer,
 /** @brief MPSC packet buffer structure. */
 struct mpsc_pbuf_buffer {
 	/** Temporary write index. */
-	uint32_t tmp_wr_idx;
+	atomic_t tmp_wr_idx;
 
 	/** Write index. */
-	uint32_t wr_idx;
+	atomic_t wr_idx;
 
 	/** Temporary read index. */
 	uint32_t tmp_rd_idx;
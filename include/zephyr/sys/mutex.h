@@ -11,9 +11,12 @@
  * sys_mutex behaves almost exactly like k_mutex, with the added advantage
  * that a sys_mutex instance can reside in user memory.
  *
- * Further enhancements will support locking/unlocking uncontended sys_mutexes
- * with simple atomic ops instead of syscalls, similar to Linux's
- * FUTEX_LOCK_PI and FUTEX_UNLOCK_PI
+ * With CONFIG_THREAD_LOCAL_STORAGE, user threads lock and unlock uncontended
+ * sys_mutexes with atomic ops instead of syscalls, similar to Linux's
+ * FUTEX_LOCK_PI and FUTEX_UNLOCK_PI: the kernel is only involved to wait for
+ * the mutex, and to hand it over to the waiters with priority inheritance.
+ * Without it, k_current_get() is a syscall itself, so user threads always
+ * call the kernel.
  */
 
 #ifdef __cplusplus
@@ -21,18 +24,23 @@ extern "C" {
 #endif
 
 #ifdef CONFIG_USERSPACE
+#include <zephyr/kernel.h>
 #include <zephyr/sys/atomic.h>
 #include <zephyr/types.h>
 #include <zephyr/sys_clock.h>
 
 struct sys_mutex {
-	/* Currently unused, but will be used to store state for fast mutexes
-	 * that can be locked/unlocked with atomic ops if there is no
-	 * contention
+	/* Owner thread, or 0 when free, with Z_SYS_MUTEX_CONTENDED set while
+	 * threads wait for it in the kernel
 	 */
 	atomic_t val;
+
+	/* Recursive lock count, only accessed by the owner */
+	uint32_t lock_count;
 };
 
+#define Z_SYS_MUTEX_CONTENDED BIT(0)
+
 /**
  * @defgroup user_mutex_apis User mode mutex APIs
  * @ingroup kernel_apis
@@ -67,11 +75,9 @@ struct sys_mutex {
  */
 static inline void sys_mutex_init(struct sys_mutex *mutex)
 {
-	ARG_UNUSED(mutex);
-
-	/* Nothing to do, kernel-side data structures are initialized at
-	 * boot
-	 */
+	/* Kernel-side data structures are initialized at boot */
+	atomic_clear(&mutex->val);
+	mutex->lock_count = 0U;
 }
 
 __syscall int z_sys_mutex_kernel_lock(struct sys_mutex *mutex,
@@ -89,6 +95,10 @@ __syscall int z_sys_mutex_kernel_unlock(struct sys_mutex *mutex);
  * A thread is permitted to lock a mutex it has already locked. The operation
  * completes immediately and the lock count is increased by 1.
  *
+ * With CONFIG_THREAD_LOCAL_STORAGE, user threads only make a syscall if the
+ * mutex is locked by another thread, and fault instead of getting -EACCES if
+ * they have no access to the mutex.
+ *
  * @param mutex Address of the mutex, which may reside in user memory
  * @param timeout Waiting period to lock the mutex,
  *                or one of the special values K_NO_WAIT and K_FOREVER.
@@ -96,12 +106,31 @@ __syscall int z_sys_mutex_kernel_unlock(struct sys_mutex *mutex);
  * @retval 0 Mutex locked.
  * @retval -EBUSY Returned without waiting.
  * @retval -EAGAIN Waiting period timed out.
- * @retval -EACCES Caller has no access to provided mutex address
- * @retval -EINVAL Provided mutex not recognized by the kernel
+ * @retval -EACCES Provided mutex address is NULL, in a user thread
+ * @retval -EINVAL Provided mutex not recognized by the kernel, or the
+ *                 mutex holds an owner which is not a thread able to
+ *                 write to the mutex
  */
 static inline int sys_mutex_lock(struct sys_mutex *mutex, k_timeout_t timeout)
 {
-	/* For now, make the syscall unconditionally */
+	/* Supervisor threads call the kernel directly, which validates the
+	 * mutex. User threads need TLS to get their thread without a syscall.
+	 */
+	if (IS_ENABLED(CONFIG_THREAD_LOCAL_STORAGE) && k_is_user_context() &&
+	    (mutex != NULL)) {
+		atomic_val_t self = (atomic_val_t)k_current_get();
+
+		if (atomic_cas(&mutex->val, 0, self)) {
+			mutex->lock_count = 1U;
+			return 0;
+		}
+
+		if ((atomic_get(&mutex->val) & ~Z_SYS_MUTEX_CONTENDED) == self) {
+			mutex->lock_count++;
+			return 0;
+		}
+	}
+
 	return z_sys_mutex_kernel_lock(mutex, timeout);
 }
 
@@ -115,16 +144,35 @@ static inline int sys_mutex_lock(struct sys_mutex *mutex, k_timeout_t timeout)
  * the calling thread as many times as it was previously locked by that
  * thread.
  *
+ * With CONFIG_THREAD_LOCAL_STORAGE, user threads only make a syscall if
+ * other threads wait for the mutex.
+ *
  * @param mutex Address of the mutex, which may reside in user memory
  * @retval 0 Mutex unlocked
- * @retval -EACCES Caller has no access to provided mutex address
+ * @retval -EACCES Provided mutex address is NULL, in a user thread
  * @retval -EINVAL Provided mutex not recognized by the kernel or mutex wasn't
  *                 locked
  * @retval -EPERM Caller does not own the mutex
  */
 static inline int sys_mutex_unlock(struct sys_mutex *mutex)
 {
-	/* For now, make the syscall unconditionally */
+	if (IS_ENABLED(CONFIG_THREAD_LOCAL_STORAGE) && k_is_user_context() &&
+	    (mutex != NULL)) {
+		atomic_val_t self = (atomic_val_t)k_current_get();
+
+		if ((atomic_get(&mutex->val) & ~Z_SYS_MUTEX_CONTENDED) == self) {
+			if (mutex->lock_count > 1U) {
+				mutex->lock_count--;
+				return 0;
+			}
+
+			mutex->lock_count = 0U;
+			if (atomic_cas(&mutex->val, self, 0)) {
+				return 0;
+			}
+		}
+	}
+
 	return z_sys_mutex_kernel_unlock(mutex);
 }
 
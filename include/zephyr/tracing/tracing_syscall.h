@@ -11,6 +11,8 @@
 #include "tracing_sysview_syscall.h"
 #elif defined CONFIG_TRACING_TEST
 #include "tracing_test_syscall.h"
+#elif defined CONFIG_TRACING_USER
+#include "tracing_user_syscall.h"
 #else
 
 /**
@@ -74,12 +74,16 @@ int z_impl_k_futex_wait(struct k_futex *futex, int expected,
 		return -EINVAL;
 	}
 
+	/* Checked under the lock, as a waker may change the value and wake
+	 * the waiters right before this thread pends
+	 */
+	key = k_spin_lock(&futex_data->lock);
+
 	if (atomic_get(&futex->val) != (atomic_val_t)expected) {
+		k_spin_unlock(&futex_data->lock, key);
 		return -EAGAIN;
 	}
 
-	key = k_spin_lock(&futex_data->lock);
-
 	ret = z_pend_curr(&futex_data->lock,
 			key, &futex_data->wait_q, timeout);
 	if (ret == -EAGAIN) {
@@ -180,6 +180,10 @@ void z_mem_domain_init_thread(struct k_thread *thread);
 /* Memory domain teardown hook, called from z_thread_abort() */
 void z_mem_domain_exit_thread(struct k_thread *thread);
 
+/* Whether a thread's memory domain lets it write [addr, addr + size) */
+bool z_mem_domain_thread_can_write(struct k_thread *thread, uintptr_t addr,
+				   size_t size);
+
 /* This spinlock:
  *
  * - Protects the full set of active k_mem_domain objects and their contents
@@ -233,6 +237,20 @@ void z_mem_manage_boot_finish(void);
 
 void z_handle_obj_poll_events(sys_dlist_t *events, uint32_t state);
 
+#ifdef CONFIG_RINGQ
+/* Whether the next message of a ring queue has been completely put. */
+bool z_ringq_has_data(struct k_ringq *q);
+#endif
+
+#ifdef CONFIG_USERSPACE
+/* Slow paths of sys_mutex, whose owner is in @p word, with the mutex
+ * backing it for waiting and priority inheritance.
+ */
+int z_mutex_word_lock(struct k_mutex *mutex, atomic_t *word,
+		      k_timeout_t timeout);
+int z_mutex_word_unlock(struct k_mutex *mutex, atomic_t *word);
+#endif
+
 #ifdef CONFIG_PM
 
 /* When the kernel is about to go idle, it calls this function to notify the
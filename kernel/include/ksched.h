@@ -67,6 +67,12 @@ void z_requeue_current(struct k_thread *curr);
 struct k_thread *z_swap_next_thread(void);
 void z_thread_abort(struct k_thread *thread);
 
+#ifdef CONFIG_SMP_ADAPTIVE_SPIN
+/* Unlocked hints for adaptive spinning, may be stale on return */
+bool z_is_thread_running_elsewhere(struct k_thread *thread);
+bool z_is_cpu_busy_elsewhere(void);
+#endif
+
 static inline void z_pend_curr_unlocked(_wait_q_t *wait_q, k_timeout_t timeout)
 {
 	(void) z_pend_curr_irqlock(arch_irq_lock(), wait_q, timeout);
@@ -220,6 +226,16 @@ static inline bool z_is_prio_lower_or_equal(int prio1, int prio2)
 	return z_is_prio1_lower_than_or_equal_to_prio2(prio1, prio2);
 }
 
+/* Priority an owner inherits from a waiter of @p target priority, when it
+ * would otherwise run at @p limit, capped by the priority ceiling
+ */
+static inline int32_t z_new_prio_for_inheritance(int32_t target, int32_t limit)
+{
+	int new_prio = z_is_prio_higher(target, limit) ? target : limit;
+
+	return z_get_new_prio_with_ceiling(new_prio);
+}
+
 int32_t z_sched_prio_cmp(struct k_thread *thread_1, struct k_thread *thread_2);
 
 static inline bool _is_valid_prio(int prio, void *entry_point)
@@ -410,6 +426,25 @@ void z_sched_usage_stop(void);
 
 void z_sched_usage_start(struct k_thread *thread);
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_HISTOGRAM
+/**
+ * @brief Record the time at which a thread is made ready
+ */
+void z_sched_usage_ready(struct k_thread *thread);
+#endif
+
+#ifdef CONFIG_SCHED_ISR_USAGE_HISTOGRAM
+/**
+ * @brief Called by the architecture ISR wrapper before calling a handler
+ */
+void z_sched_usage_isr_start(void);
+
+/**
+ * @brief Called by the architecture ISR wrapper after the handler of @a irq
+ */
+void z_sched_usage_isr_stop(unsigned int irq);
+#endif
+
 /**
  * @brief Retrieves CPU cycle usage data for specified core
  */
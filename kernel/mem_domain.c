@@ -320,6 +320,38 @@ void z_mem_domain_exit_thread(struct k_thread *thread)
 	k_spin_unlock(&z_mem_domain_lock, key);
 }
 
+/* Whether [addr, addr + size) lies in a partition of the thread's domain
+ * which the thread may write to
+ */
+bool z_mem_domain_thread_can_write(struct k_thread *thread, uintptr_t addr,
+				   size_t size)
+{
+	struct k_mem_domain *domain;
+	bool ret = false;
+	k_spinlock_key_t key = k_spin_lock(&z_mem_domain_lock);
+
+	domain = thread->mem_domain_info.mem_domain;
+	for (int i = 0; (domain != NULL) && (i < max_partitions); i++) {
+		struct k_mem_partition *part = &domain->partitions[i];
+
+		if ((part->size == 0U) || (addr < part->start) ||
+		    ((addr - part->start) + size > part->size)) {
+			continue;
+		}
+#ifdef K_MEM_PARTITION_IS_WRITABLE
+		if (!K_MEM_PARTITION_IS_WRITABLE(part->attr)) {
+			continue;
+		}
+#endif
+		ret = true;
+		break;
+	}
+
+	k_spin_unlock(&z_mem_domain_lock, key);
+
+	return ret;
+}
+
 int k_mem_domain_add_thread(struct k_mem_domain *domain, k_tid_t thread)
 {
 	int ret = 0;
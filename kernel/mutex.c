@@ -37,6 +37,8 @@
 #include <zephyr/tracing/tracing.h>
 #include <zephyr/sys/check.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/sys/mutex.h>
+#include <kernel_internal.h>
 LOG_MODULE_DECLARE(os, CONFIG_KERNEL_LOG_LEVEL);
 
 /* We use a global spinlock here because some of the synchronization
@@ -77,15 +79,6 @@ static inline int z_vrfy_k_mutex_init(struct k_mutex *mutex)
 #include <syscalls/k_mutex_init_mrsh.c>
 #endif
 
-static int32_t new_prio_for_inheritance(int32_t target, int32_t limit)
-{
-	int new_prio = z_is_prio_higher(target, limit) ? target : limit;
-
-	new_prio = z_get_new_prio_with_ceiling(new_prio);
-
-	return new_prio;
-}
-
 static bool adjust_owner_prio(struct k_mutex *mutex, int32_t new_prio)
 {
 	if (mutex->owner->base.prio != new_prio) {
@@ -100,6 +93,61 @@ static bool adjust_owner_prio(struct k_mutex *mutex, int32_t new_prio)
 	return false;
 }
 
+#ifdef CONFIG_SMP_ADAPTIVE_SPIN
+/* Spins while the owner runs on another CPU and nobody waits, as a short
+ * critical section ends sooner than the two context switches of pending.
+ * Called and returns with the lock held, true if the mutex is available.
+ */
+static bool spin_on_owner(struct k_mutex *mutex, k_spinlock_key_t *key)
+{
+	uint32_t budget = k_us_to_cyc_ceil32(CONFIG_SMP_ADAPTIVE_SPIN_US);
+	uint32_t start = k_cycle_get_32();
+
+	while ((z_waitq_head(&mutex->wait_q) == NULL) &&
+	       z_is_thread_running_elsewhere(mutex->owner)) {
+		k_spin_unlock(&lock, *key);
+
+		do {
+			arch_spin_relax();
+		} while ((*(volatile uint32_t *)&mutex->lock_count != 0U) &&
+			 ((k_cycle_get_32() - start) < budget));
+
+		*key = k_spin_lock(&lock);
+
+		if (mutex->lock_count == 0U) {
+			return true;
+		}
+		if ((k_cycle_get_32() - start) >= budget) {
+			break;
+		}
+	}
+
+	return false;
+}
+#endif
+
+/* Whether the current thread can take the mutex, after spinning for it
+ * if enabled.
+ */
+static bool mutex_available(struct k_mutex *mutex, k_timeout_t timeout,
+			    k_spinlock_key_t *key)
+{
+	if (likely((mutex->lock_count == 0U) || (mutex->owner == _current))) {
+		return true;
+	}
+
+#ifdef CONFIG_SMP_ADAPTIVE_SPIN
+	if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		return spin_on_owner(mutex, key);
+	}
+#else
+	ARG_UNUSED(timeout);
+	ARG_UNUSED(key);
+#endif
+
+	return false;
+}
+
 int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 {
 	int new_prio;
@@ -112,7 +160,7 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 
 	key = k_spin_lock(&lock);
 
-	if (likely((mutex->lock_count == 0U) || (mutex->owner == _current))) {
+	if (mutex_available(mutex, timeout, &key)) {
 
 		mutex->owner_orig_prio = (mutex->lock_count == 0U) ?
 					_current->base.prio :
@@ -142,8 +190,8 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 
 	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_mutex, lock, mutex, timeout);
 
-	new_prio = new_prio_for_inheritance(_current->base.prio,
-					    mutex->owner->base.prio);
+	new_prio = z_new_prio_for_inheritance(_current->base.prio,
+					      mutex->owner->base.prio);
 
 	LOG_DBG("adjusting prio up on mutex %p", mutex);
 
@@ -177,7 +225,7 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		struct k_thread *waiter = z_waitq_head(&mutex->wait_q);
 
 		new_prio = (waiter != NULL) ?
-			new_prio_for_inheritance(waiter->base.prio, mutex->owner_orig_prio) :
+			z_new_prio_for_inheritance(waiter->base.prio, mutex->owner_orig_prio) :
 			mutex->owner_orig_prio;
 
 		LOG_DBG("adjusting prio down on mutex %p", mutex);
@@ -290,6 +338,164 @@ static inline int z_vrfy_k_mutex_unlock(struct k_mutex *mutex)
 #include <syscalls/k_mutex_unlock_mrsh.c>
 #endif
 
+#ifdef CONFIG_USERSPACE
+/* Mutexes whose owner lives in a word of user memory, for sys_mutex.
+ *
+ * The word holds the owner thread, or 0 when free, which user threads
+ * change with atomic operations while Z_SYS_MUTEX_CONTENDED is clear.
+ * Contending threads set it and pend on the k_mutex backing the word,
+ * which holds the owner and its original priority for priority
+ * inheritance while the bit is set, so that the owner has to come here
+ * to hand the mutex over.
+ */
+
+/* The word is writable by user threads, which could otherwise raise the
+ * priority of any thread by storing it as the owner: a user owner must be
+ * able to write the word itself, i.e. have it in its memory domain, as
+ * supervisor threads can.
+ */
+static bool is_valid_owner(struct k_thread *owner, atomic_t *word)
+{
+	struct z_object *ko = z_object_find(owner);
+
+	if ((ko == NULL) || (ko->type != K_OBJ_THREAD) ||
+	    ((ko->flags & K_OBJ_FLAG_INITIALIZED) == 0U)) {
+		return false;
+	}
+
+	if ((owner->base.user_options & K_USER) == 0U) {
+		return true;
+	}
+
+	return z_mem_domain_thread_can_write(owner, (uintptr_t)word,
+					     sizeof(*word));
+}
+
+int z_mutex_word_lock(struct k_mutex *mutex, atomic_t *word,
+		      k_timeout_t timeout)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct k_thread *owner;
+	atomic_val_t val;
+	bool resched = false;
+	int new_prio;
+	int ret;
+
+	while (true) {
+		val = atomic_get(word);
+		if (val == 0) {
+			/* Nobody waits on a free word */
+			if (atomic_cas(word, 0, (atomic_val_t)_current)) {
+				k_spin_unlock(&lock, key);
+				return 0;
+			}
+			continue;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			k_spin_unlock(&lock, key);
+			return -EBUSY;
+		}
+
+		owner = (struct k_thread *)(val & ~Z_SYS_MUTEX_CONTENDED);
+		if ((owner == _current) || !is_valid_owner(owner, word)) {
+			k_spin_unlock(&lock, key);
+			return -EINVAL;
+		}
+
+		if (((val & Z_SYS_MUTEX_CONTENDED) != 0) ||
+		    atomic_cas(word, val, val | Z_SYS_MUTEX_CONTENDED)) {
+			break;
+		}
+	}
+
+	if (mutex->owner != owner) {
+		mutex->owner = owner;
+		mutex->owner_orig_prio = owner->base.prio;
+	}
+
+	new_prio = z_new_prio_for_inheritance(_current->base.prio,
+					      owner->base.prio);
+	if (z_is_prio_higher(new_prio, owner->base.prio)) {
+		(void)adjust_owner_prio(mutex, new_prio);
+	}
+
+	ret = z_pend_curr(&lock, key, &mutex->wait_q, timeout);
+	if (ret == 0) {
+		/* The owner handed the word over */
+		return 0;
+	}
+
+	key = k_spin_lock(&lock);
+
+	if (mutex->owner != NULL) {
+		struct k_thread *waiter = z_waitq_head(&mutex->wait_q);
+
+		new_prio = (waiter != NULL) ?
+			z_new_prio_for_inheritance(waiter->base.prio,
+						   mutex->owner_orig_prio) :
+			mutex->owner_orig_prio;
+		resched = adjust_owner_prio(mutex, new_prio);
+
+		/* Let the owner release the word without the kernel */
+		if ((waiter == NULL) &&
+		    atomic_cas(word, (atomic_val_t)mutex->owner |
+				     Z_SYS_MUTEX_CONTENDED,
+			       (atomic_val_t)mutex->owner)) {
+			mutex->owner = NULL;
+		}
+	}
+
+	if (resched) {
+		z_reschedule(&lock, key);
+	} else {
+		k_spin_unlock(&lock, key);
+	}
+
+	return -EAGAIN;
+}
+
+int z_mutex_word_unlock(struct k_mutex *mutex, atomic_t *word)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct k_thread *new_owner;
+
+	if ((atomic_get(word) & ~Z_SYS_MUTEX_CONTENDED) !=
+	    (atomic_val_t)_current) {
+		k_spin_unlock(&lock, key);
+		return -EPERM;
+	}
+
+	if (mutex->owner == _current) {
+		(void)adjust_owner_prio(mutex, mutex->owner_orig_prio);
+	}
+
+	new_owner = z_unpend_first_thread(&mutex->wait_q);
+	if (new_owner == NULL) {
+		mutex->owner = NULL;
+		atomic_clear(word);
+		z_reschedule(&lock, key);
+		return 0;
+	}
+
+	/* The new owner has the highest priority of the waiters */
+	if (z_waitq_head(&mutex->wait_q) != NULL) {
+		mutex->owner = new_owner;
+		mutex->owner_orig_prio = new_owner->base.prio;
+		atomic_set(word, (atomic_val_t)new_owner | Z_SYS_MUTEX_CONTENDED);
+	} else {
+		mutex->owner = NULL;
+		atomic_set(word, (atomic_val_t)new_owner);
+	}
+
+	arch_thread_return_value_set(new_owner, 0);
+	z_ready_thread(new_owner);
+	z_reschedule(&lock, key);
+
+	return 0;
+}
+#endif /* CONFIG_USERSPACE */
+
 #ifdef CONFIG_OBJ_CORE_MUTEX
 static int init_mutex_obj_core_list(void)
 {
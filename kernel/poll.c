@@ -35,7 +35,7 @@
  */
 static struct k_spinlock lock;
 
-enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED };
+enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED, MODE_SET };
 
 static int signal_poller(struct k_poll_event *event, uint32_t state);
 static int signal_triggered_work(struct k_poll_event *event, uint32_t status);
@@ -87,6 +87,14 @@ static inline bool is_condition_met(struct k_poll_event *event, uint32_t *state)
 			return true;
 		}
 		break;
+#ifdef CONFIG_RINGQ
+	case K_POLL_TYPE_RINGQ_DATA_AVAILABLE:
+		if (z_ringq_has_data(event->ringq)) {
+			*state = K_POLL_STATE_RINGQ_DATA_AVAILABLE;
+			return true;
+		}
+		break;
+#endif
 #ifdef CONFIG_PIPES
 	case K_POLL_TYPE_PIPE_DATA_AVAILABLE:
 		if (k_pipe_read_avail(event->pipe)) {
@@ -109,22 +117,32 @@ static struct k_thread *poller_thread(struct z_poller *p)
 	return p ? CONTAINER_OF(p, struct k_thread, poller) : NULL;
 }
 
+static inline bool is_set_poller(struct z_poller *p)
+{
+	return IS_ENABLED(CONFIG_POLL_SET) && (p->mode == MODE_SET);
+}
+
+/* Poll sets come after the threads, as objects only signal their first
+ * event and the events of a set stay registered.
+ */
 static inline void add_event(sys_dlist_t *events, struct k_poll_event *event,
 			     struct z_poller *poller)
 {
 	struct k_poll_event *pending;
 
 	pending = (struct k_poll_event *)sys_dlist_peek_tail(events);
-	if ((pending == NULL) ||
-		(z_sched_prio_cmp(poller_thread(pending->poller),
-							   poller_thread(poller)) > 0)) {
+	if ((pending == NULL) || is_set_poller(poller) ||
+		(!is_set_poller(pending->poller) &&
+		 (z_sched_prio_cmp(poller_thread(pending->poller),
+				   poller_thread(poller)) > 0))) {
 		sys_dlist_append(events, &event->_node);
 		return;
 	}
 
 	SYS_DLIST_FOR_EACH_CONTAINER(events, pending, _node) {
-		if (z_sched_prio_cmp(poller_thread(poller),
-					poller_thread(pending->poller)) > 0) {
+		if (is_set_poller(pending->poller) ||
+		    (z_sched_prio_cmp(poller_thread(poller),
+				      poller_thread(pending->poller)) > 0)) {
 			sys_dlist_insert(&pending->_node, &event->_node);
 			return;
 		}
@@ -159,6 +177,14 @@ static inline void register_event(struct k_poll_event *event,
 		__ASSERT(event->pipe != NULL, "invalid pipe\n");
 		add_event(&event->pipe->poll_events, event, poller);
 		break;
+#endif
+#ifdef CONFIG_RINGQ
+	case K_POLL_TYPE_RINGQ_DATA_AVAILABLE:
+		__ASSERT(event->ringq != NULL, "invalid ring queue\n");
+		add_event(&event->ringq->poll_events, event, poller);
+		/* Producers only signal ring queues with waiters */
+		(void)atomic_inc(&event->ringq->get_waiters);
+		break;
 #endif
 	case K_POLL_TYPE_IGNORE:
 		/* nothing to do */
@@ -200,6 +226,13 @@ static inline void clear_event_registration(struct k_poll_event *event)
 		__ASSERT(event->pipe != NULL, "invalid pipe\n");
 		remove_event = true;
 		break;
+#endif
+#ifdef CONFIG_RINGQ
+	case K_POLL_TYPE_RINGQ_DATA_AVAILABLE:
+		__ASSERT(event->ringq != NULL, "invalid ring queue\n");
+		(void)atomic_dec(&event->ringq->get_waiters);
+		remove_event = true;
+		break;
 #endif
 	case K_POLL_TYPE_IGNORE:
 		/* nothing to do */
@@ -249,6 +282,17 @@ static inline int register_events(struct k_poll_event *events,
 		} else if (!just_check && poller->is_polling) {
 			register_event(&events[ii], poller);
 			events_registered += 1;
+
+			/* Ring queues are written without the poll lock, and
+			 * may have received data before seeing the
+			 * registration.
+			 */
+			if (IS_ENABLED(CONFIG_RINGQ) &&
+			    (events[ii].type == K_POLL_TYPE_RINGQ_DATA_AVAILABLE) &&
+			    is_condition_met(&events[ii], &state)) {
+				set_event_ready(&events[ii], state);
+				poller->is_polling = false;
+			}
 		} else {
 			/* Event is not one of those identified in is_condition_met()
 			 * catching non-polling events, or is marked for just check,
@@ -464,6 +508,49 @@ static int signal_poll_event(struct k_poll_event *event, uint32_t state)
 	return retcode;
 }
 
+#ifdef CONFIG_POLL_SET
+/* must be called with interrupts locked */
+static void signal_set(struct k_poll_event *event, uint32_t state)
+{
+	struct k_poll_set *set = CONTAINER_OF(event->poller, struct k_poll_set,
+					      poller);
+	struct k_thread *thread;
+
+	event->state |= state;
+
+	/* Already ready events move to the back, behind the others */
+	if (sys_dnode_is_linked(&event->_ready_node)) {
+		sys_dlist_remove(&event->_ready_node);
+	}
+	sys_dlist_append(&set->ready, &event->_ready_node);
+
+	thread = z_unpend_first_thread(&set->wait_q);
+	if (thread != NULL) {
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+	}
+}
+#endif
+
+/* must be called with interrupts locked, @p event just removed from the
+ * @p events of its object
+ */
+static int signal_obj_event(sys_dlist_t *events, struct k_poll_event *event,
+			    uint32_t state)
+{
+#ifdef CONFIG_POLL_SET
+	if (is_set_poller(event->poller)) {
+		sys_dlist_append(events, &event->_node);
+		signal_set(event, state);
+		return 0;
+	}
+#else
+	ARG_UNUSED(events);
+#endif
+
+	return signal_poll_event(event, state);
+}
+
 void z_handle_obj_poll_events(sys_dlist_t *events, uint32_t state)
 {
 	struct k_poll_event *poll_event;
@@ -471,7 +558,7 @@ void z_handle_obj_poll_events(sys_dlist_t *events, uint32_t state)
 
 	poll_event = (struct k_poll_event *)sys_dlist_get(events);
 	if (poll_event != NULL) {
-		(void) signal_poll_event(poll_event, state);
+		(void) signal_obj_event(events, poll_event, state);
 	}
 
 	k_spin_unlock(&lock, key);
@@ -541,7 +628,8 @@ int z_impl_k_poll_signal_raise(struct k_poll_signal *sig, int result)
 		return 0;
 	}
 
-	int rc = signal_poll_event(poll_event, K_POLL_STATE_SIGNALED);
+	int rc = signal_obj_event(&sig->poll_events, poll_event,
+				  K_POLL_STATE_SIGNALED);
 
 	SYS_PORT_TRACING_FUNC(k_poll_api, signal_raise, sig, rc);
 
@@ -813,3 +901,138 @@ int k_work_poll_cancel(struct k_work_poll *work)
 
 	return retval;
 }
+
+#ifdef CONFIG_POLL_SET
+void k_poll_set_init(struct k_poll_set *set)
+{
+	set->poller.is_polling = true;
+	set->poller.mode = MODE_SET;
+	sys_dlist_init(&set->ready);
+	sys_dlist_init(&set->returned);
+	z_waitq_init(&set->wait_q);
+}
+
+int k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	uint32_t state;
+
+	__ASSERT(event->mode == K_POLL_MODE_NOTIFY_ONLY,
+		 "only NOTIFY_ONLY mode is supported\n");
+
+	if (event->poller != NULL) {
+		k_spin_unlock(&lock, key);
+		return -EBUSY;
+	}
+
+	event->state = K_POLL_STATE_NOT_READY;
+	sys_dnode_init(&event->_ready_node);
+	register_event(event, &set->poller);
+
+	/* Objects only signal changes, catch up with the current state */
+	if (is_condition_met(event, &state)) {
+		signal_set(event, state);
+	}
+
+	z_reschedule(&lock, key);
+
+	return 0;
+}
+
+int k_poll_set_remove(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (event->poller != &set->poller) {
+		k_spin_unlock(&lock, key);
+		return -EINVAL;
+	}
+
+	clear_event_registration(event);
+	if (sys_dnode_is_linked(&event->_ready_node)) {
+		sys_dlist_remove(&event->_ready_node);
+	}
+	event->state = K_POLL_STATE_NOT_READY;
+
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+/* must be called with interrupts locked
+ *
+ * Gives the events returned by the previous wait back to the ready list
+ * if their condition still holds, as objects only signal changes.
+ */
+static void rearm_returned(struct k_poll_set *set)
+{
+	struct k_poll_event *event;
+	sys_dnode_t *node;
+	uint32_t state;
+
+	while ((node = sys_dlist_get(&set->returned)) != NULL) {
+		event = CONTAINER_OF(node, struct k_poll_event, _ready_node);
+		event->state = K_POLL_STATE_NOT_READY;
+		if (is_condition_met(event, &state)) {
+			event->state = state;
+			sys_dlist_append(&set->ready, &event->_ready_node);
+		}
+	}
+}
+
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **events,
+		    int max_events, k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	int count = 0;
+
+	__ASSERT(!arch_is_in_isr(), "");
+	__ASSERT(max_events > 0, "no room for events\n");
+
+	rearm_returned(set);
+
+	while (count < max_events) {
+		sys_dnode_t *node = sys_dlist_get(&set->ready);
+		struct k_poll_event *event;
+		uint32_t state;
+
+		if (node == NULL) {
+			int ret;
+
+			if (count > 0) {
+				break;
+			}
+
+			timeout = sys_timepoint_timeout(end);
+			if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+				k_spin_unlock(&lock, key);
+				return -EAGAIN;
+			}
+
+			ret = z_pend_curr(&lock, key, &set->wait_q, timeout);
+			if (ret != 0) {
+				return ret;
+			}
+
+			key = k_spin_lock(&lock);
+			continue;
+		}
+
+		/* Another thread may have consumed the object meanwhile */
+		event = CONTAINER_OF(node, struct k_poll_event, _ready_node);
+		if (!is_condition_met(event, &state) &&
+		    ((event->state & K_POLL_STATE_CANCELLED) == 0U)) {
+			event->state = K_POLL_STATE_NOT_READY;
+			continue;
+		}
+
+		sys_dlist_append(&set->returned, &event->_ready_node);
+		events[count++] = event;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return count;
+}
+#endif /* CONFIG_POLL_SET */
@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Ring queues.
+ *
+ * A bounded ring of message slots, each starting with a sequence word
+ * telling whether the slot is free for, or holds the message of, a given
+ * lap of the ring.  Producers and consumers claim positions independently
+ * and publish their slot through its sequence word, so that the lock and
+ * the wait queues are only used when a thread has to wait.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel_structs.h>
+
+#include <string.h>
+#include <ksched.h>
+#include <wait_q.h>
+#include <kernel_internal.h>
+
+/* Positions increase forever and wrap around, the sequence word of a slot
+ * holds the first position of the lap it is free for, plus one once it
+ * holds the message of that lap.  A zeroed buffer is an empty ring.
+ */
+static inline unsigned long pos_lap(struct k_ringq *q, unsigned long pos)
+{
+	return pos & ~(unsigned long)q->mask;
+}
+
+static inline long pos_diff(unsigned long a, unsigned long b)
+{
+	return (long)(a - b);
+}
+
+static inline atomic_t *slot_seq(struct k_ringq *q, unsigned long pos)
+{
+	return &q->buffer[(pos & q->mask) * Z_RINGQ_SLOT_WORDS(q->msg_size)];
+}
+
+/* Signed distance of the slot at @p pos to the state @p offset past its
+ * lap, 0 for free (offset 0) or full (offset 1) in this lap.
+ */
+static inline long slot_state(struct k_ringq *q, unsigned long pos,
+			      unsigned long offset)
+{
+	return pos_diff((unsigned long)atomic_get(slot_seq(q, pos)),
+			pos_lap(q, pos) + offset);
+}
+
+/* Claims the position of @p counter whose slot is in the state @p offset
+ * past its lap, returns false if the slot is behind, i.e. the ring is full
+ * or empty.
+ */
+static bool claim(struct k_ringq *q, atomic_t *counter, unsigned long offset,
+		  bool multi, unsigned long *posp)
+{
+	unsigned long pos = (unsigned long)atomic_get(counter);
+
+	while (true) {
+		long diff = slot_state(q, pos, offset);
+
+		if (diff < 0) {
+			return false;
+		}
+
+		if (diff == 0) {
+			if (!multi) {
+				atomic_set(counter, (atomic_val_t)(pos + 1U));
+				break;
+			}
+			if (atomic_cas(counter, (atomic_val_t)pos,
+				       (atomic_val_t)(pos + 1U))) {
+				break;
+			}
+		}
+
+		/* Another producer or consumer took it, catch up */
+		pos = (unsigned long)atomic_get(counter);
+	}
+
+	*posp = pos;
+
+	return true;
+}
+
+static bool try_put(struct k_ringq *q, const void *data)
+{
+	bool multi = (q->flags & K_RINGQ_FLAG_MULTI_PRODUCER) != 0U;
+	unsigned long pos;
+	atomic_t *seq;
+
+	if (!claim(q, &q->head, 0U, multi, &pos)) {
+		return false;
+	}
+
+	seq = slot_seq(q, pos);
+	(void)memcpy(seq + 1, data, q->msg_size);
+	atomic_set(seq, (atomic_val_t)(pos_lap(q, pos) + 1U));
+
+	return true;
+}
+
+static bool try_get(struct k_ringq *q, void *data)
+{
+	bool multi = (q->flags & K_RINGQ_FLAG_MULTI_CONSUMER) != 0U;
+	unsigned long pos;
+	atomic_t *seq;
+
+	if (!claim(q, &q->tail, 1U, multi, &pos)) {
+		return false;
+	}
+
+	seq = slot_seq(q, pos);
+	(void)memcpy(data, seq + 1, q->msg_size);
+	atomic_set(seq, (atomic_val_t)(pos_lap(q, pos) + q->mask + 1U));
+
+	return true;
+}
+
+static bool is_full(struct k_ringq *q)
+{
+	return slot_state(q, (unsigned long)atomic_get(&q->head), 0U) < 0;
+}
+
+static bool is_empty(struct k_ringq *q)
+{
+	return slot_state(q, (unsigned long)atomic_get(&q->tail), 1U) < 0;
+}
+
+bool z_ringq_has_data(struct k_ringq *q)
+{
+	return !is_empty(q);
+}
+
+/* Blocks until the other end may have made progress.
+ *
+ * The waiter is counted before checking the ring again: the other end
+ * publishes its slot before checking the count, so either it sees the
+ * waiter and wakes it, or the check here sees its slot.
+ *
+ * @retval 0 if the operation should be retried.
+ * @retval -EAGAIN if @p end passed.
+ */
+static int wait_for(struct k_ringq *q, atomic_t *waiters, _wait_q_t *wait_q,
+		    bool (*blocked)(struct k_ringq *q), k_timepoint_t end)
+{
+	k_timeout_t timeout = sys_timepoint_timeout(end);
+	k_spinlock_key_t key;
+	int ret = 0;
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		return -EAGAIN;
+	}
+
+	key = k_spin_lock(&q->lock);
+
+	(void)atomic_inc(waiters);
+	if (blocked(q)) {
+		ret = z_pend_curr(&q->lock, key, wait_q, timeout);
+	} else {
+		k_spin_unlock(&q->lock, key);
+	}
+	(void)atomic_dec(waiters);
+
+	return ret;
+}
+
+/* Wakes a thread waiting on the other end, and the pollers if any. */
+static void wake_waiter(struct k_ringq *q, _wait_q_t *wait_q, bool poll)
+{
+	k_spinlock_key_t key = k_spin_lock(&q->lock);
+	struct k_thread *thread = z_unpend_first_thread(wait_q);
+
+	if (thread != NULL) {
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+	}
+
+#ifdef CONFIG_POLL
+	if (poll) {
+		z_handle_obj_poll_events(&q->poll_events,
+					 K_POLL_STATE_RINGQ_DATA_AVAILABLE);
+	}
+#else
+	ARG_UNUSED(poll);
+#endif
+
+	z_reschedule(&q->lock, key);
+}
+
+void k_ringq_init(struct k_ringq *q, void *buffer, size_t msg_size,
+		  uint32_t max_msgs, uint32_t flags)
+{
+	__ASSERT(IS_POWER_OF_TWO(max_msgs) && (max_msgs > 1U),
+		 "ring queue size must be a power of two");
+	__ASSERT(((uintptr_t)buffer % sizeof(atomic_t)) == 0U,
+		 "unaligned ring queue buffer");
+
+	*q = (struct k_ringq) {
+		.buffer = buffer,
+		.msg_size = msg_size,
+		.mask = max_msgs - 1U,
+		.flags = flags,
+	};
+
+	(void)memset(buffer, 0, K_RINGQ_BUF_SIZE(msg_size, max_msgs));
+	z_waitq_init(&q->get_wait_q);
+	z_waitq_init(&q->put_wait_q);
+#ifdef CONFIG_POLL
+	sys_dlist_init(&q->poll_events);
+#endif
+}
+
+int k_ringq_put(struct k_ringq *q, const void *data, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+
+	while (!try_put(q, data)) {
+		int ret;
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			return -ENOMSG;
+		}
+
+		ret = wait_for(q, &q->put_waiters, &q->put_wait_q, is_full, end);
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	if (atomic_get(&q->get_waiters) != 0) {
+		wake_waiter(q, &q->get_wait_q, true);
+	}
+
+	return 0;
+}
+
+int k_ringq_get(struct k_ringq *q, void *data, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+
+	while (!try_get(q, data)) {
+		int ret;
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			return -ENOMSG;
+		}
+
+		ret = wait_for(q, &q->get_waiters, &q->get_wait_q, is_empty, end);
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	if (atomic_get(&q->put_waiters) != 0) {
+		wake_waiter(q, &q->put_wait_q, false);
+	}
+
+	return 0;
+}
+
+uint32_t k_ringq_num_used_get(struct k_ringq *q)
+{
+	unsigned long tail = (unsigned long)atomic_get(&q->tail);
+	long used = pos_diff((unsigned long)atomic_get(&q->head), tail);
+
+	return (uint32_t)CLAMP(used, 0L, (long)q->mask + 1L);
+}
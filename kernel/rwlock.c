@@ -0,0 +1,438 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file @brief Reader-writer locks
+ *
+ * The state of the lock is a single atomic word, which the uncontended
+ * operations update with compare-and-swap: readers of an idle or read locked
+ * lock do not serialize on the spinlock. Once a thread waits, the waiters flag
+ * makes these fail, so the state only changes under the spinlock until the
+ * waiters are gone. A released lock is handed over to the waiters directly,
+ * it is never free while threads wait for it.
+ *
+ * The writer holding the lock inherits the priority of the waiters, as the
+ * owner of a mutex does, with the same nesting rules.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel_structs.h>
+#include <zephyr/toolchain.h>
+#include <ksched.h>
+#include <wait_q.h>
+#include <errno.h>
+#include <zephyr/syscall_handler.h>
+
+/* The flags are stored in the low bits of the owner thread address */
+BUILD_ASSERT(__alignof__(struct k_thread) >= Z_RWLOCK_READER);
+
+static inline bool is_write_locked(atomic_val_t state)
+{
+	return ((state & Z_RWLOCK_READ_LOCKED) == 0) &&
+	       ((state & ~Z_RWLOCK_WAITERS) != 0);
+}
+
+static inline struct k_thread *writer_of(atomic_val_t state)
+{
+	return is_write_locked(state) ?
+	       (struct k_thread *)(state & ~Z_RWLOCK_WAITERS) : NULL;
+}
+
+static inline atomic_val_t add_reader(atomic_val_t state)
+{
+	return (state | Z_RWLOCK_READ_LOCKED) + Z_RWLOCK_READER;
+}
+
+static inline atomic_val_t release_reader(atomic_val_t state)
+{
+	state -= Z_RWLOCK_READER;
+
+	if ((state & ~(Z_RWLOCK_READ_LOCKED | Z_RWLOCK_WAITERS)) == 0) {
+		state &= Z_RWLOCK_WAITERS;
+	}
+
+	return state;
+}
+
+static inline bool has_waiters(struct k_rwlock *rwlock)
+{
+	return (z_waitq_head(&rwlock->read_q) != NULL) ||
+	       (z_waitq_head(&rwlock->write_q) != NULL);
+}
+
+/* Raises the priority of the writer holding the lock to the one of the
+ * highest priority waiter, including @p waiter about to pend, or lowers it
+ * back after a waiter left
+ */
+static void update_writer_prio(struct k_rwlock *rwlock, struct k_thread *writer,
+			       struct k_thread *waiter)
+{
+	struct k_thread *heads[] = {
+		waiter,
+		z_waitq_head(&rwlock->read_q),
+		z_waitq_head(&rwlock->write_q),
+	};
+	int new_prio;
+
+	if (rwlock->boosted != writer) {
+		rwlock->boosted = writer;
+		rwlock->boosted_orig_prio = writer->base.prio;
+	}
+
+	new_prio = rwlock->boosted_orig_prio;
+	for (int i = 0; i < ARRAY_SIZE(heads); i++) {
+		if (heads[i] != NULL) {
+			new_prio = z_new_prio_for_inheritance(heads[i]->base.prio,
+							      new_prio);
+		}
+	}
+
+	if (writer->base.prio != new_prio) {
+		(void)z_set_prio(writer, new_prio);
+	}
+}
+
+/* Publishes @p state, with the waiters flag as long as threads wait. The flag
+ * must still be set in the current state, or the fast paths could change it
+ * concurrently.
+ */
+static void set_state(struct k_rwlock *rwlock, atomic_val_t state)
+{
+	__ASSERT_NO_MSG((atomic_get(&rwlock->state) & Z_RWLOCK_WAITERS) != 0);
+
+	if (has_waiters(rwlock)) {
+		state |= Z_RWLOCK_WAITERS;
+	} else {
+		state &= ~Z_RWLOCK_WAITERS;
+		rwlock->boosted = NULL;
+	}
+
+	atomic_set(&rwlock->state, state);
+}
+
+static void wake(struct k_thread *thread)
+{
+	arch_thread_return_value_set(thread, 0);
+	z_ready_thread(thread);
+}
+
+static atomic_val_t wake_readers(struct k_rwlock *rwlock, atomic_val_t state)
+{
+	struct k_thread *thread;
+
+	while ((thread = z_unpend_first_thread(&rwlock->read_q)) != NULL) {
+		wake(thread);
+		state = add_reader(state);
+	}
+
+	return state;
+}
+
+/* Hands the released lock over to all the waiting readers, or to the first
+ * waiting writer, as preferred by @p readers_first
+ */
+static void hand_over(struct k_rwlock *rwlock, bool readers_first)
+{
+	atomic_val_t state = 0;
+	struct k_thread *writer;
+
+	if (readers_first || (z_waitq_head(&rwlock->write_q) == NULL)) {
+		state = wake_readers(rwlock, state);
+	}
+
+	if (state == 0) {
+		writer = z_unpend_first_thread(&rwlock->write_q);
+		if (writer != NULL) {
+			wake(writer);
+			state = (atomic_val_t)writer;
+
+			/* The new writer inherits from the threads still
+			 * waiting, readers included
+			 */
+			if (has_waiters(rwlock)) {
+				update_writer_prio(rwlock, writer, NULL);
+			}
+		}
+	}
+
+	set_state(rwlock, state);
+}
+
+/* Cleans up after a waiter timed out */
+static void timed_out(struct k_rwlock *rwlock)
+{
+	k_spinlock_key_t key = k_spin_lock(&rwlock->lock);
+	atomic_val_t state = atomic_get(&rwlock->state);
+
+	/* The thread left the wait queue before taking the spinlock: whoever
+	 * cleared the waiters flag meanwhile found it empty, and cleaned up
+	 * already. The fast paths may be updating the state again.
+	 */
+	if ((state & Z_RWLOCK_WAITERS) == 0) {
+		k_spin_unlock(&rwlock->lock, key);
+		return;
+	}
+
+	if (is_write_locked(state)) {
+		update_writer_prio(rwlock, writer_of(state), NULL);
+	} else if (z_waitq_head(&rwlock->write_q) == NULL) {
+		/* Readers may have waited behind a writer which gave up */
+		state = wake_readers(rwlock, state);
+	}
+
+	set_state(rwlock, state);
+	z_reschedule(&rwlock->lock, key);
+}
+
+int z_impl_k_rwlock_init(struct k_rwlock *rwlock, uint32_t flags)
+{
+	if ((flags & ~K_RWLOCK_FAIR) != 0U) {
+		return -EINVAL;
+	}
+
+	atomic_clear(&rwlock->state);
+	z_waitq_init(&rwlock->read_q);
+	z_waitq_init(&rwlock->write_q);
+	rwlock->lock = (struct k_spinlock) {};
+	rwlock->flags = flags;
+	rwlock->boosted = NULL;
+
+	z_object_init(rwlock);
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_rwlock_init(struct k_rwlock *rwlock, uint32_t flags)
+{
+	Z_OOPS(Z_SYSCALL_OBJ_INIT(rwlock, K_OBJ_RWLOCK));
+	return z_impl_k_rwlock_init(rwlock, flags);
+}
+#include <syscalls/k_rwlock_init_mrsh.c>
+#endif
+
+int z_impl_k_rwlock_read_lock(struct k_rwlock *rwlock, k_timeout_t timeout)
+{
+	atomic_val_t state = atomic_get(&rwlock->state);
+	k_spinlock_key_t key;
+	int ret;
+
+	__ASSERT(!arch_is_in_isr(), "rwlocks cannot be used inside ISRs");
+
+	while ((state == 0) ||
+	       ((state & (Z_RWLOCK_READ_LOCKED | Z_RWLOCK_WAITERS)) ==
+		Z_RWLOCK_READ_LOCKED)) {
+		if (atomic_cas(&rwlock->state, state, add_reader(state))) {
+			return 0;
+		}
+		state = atomic_get(&rwlock->state);
+	}
+
+	key = k_spin_lock(&rwlock->lock);
+
+	/* Until the waiters flag is set, an unlock may still release the lock
+	 * without looking for waiters
+	 */
+	for (;;) {
+		state = atomic_get(&rwlock->state);
+
+		if (writer_of(state) == _current) {
+			k_spin_unlock(&rwlock->lock, key);
+			return -EDEADLK;
+		}
+
+		if (!is_write_locked(state) &&
+		    (z_waitq_head(&rwlock->write_q) == NULL)) {
+			if (atomic_cas(&rwlock->state, state, add_reader(state))) {
+				k_spin_unlock(&rwlock->lock, key);
+				return 0;
+			}
+			continue;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			k_spin_unlock(&rwlock->lock, key);
+			return -EBUSY;
+		}
+
+		if (((state & Z_RWLOCK_WAITERS) != 0) ||
+		    atomic_cas(&rwlock->state, state, state | Z_RWLOCK_WAITERS)) {
+			break;
+		}
+	}
+
+	if (is_write_locked(state)) {
+		update_writer_prio(rwlock, writer_of(state), _current);
+	}
+
+	ret = z_pend_curr(&rwlock->lock, key, &rwlock->read_q, timeout);
+	if (ret == -EAGAIN) {
+		timed_out(rwlock);
+	}
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_rwlock_read_lock(struct k_rwlock *rwlock,
+					    k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(rwlock, K_OBJ_RWLOCK));
+	return z_impl_k_rwlock_read_lock(rwlock, timeout);
+}
+#include <syscalls/k_rwlock_read_lock_mrsh.c>
+#endif
+
+int z_impl_k_rwlock_read_unlock(struct k_rwlock *rwlock)
+{
+	atomic_val_t state = atomic_get(&rwlock->state);
+	k_spinlock_key_t key;
+
+	while ((state & (Z_RWLOCK_READ_LOCKED | Z_RWLOCK_WAITERS)) ==
+	       Z_RWLOCK_READ_LOCKED) {
+		if (atomic_cas(&rwlock->state, state, release_reader(state))) {
+			return 0;
+		}
+		state = atomic_get(&rwlock->state);
+	}
+
+	key = k_spin_lock(&rwlock->lock);
+
+	/* The last waiter may have timed out meanwhile, and the fast path be
+	 * open again
+	 */
+	do {
+		state = atomic_get(&rwlock->state);
+		if ((state & Z_RWLOCK_READ_LOCKED) == 0) {
+			k_spin_unlock(&rwlock->lock, key);
+			return -EPERM;
+		}
+	} while (!atomic_cas(&rwlock->state, state, release_reader(state)));
+
+	if (release_reader(state) == Z_RWLOCK_WAITERS) {
+		hand_over(rwlock, false);
+	}
+
+	z_reschedule(&rwlock->lock, key);
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_rwlock_read_unlock(struct k_rwlock *rwlock)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(rwlock, K_OBJ_RWLOCK));
+	return z_impl_k_rwlock_read_unlock(rwlock);
+}
+#include <syscalls/k_rwlock_read_unlock_mrsh.c>
+#endif
+
+int z_impl_k_rwlock_write_lock(struct k_rwlock *rwlock, k_timeout_t timeout)
+{
+	atomic_val_t self = (atomic_val_t)_current;
+	atomic_val_t state;
+	k_spinlock_key_t key;
+	int ret;
+
+	__ASSERT(!arch_is_in_isr(), "rwlocks cannot be used inside ISRs");
+
+	if (atomic_cas(&rwlock->state, 0, self)) {
+		return 0;
+	}
+
+	key = k_spin_lock(&rwlock->lock);
+
+	for (;;) {
+		state = atomic_get(&rwlock->state);
+
+		if (writer_of(state) == _current) {
+			k_spin_unlock(&rwlock->lock, key);
+			return -EDEADLK;
+		}
+
+		if (state == 0) {
+			if (atomic_cas(&rwlock->state, 0, self)) {
+				k_spin_unlock(&rwlock->lock, key);
+				return 0;
+			}
+			continue;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			k_spin_unlock(&rwlock->lock, key);
+			return -EBUSY;
+		}
+
+		if (((state & Z_RWLOCK_WAITERS) != 0) ||
+		    atomic_cas(&rwlock->state, state, state | Z_RWLOCK_WAITERS)) {
+			break;
+		}
+	}
+
+	if (is_write_locked(state)) {
+		update_writer_prio(rwlock, writer_of(state), _current);
+	}
+
+	ret = z_pend_curr(&rwlock->lock, key, &rwlock->write_q, timeout);
+	if (ret == -EAGAIN) {
+		timed_out(rwlock);
+	}
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_rwlock_write_lock(struct k_rwlock *rwlock,
+					     k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(rwlock, K_OBJ_RWLOCK));
+	return z_impl_k_rwlock_write_lock(rwlock, timeout);
+}
+#include <syscalls/k_rwlock_write_lock_mrsh.c>
+#endif
+
+int z_impl_k_rwlock_write_unlock(struct k_rwlock *rwlock)
+{
+	atomic_val_t self = (atomic_val_t)_current;
+	k_spinlock_key_t key;
+
+	if (atomic_cas(&rwlock->state, self, 0)) {
+		return 0;
+	}
+
+	/* Only the owner releases a write locked lock, the state cannot stop
+	 * being write locked by the caller meanwhile
+	 */
+	if (writer_of(atomic_get(&rwlock->state)) != _current) {
+		return -EPERM;
+	}
+
+	key = k_spin_lock(&rwlock->lock);
+
+	if ((rwlock->boosted == _current) &&
+	    (_current->base.prio != rwlock->boosted_orig_prio)) {
+		(void)z_set_prio(_current, rwlock->boosted_orig_prio);
+	}
+	rwlock->boosted = NULL;
+
+	/* The last waiter may have timed out meanwhile */
+	if (!atomic_cas(&rwlock->state, self, 0)) {
+		hand_over(rwlock, (rwlock->flags & K_RWLOCK_FAIR) != 0U);
+	}
+
+	z_reschedule(&rwlock->lock, key);
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_rwlock_write_unlock(struct k_rwlock *rwlock)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(rwlock, K_OBJ_RWLOCK));
+	return z_impl_k_rwlock_write_unlock(rwlock);
+}
+#include <syscalls/k_rwlock_write_unlock_mrsh.c>
+#endif
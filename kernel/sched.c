@@ -25,6 +25,7 @@ LOG_MODULE_DECLARE(os, CONFIG_KERNEL_LOG_LEVEL);
 #if defined(CONFIG_SCHED_DUMB)
 #define _priq_run_add		z_priq_dumb_add
 #define _priq_run_remove	z_priq_dumb_remove
+#define _priq_run_head		z_priq_dumb_best
 # if defined(CONFIG_SCHED_CPU_MASK)
 #  define _priq_run_best	_priq_dumb_mask_best
 # else
@@ -33,11 +34,21 @@ LOG_MODULE_DECLARE(os, CONFIG_KERNEL_LOG_LEVEL);
 #elif defined(CONFIG_SCHED_SCALABLE)
 #define _priq_run_add		z_priq_rb_add
 #define _priq_run_remove	z_priq_rb_remove
-#define _priq_run_best		z_priq_rb_best
+#define _priq_run_head		z_priq_rb_best
+# if defined(CONFIG_SCHED_CPU_MASK)
+#  define _priq_run_best	_priq_rb_mask_best
+# else
+#  define _priq_run_best	z_priq_rb_best
+# endif
 #elif defined(CONFIG_SCHED_MULTIQ)
 #define _priq_run_add		z_priq_mq_add
 #define _priq_run_remove	z_priq_mq_remove
-#define _priq_run_best		z_priq_mq_best
+#define _priq_run_head		z_priq_mq_best
+# if defined(CONFIG_SCHED_CPU_MASK)
+#  define _priq_run_best	_priq_mq_mask_best
+# else
+#  define _priq_run_best	z_priq_mq_best
+# endif
 static ALWAYS_INLINE void z_priq_mq_add(struct _priq_mq *pq,
 					struct k_thread *thread);
 static ALWAYS_INLINE void z_priq_mq_remove(struct _priq_mq *pq,
@@ -169,21 +180,75 @@ static ALWAYS_INLINE bool should_preempt(struct k_thread *thread,
 }
 
 #ifdef CONFIG_SCHED_CPU_MASK
+static ALWAYS_INLINE bool can_run_here(struct k_thread *thread)
+{
+	return (thread->base.cpu_mask & BIT(_current_cpu->id)) != 0;
+}
+
+/* Threads with a single CPU in their mask are pinned, they are kept in
+ * the run queue of that CPU rather than in the shared one
+ */
+static ALWAYS_INLINE bool is_pinned(struct k_thread *thread)
+{
+	unsigned int m = thread->base.cpu_mask;
+
+	return m != 0 && (m & (m - 1)) == 0 &&
+	       u32_count_trailing_zeros(m) < CONFIG_MP_MAX_NUM_CPUS;
+}
+
+/* With masks enabled we need to be prepared to walk the queue looking
+ * for a thread we can run.  The walk only goes past threads which are
+ * not allowed on the current CPU, which with per-CPU queues for pinned
+ * threads are those with a mask of several but not all CPUs.
+ */
+#if defined(CONFIG_SCHED_DUMB)
 static ALWAYS_INLINE struct k_thread *_priq_dumb_mask_best(sys_dlist_t *pq)
 {
-	/* With masks enabled we need to be prepared to walk the list
-	 * looking for one we can run
-	 */
 	struct k_thread *thread;
 
 	SYS_DLIST_FOR_EACH_CONTAINER(pq, thread, base.qnode_dlist) {
-		if ((thread->base.cpu_mask & BIT(_current_cpu->id)) != 0) {
+		if (can_run_here(thread)) {
 			return thread;
 		}
 	}
 	return NULL;
 }
+#elif defined(CONFIG_SCHED_SCALABLE)
+static ALWAYS_INLINE struct k_thread *_priq_rb_mask_best(struct _priq_rb *pq)
+{
+	struct k_thread *thread = z_priq_rb_best(pq);
+
+	if (thread == NULL || can_run_here(thread)) {
+		return thread;
+	}
+
+	RB_FOR_EACH_CONTAINER(&pq->tree, thread, base.qnode_rb) {
+		if (can_run_here(thread)) {
+			return thread;
+		}
+	}
+	return NULL;
+}
+#elif defined(CONFIG_SCHED_MULTIQ)
+static ALWAYS_INLINE struct k_thread *_priq_mq_mask_best(struct _priq_mq *pq)
+{
+	struct k_thread *thread;
+	uint32_t bitmask = pq->bitmask;
+
+	while (bitmask != 0) {
+		sys_dlist_t *l = &pq->queues[__builtin_ctz(bitmask)];
+
+		SYS_DLIST_FOR_EACH_CONTAINER(l, thread, base.qnode_dlist) {
+			if (can_run_here(thread)) {
+				return thread;
+			}
+		}
+		bitmask &= bitmask - 1;
+	}
+	return NULL;
+}
 #endif
+#endif /* CONFIG_SCHED_CPU_MASK */
 
 #if defined(CONFIG_SCHED_DUMB) || defined(CONFIG_WAITQ_DUMB)
 static ALWAYS_INLINE void z_priq_dumb_add(sys_dlist_t *pq,
@@ -219,6 +284,15 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 	cpu = m == 0 ? 0 : u32_count_trailing_zeros(m);
 
 	return &_kernel.cpus[cpu].ready_q.runq;
+#elif defined(CONFIG_SCHED_CPU_RUNQ)
+	return &_kernel.cpus[thread->base.home_cpu].ready_q.runq;
+#elif defined(CONFIG_SCHED_CPU_MASK)
+	if (is_pinned(thread)) {
+		int cpu = u32_count_trailing_zeros(thread->base.cpu_mask);
+
+		return &_kernel.cpus[cpu].ready_q.runq;
+	}
+	return &_kernel.ready_q.runq;
 #else
 	ARG_UNUSED(thread);
 	return &_kernel.ready_q.runq;
@@ -227,13 +301,37 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 
 static ALWAYS_INLINE void *curr_cpu_runq(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
-	return &arch_curr_cpu()->ready_q.runq;
+#if defined(CONFIG_SCHED_CPU_MASK) || defined(CONFIG_SCHED_CPU_RUNQ)
+	return &_current_cpu->ready_q.runq;
 #else
 	return &_kernel.ready_q.runq;
 #endif
 }
 
+#ifdef CONFIG_SCHED_CPU_RUNQ
+/* The head of each queue is cached, so that other CPUs don't need to
+ * look into the queue to know whether it holds a thread worth stealing
+ */
+static ALWAYS_INLINE void runq_add(struct k_thread *thread)
+{
+	struct _ready_q *rq = &_kernel.cpus[thread->base.home_cpu].ready_q;
+
+	_priq_run_add(&rq->runq, thread);
+	if (rq->best == NULL || z_sched_prio_cmp(thread, rq->best) > 0) {
+		rq->best = thread;
+	}
+}
+
+static ALWAYS_INLINE void runq_remove(struct k_thread *thread)
+{
+	struct _ready_q *rq = &_kernel.cpus[thread->base.home_cpu].ready_q;
+
+	_priq_run_remove(&rq->runq, thread);
+	if (rq->best == thread) {
+		rq->best = _priq_run_head(&rq->runq);
+	}
+}
+#else
 static ALWAYS_INLINE void runq_add(struct k_thread *thread)
 {
 	_priq_run_add(thread_runq(thread), thread);
@@ -243,10 +341,92 @@ static ALWAYS_INLINE void runq_remove(struct k_thread *thread)
 {
 	_priq_run_remove(thread_runq(thread), thread);
 }
+#endif
+
+#ifdef CONFIG_SCHED_CPU_RUNQ
+/* True if the best thread queued on another CPU is to be stolen
+ * instead of running the best thread of the local queue
+ */
+static ALWAYS_INLINE bool should_steal(struct k_thread *remote,
+				       struct k_thread *local)
+{
+	if (local == NULL) {
+		return true;
+	}
+
+	if (CONFIG_SCHED_CPU_RUNQ_STEAL_TOLERANCE == 0) {
+		return z_sched_prio_cmp(remote, local) > 0;
+	}
+
+	return remote->base.prio + CONFIG_SCHED_CPU_RUNQ_STEAL_TOLERANCE <
+	       local->base.prio;
+}
+
+/* True if a thread queued on another CPU is to be stolen rather than the
+ * best candidate found so far, if any
+ */
+static ALWAYS_INLINE bool is_steal_candidate(struct k_thread *thread,
+					     struct k_thread *local,
+					     struct k_thread *remote)
+{
+	return thread != NULL && should_steal(thread, local) &&
+	       (remote == NULL || z_sched_prio_cmp(thread, remote) > 0);
+}
+#endif
 
 static ALWAYS_INLINE struct k_thread *runq_best(void)
 {
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	struct k_thread *thread = _priq_run_best(curr_cpu_runq());
+	struct k_thread *remote = NULL;
+	unsigned int num_cpus = arch_num_cpus();
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		struct _ready_q *rq = &_kernel.cpus[i].ready_q;
+		struct k_thread *th = rq->best;
+
+		/* No thread of the queue is better than its head */
+		if (i == _current_cpu->id ||
+		    !is_steal_candidate(th, thread, remote)) {
+			continue;
+		}
+
+#ifdef CONFIG_SCHED_CPU_MASK
+		if (!can_run_here(th)) {
+			th = _priq_run_best(&rq->runq);
+			if (!is_steal_candidate(th, thread, remote)) {
+				continue;
+			}
+		}
+#endif
+		remote = th;
+	}
+
+	return (remote != NULL) ? remote : thread;
+#elif defined(CONFIG_SCHED_CPU_MASK) && !defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY)
+	struct k_thread *thread = _priq_run_best(&_kernel.ready_q.runq);
+	struct k_thread *pinned = _priq_run_best(curr_cpu_runq());
+	int32_t cmp;
+
+	if (pinned == NULL) {
+		return thread;
+	}
+	if (thread == NULL) {
+		return pinned;
+	}
+
+	/* The queues don't tell which of two threads of equal priority
+	 * was queued first, only make sure a yielding thread lets the
+	 * other one run.
+	 */
+	cmp = z_sched_prio_cmp(pinned, thread);
+	if (cmp > 0 || (cmp == 0 && thread == _current)) {
+		return pinned;
+	}
+	return thread;
+#else
 	return _priq_run_best(curr_cpu_runq());
+#endif
 }
 
 /* _current is never in the run queue until context switch on
@@ -279,20 +459,34 @@ static ALWAYS_INLINE void dequeue_thread(struct k_thread *thread)
 	}
 }
 
+#if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED)
+BUILD_ASSERT(CONFIG_MP_MAX_NUM_CPUS <= 32, "IPI bitmaps are 32 bits wide");
+
+static void send_ipi(uint32_t cpu_bitmap)
+{
+#ifdef CONFIG_ARCH_HAS_DIRECTED_IPIS
+	arch_sched_directed_ipi(cpu_bitmap);
+#else
+	ARG_UNUSED(cpu_bitmap);
+	arch_sched_ipi();
+#endif
+}
+#endif
+
 static void signal_pending_ipi(void)
 {
-	/* Synchronization note: you might think we need to lock these
-	 * two steps, but an IPI is idempotent.  It's OK if we do it
-	 * twice.  All we require is that if a CPU sees the flag true,
-	 * it is guaranteed to send the IPI, and if a core sets
-	 * pending_ipi, the IPI will be sent the next time through
-	 * this code.
+	/* Synchronization note: the bitmap is taken atomically, so
+	 * that if a CPU sees a bit set, it is guaranteed to send the
+	 * IPI, and if a core sets a bit in pending_ipi, the IPI will be
+	 * sent the next time through this code.  An IPI is idempotent,
+	 * it's OK if a CPU gets one more than needed.
 	 */
 #if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED)
 	if (arch_num_cpus() > 1) {
-		if (_kernel.pending_ipi) {
-			_kernel.pending_ipi = false;
-			arch_sched_ipi();
+		uint32_t cpu_bitmap = (uint32_t)atomic_clear(&_kernel.pending_ipi);
+
+		if (cpu_bitmap != 0U) {
+			send_ipi(cpu_bitmap);
 		}
 	}
 #endif
@@ -398,6 +592,11 @@ static ALWAYS_INLINE struct k_thread *next_up(void)
 		dequeue_thread(thread);
 	}
 
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	/* Stolen threads are queued here from now on */
+	thread->base.home_cpu = _current_cpu->id;
+#endif
+
 	_current_cpu->swap_ok = false;
 	return thread;
 #endif
@@ -412,12 +611,57 @@ static void move_thread_to_end_of_prio_q(struct k_thread *thread)
 	update_cache(thread == _current);
 }
 
-static void flag_ipi(void)
+static void flag_ipi(uint32_t cpu_bitmap)
 {
 #if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED)
 	if (arch_num_cpus() > 1) {
-		_kernel.pending_ipi = true;
+		(void)atomic_or(&_kernel.pending_ipi, (atomic_val_t)cpu_bitmap);
 	}
+#else
+	ARG_UNUSED(cpu_bitmap);
+#endif
+}
+
+/* Bitmap of the CPUs to interrupt so that they can switch to a thread
+ * which was made ready or whose priority changed.  Must be called with
+ * sched_spinlock held.
+ */
+static uint32_t ipi_mask_create(struct k_thread *thread)
+{
+#if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED)
+	if (!IS_ENABLED(CONFIG_IPI_OPTIMIZE)) {
+		return (uint32_t)BIT64_MASK(CONFIG_MP_MAX_NUM_CPUS);
+	}
+
+	uint32_t cpu_bitmap = 0U;
+	unsigned int id = _current_cpu->id;
+	unsigned int num_cpus = arch_num_cpus();
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		struct k_thread *cpu_thread = _kernel.cpus[i].current;
+
+		if ((i == id) || (cpu_thread == NULL)) {
+			continue;
+		}
+
+#ifdef CONFIG_SCHED_CPU_MASK
+		if ((thread->base.cpu_mask & BIT(i)) == 0U) {
+			continue;
+		}
+#endif
+
+		/* Other threads only run once the current one yields */
+		if (z_is_idle_thread_object(cpu_thread) || is_metairq(thread) ||
+		    ((z_sched_prio_cmp(thread, cpu_thread) > 0) &&
+		     is_preempt(cpu_thread))) {
+			cpu_bitmap |= BIT(i);
+		}
+	}
+
+	return cpu_bitmap;
+#else
+	ARG_UNUSED(thread);
+	return 0U;
 #endif
 }
 
@@ -473,11 +717,10 @@ static void slice_timeout(struct _timeout *t)
 	slice_expired[cpu] = true;
 
 	/* We need an IPI if we just handled a timeslice expiration
-	 * for a different CPU.  Ideally this would be able to target
-	 * the specific core, but that's not part of the API yet.
+	 * for a different CPU.
 	 */
 	if (IS_ENABLED(CONFIG_SMP) && cpu != _current_cpu->id) {
-		flag_ipi();
+		flag_ipi(BIT(cpu));
 	}
 }
 
@@ -595,11 +838,12 @@ static void update_cache(int preempt_ok)
 #endif
 }
 
-static bool thread_active_elsewhere(struct k_thread *thread)
+static struct _cpu *thread_active_elsewhere(struct k_thread *thread)
 {
-	/* True if the thread is currently running on another CPU.
-	 * There are more scalable designs to answer this question in
-	 * constant time, but this is fine for now.
+	/* The CPU the thread is currently running on if it is another
+	 * one, NULL otherwise.  There are more scalable designs to
+	 * answer this question in constant time, but this is fine for
+	 * now.
 	 */
 #ifdef CONFIG_SMP
 	int currcpu = _current_cpu->id;
@@ -609,13 +853,35 @@ static bool thread_active_elsewhere(struct k_thread *thread)
 	for (int i = 0; i < num_cpus; i++) {
 		if ((i != currcpu) &&
 		    (_kernel.cpus[i].current == thread)) {
-			return true;
+			return &_kernel.cpus[i];
 		}
 	}
 #endif
 	ARG_UNUSED(thread);
+	return NULL;
+}
+
+#ifdef CONFIG_SMP_ADAPTIVE_SPIN
+bool z_is_thread_running_elsewhere(struct k_thread *thread)
+{
+	return thread_active_elsewhere(thread) != NULL;
+}
+
+bool z_is_cpu_busy_elsewhere(void)
+{
+	int currcpu = _current_cpu->id;
+	unsigned int num_cpus = arch_num_cpus();
+
+	for (int i = 0; i < num_cpus; i++) {
+		if ((i != currcpu) &&
+		    !z_is_idle_thread_object(_kernel.cpus[i].current)) {
+			return true;
+		}
+	}
+
 	return false;
 }
+#endif
 
 static void ready_thread(struct k_thread *thread)
 {
@@ -629,16 +895,19 @@ static void ready_thread(struct k_thread *thread)
 	if (!z_is_thread_queued(thread) && z_is_thread_ready(thread)) {
 		SYS_PORT_TRACING_OBJ_FUNC(k_thread, sched_ready, thread);
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_HISTOGRAM
+		z_sched_usage_ready(thread);
+#endif
 		queue_thread(thread);
 		update_cache(0);
-		flag_ipi();
+		flag_ipi(ipi_mask_create(thread));
 	}
 }
 
 void z_ready_thread(struct k_thread *thread)
 {
 	K_SPINLOCK(&sched_spinlock) {
-		if (!thread_active_elsewhere(thread)) {
+		if (thread_active_elsewhere(thread) == NULL) {
 			ready_thread(thread);
 		}
 	}
@@ -661,6 +930,9 @@ void z_sched_start(struct k_thread *thread)
 	}
 
 	z_mark_thread_as_started(thread);
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	thread->base.home_cpu = _current_cpu->id;
+#endif
 	ready_thread(thread);
 	z_reschedule(&sched_spinlock, key);
 }
@@ -954,7 +1226,17 @@ void z_thread_priority_set(struct k_thread *thread, int prio)
 {
 	bool need_sched = z_set_prio(thread, prio);
 
-	flag_ipi();
+	K_SPINLOCK(&sched_spinlock) {
+		uint32_t cpu_bitmap = ipi_mask_create(thread);
+		struct _cpu *cpu = thread_active_elsewhere(thread);
+
+		/* Its CPU may have to switch to another thread */
+		if (cpu != NULL) {
+			cpu_bitmap |= BIT(cpu->id);
+		}
+
+		flag_ipi(cpu_bitmap);
+	}
 
 	if (need_sched && _current->base.sched_locked == 0U) {
 		z_reschedule_unlocked();
@@ -1308,21 +1590,25 @@ void init_ready_q(struct _ready_q *rq)
 		}
 	};
 #elif defined(CONFIG_SCHED_MULTIQ)
-	for (int i = 0; i < ARRAY_SIZE(_kernel.ready_q.runq.queues); i++) {
+	for (int i = 0; i < ARRAY_SIZE(rq->runq.queues); i++) {
 		sys_dlist_init(&rq->runq.queues[i]);
 	}
 #else
 	sys_dlist_init(&rq->runq);
 #endif
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	rq->best = NULL;
+#endif
 }
 
 void z_sched_init(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK) || defined(CONFIG_SCHED_CPU_RUNQ)
 	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
 		init_ready_q(&_kernel.cpus[i].ready_q);
 	}
-#else
+#endif
+#if !defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) && !defined(CONFIG_SCHED_CPU_RUNQ)
 	init_ready_q(&_kernel.ready_q);
 #endif
 }
@@ -1551,8 +1837,6 @@ void z_impl_k_wakeup(k_tid_t thread)
 	z_mark_thread_as_not_suspended(thread);
 	z_ready_thread(thread);
 
-	flag_ipi();
-
 	if (!arch_is_in_isr()) {
 		z_reschedule_unlocked();
 	}
@@ -1572,6 +1856,10 @@ void z_sched_ipi(void)
 	z_trace_sched_ipi();
 #endif
 
+#ifdef CONFIG_SCHED_IPI_STATS
+	_current_cpu->ipi_count++;
+#endif
+
 #ifdef CONFIG_TIMESLICING
 	if (sliceable(_current)) {
 		z_time_slice();
@@ -1780,9 +2068,9 @@ void z_thread_abort(struct k_thread *thread)
 		end_thread(thread);
 	}
 
-	bool active = thread_active_elsewhere(thread);
+	struct _cpu *cpu = thread_active_elsewhere(thread);
 
-	if (active) {
+	if (cpu != NULL) {
 		/* It's running somewhere else, flag and poke */
 		thread->base.thread_state |= _THREAD_ABORTING;
 
@@ -1790,7 +2078,7 @@ void z_thread_abort(struct k_thread *thread)
 		 * here, not deferred!
 		 */
 #ifdef CONFIG_SCHED_IPI_SUPPORTED
-		arch_sched_ipi();
+		send_ipi(BIT(cpu->id));
 #endif
 	}
 
@@ -1807,7 +2095,7 @@ void z_thread_abort(struct k_thread *thread)
 			key = k_spin_lock(&sched_spinlock);
 			z_sched_switch_spin(thread);
 			k_spin_unlock(&sched_spinlock, key);
-		} else if (active) {
+		} else if (cpu != NULL) {
 			/* Threads can join */
 			add_to_waitq_locked(_current, &thread->join_queue);
 			z_swap(&sched_spinlock, key);
@@ -129,6 +129,39 @@ static inline void z_vrfy_k_sem_give(struct k_sem *sem)
 #include <syscalls/k_sem_give_mrsh.c>
 #endif
 
+#ifdef CONFIG_SMP_ADAPTIVE_SPIN
+/* Spins while nobody waits and other CPUs run threads which may give the
+ * semaphore soon.  Called and returns with the lock held, true if the
+ * semaphore is available.
+ */
+static bool spin_on_sem(struct k_sem *sem, k_spinlock_key_t *key)
+{
+	uint32_t budget = k_us_to_cyc_ceil32(CONFIG_SMP_ADAPTIVE_SPIN_US);
+	uint32_t start = k_cycle_get_32();
+
+	while ((z_waitq_head(&sem->wait_q) == NULL) &&
+	       z_is_cpu_busy_elsewhere()) {
+		k_spin_unlock(&lock, *key);
+
+		do {
+			arch_spin_relax();
+		} while ((*(volatile unsigned int *)&sem->count == 0U) &&
+			 ((k_cycle_get_32() - start) < budget));
+
+		*key = k_spin_lock(&lock);
+
+		if (sem->count > 0U) {
+			return true;
+		}
+		if ((k_cycle_get_32() - start) >= budget) {
+			break;
+		}
+	}
+
+	return false;
+}
+#endif
+
 int z_impl_k_sem_take(struct k_sem *sem, k_timeout_t timeout)
 {
 	int ret = 0;
@@ -153,6 +186,15 @@ int z_impl_k_sem_take(struct k_sem *sem, k_timeout_t timeout)
 		goto out;
 	}
 
+#ifdef CONFIG_SMP_ADAPTIVE_SPIN
+	if (spin_on_sem(sem, &key)) {
+		sem->count--;
+		k_spin_unlock(&lock, key);
+		ret = 0;
+		goto out;
+	}
+#endif
+
 	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_sem, take, sem, timeout);
 
 	ret = z_pend_curr(&lock, key, &sem->wait_q, timeout);
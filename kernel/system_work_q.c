@@ -19,17 +19,43 @@ static K_KERNEL_STACK_DEFINE(sys_work_q_stack,
 
 struct k_work_q k_sys_work_q;
 
+#if defined(CONFIG_SYSTEM_WORKQUEUE_WORKERS) && (CONFIG_SYSTEM_WORKQUEUE_WORKERS > 0)
+static K_KERNEL_STACK_ARRAY_DEFINE(sys_work_q_worker_stacks,
+				   CONFIG_SYSTEM_WORKQUEUE_WORKERS,
+				   CONFIG_SYSTEM_WORKQUEUE_STACK_SIZE);
+
+static struct k_work_q_worker
+	sys_work_q_workers[CONFIG_SYSTEM_WORKQUEUE_WORKERS];
+#endif
+
 static int k_sys_work_q_init(void)
 {
 	struct k_work_queue_config cfg = {
 		.name = "sysworkq",
 		.no_yield = IS_ENABLED(CONFIG_SYSTEM_WORKQUEUE_NO_YIELD),
+#ifdef CONFIG_WORKQUEUE_NOTIFY_DELAY
+		.notify_delay = K_USEC(CONFIG_SYSTEM_WORKQUEUE_NOTIFY_DELAY_US),
+#endif
 	};
 
 	k_work_queue_start(&k_sys_work_q,
 			    sys_work_q_stack,
 			    K_KERNEL_STACK_SIZEOF(sys_work_q_stack),
 			    CONFIG_SYSTEM_WORKQUEUE_PRIORITY, &cfg);
+
+#if defined(CONFIG_SYSTEM_WORKQUEUE_WORKERS) && (CONFIG_SYSTEM_WORKQUEUE_WORKERS > 0)
+	for (int i = 0; i < CONFIG_SYSTEM_WORKQUEUE_WORKERS; i++) {
+		int cpu = IS_ENABLED(CONFIG_SYSTEM_WORKQUEUE_PIN_WORKERS) ?
+			  (i + 1) % arch_num_cpus() : -1;
+
+		(void)k_work_queue_add_worker(&k_sys_work_q,
+					      &sys_work_q_workers[i],
+					      sys_work_q_worker_stacks[i],
+					      K_KERNEL_STACK_SIZEOF(sys_work_q_worker_stacks[0]),
+					      cpu);
+	}
+#endif
+
 	return 0;
 }
 
@@ -859,6 +859,10 @@ void z_init_thread_base(struct _thread_base *thread_base, int priority,
 	thread_base->is_idle = 0;
 #endif
 
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	thread_base->home_cpu = 0;
+#endif
+
 #ifdef CONFIG_TIMESLICE_PER_THREAD
 	thread_base->slice_ticks = 0;
 	thread_base->slice_expired = NULL;
@@ -1169,8 +1173,18 @@ int k_thread_runtime_stats_all_get(k_thread_runtime_stats_t *stats)
 		stats->current_cycles   += tmp_stats.current_cycles;
 		stats->peak_cycles      += tmp_stats.peak_cycles;
 		stats->average_cycles   += tmp_stats.average_cycles;
+#endif
+#ifdef CONFIG_SCHED_THREAD_USAGE_HISTOGRAM
+		for (int j = 0; j < CONFIG_SCHED_USAGE_HISTOGRAM_BUCKETS; j++) {
+			stats->run_histogram[j] += tmp_stats.run_histogram[j];
+			stats->latency_histogram[j] +=
+				tmp_stats.latency_histogram[j];
+		}
 #endif
 		stats->idle_cycles      += tmp_stats.idle_cycles;
+#ifdef CONFIG_SCHED_IPI_STATS
+		stats->ipi_count        += tmp_stats.ipi_count;
+#endif
 	}
 #endif
 
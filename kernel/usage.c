@@ -32,6 +32,23 @@ static uint32_t usage_now(void)
 	return (now == 0) ? 1 : now;
 }
 
+#if defined(CONFIG_SCHED_THREAD_USAGE_HISTOGRAM) || \
+	defined(CONFIG_SCHED_ISR_USAGE_HISTOGRAM)
+static void usage_hist_add(uint32_t *hist, uint64_t cycles)
+{
+	unsigned int bucket = 0;
+
+	/* Bucket n holds values from 2^(n-1) to 2^n - 1 */
+	if (cycles > UINT32_MAX) {
+		bucket = 33;
+	} else if (cycles != 0) {
+		bucket = 32 - __builtin_clz((uint32_t)cycles);
+	}
+
+	hist[MIN(bucket, CONFIG_SCHED_USAGE_HISTOGRAM_BUCKETS - 1)]++;
+}
+#endif
+
 #ifdef CONFIG_SCHED_THREAD_USAGE_ALL
 static void sched_cpu_update_usage(struct _cpu *cpu, uint32_t cycles)
 {
@@ -85,6 +102,23 @@ void z_sched_usage_start(struct k_thread *thread)
 		thread->base.usage.current = 0;
 	}
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_HISTOGRAM
+	if (thread->base.usage.ready != 0) {
+		uint32_t latency = _current_cpu->usage0 - thread->base.usage.ready;
+
+		if (thread->base.usage.track_usage) {
+			usage_hist_add(thread->base.usage.latency_hist, latency);
+#ifdef CONFIG_SCHED_THREAD_USAGE_ALL
+			if (_current_cpu->usage->track_usage) {
+				usage_hist_add(_current_cpu->usage->latency_hist,
+					       latency);
+			}
+#endif
+		}
+		thread->base.usage.ready = 0;
+	}
+#endif
+
 	k_spin_unlock(&usage_lock, key);
 #else
 	/* One write through a volatile pointer doesn't require
@@ -112,12 +146,97 @@ void z_sched_usage_stop(void)
 		}
 
 		sched_cpu_update_usage(cpu, cycles);
+
+#ifdef CONFIG_SCHED_THREAD_USAGE_HISTOGRAM
+		/* The usage window of the thread is over */
+		if (cpu->current->base.usage.track_usage) {
+			uint64_t run = cpu->current->base.usage.current;
+
+			usage_hist_add(cpu->current->base.usage.run_hist, run);
+#ifdef CONFIG_SCHED_THREAD_USAGE_ALL
+			if (cpu->usage->track_usage &&
+			    cpu->current != cpu->idle_thread) {
+				usage_hist_add(cpu->usage->run_hist, run);
+			}
+#endif
+		}
+#endif
 	}
 
 	cpu->usage0 = 0;
 	k_spin_unlock(&usage_lock, k);
 }
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_HISTOGRAM
+void z_sched_usage_ready(struct k_thread *thread)
+{
+	/* Single write, read back under usage_lock once the thread runs */
+	thread->base.usage.ready = usage_now();
+}
+#endif
+
+#ifdef CONFIG_SCHED_ISR_USAGE_HISTOGRAM
+/* Deeper nested interrupts are not measured */
+#define ISR_USAGE_MAX_NESTING 8
+
+static struct {
+	uint32_t start[ISR_USAGE_MAX_NESTING];
+	uint32_t depth;
+} isr_usage[CONFIG_MP_MAX_NUM_CPUS];
+
+static uint32_t isr_hist[CONFIG_NUM_IRQS][CONFIG_SCHED_USAGE_HISTOGRAM_BUCKETS];
+
+void z_sched_usage_isr_start(void)
+{
+	unsigned int key = arch_irq_lock();
+	uint32_t depth = isr_usage[_current_cpu->id].depth++;
+
+	if (depth < ISR_USAGE_MAX_NESTING) {
+		isr_usage[_current_cpu->id].start[depth] = usage_now();
+	}
+
+	arch_irq_unlock(key);
+}
+
+void z_sched_usage_isr_stop(unsigned int irq)
+{
+	unsigned int key = arch_irq_lock();
+	uint32_t now = usage_now();
+	uint32_t depth = --isr_usage[_current_cpu->id].depth;
+
+	/* Time spent in nested handlers is included */
+	if (depth < ISR_USAGE_MAX_NESTING && irq < CONFIG_NUM_IRQS) {
+		usage_hist_add(isr_hist[irq],
+			       now - isr_usage[_current_cpu->id].start[depth]);
+	}
+
+	arch_irq_unlock(key);
+}
+
+int k_isr_usage_histogram_get(unsigned int irq, uint32_t *hist)
+{
+	k_spinlock_key_t key;
+
+	CHECKIF((irq >= CONFIG_NUM_IRQS) || (hist == NULL)) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&usage_lock);
+	memcpy(hist, isr_hist[irq], sizeof(isr_hist[irq]));
+	k_spin_unlock(&usage_lock, key);
+
+	return 0;
+}
+
+void k_isr_usage_histogram_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&usage_lock);
+
+	memset(isr_hist, 0, sizeof(isr_hist));
+	k_spin_unlock(&usage_lock, key);
+}
+#endif
+
 #ifdef CONFIG_SCHED_THREAD_USAGE_ALL
 void z_sched_cpu_usage(uint8_t cpu_id, struct k_thread_runtime_stats *stats)
 {
@@ -161,9 +280,20 @@ void z_sched_cpu_usage(uint8_t cpu_id, struct k_thread_runtime_stats *stats)
 	}
 #endif
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_HISTOGRAM
+	memcpy(stats->run_histogram, cpu->usage->run_hist,
+	       sizeof(stats->run_histogram));
+	memcpy(stats->latency_histogram, cpu->usage->latency_hist,
+	       sizeof(stats->latency_histogram));
+#endif
+
 	stats->idle_cycles =
 		_kernel.cpus[cpu_id].idle_thread->base.usage.total;
 
+#ifdef CONFIG_SCHED_IPI_STATS
+	stats->ipi_count = _kernel.cpus[cpu_id].ipi_count;
+#endif
+
 	stats->execution_cycles = stats->total_cycles + stats->idle_cycles;
 
 	k_spin_unlock(&usage_lock, key);
@@ -217,8 +347,18 @@ void z_sched_thread_usage(struct k_thread *thread,
 	}
 #endif
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_HISTOGRAM
+	memcpy(stats->run_histogram, thread->base.usage.run_hist,
+	       sizeof(stats->run_histogram));
+	memcpy(stats->latency_histogram, thread->base.usage.latency_hist,
+	       sizeof(stats->latency_histogram));
+#endif
+
 #ifdef CONFIG_SCHED_THREAD_USAGE_ALL
 	stats->idle_cycles = 0;
+#endif
+#ifdef CONFIG_SCHED_IPI_STATS
+	stats->ipi_count = 0;
 #endif
 	stats->execution_cycles = thread->base.usage.total;
 
@@ -383,6 +523,10 @@ int z_thread_stats_reset(struct k_obj_core *obj_core)
 	stats->longest = 0ULL;
 	stats->num_windows = (thread->base.usage.track_usage) ?  1U : 0U;
 #endif
+#ifdef CONFIG_SCHED_THREAD_USAGE_HISTOGRAM
+	memset(stats->run_hist, 0, sizeof(stats->run_hist));
+	memset(stats->latency_hist, 0, sizeof(stats->latency_hist));
+#endif
 
 	if (thread != _current_cpu->current) {
 
@@ -131,6 +131,208 @@ static void finalize_cancel_locked(struct k_work *work)
 	}
 }
 
+#ifdef CONFIG_WORKQUEUE_POOL
+/* List of flushers waiting for work items of queues with workers. */
+static sys_slist_t pending_flushes;
+
+static inline bool has_workers(struct k_work_q *queue)
+{
+	return !sys_slist_is_empty(&queue->workers);
+}
+
+/* Account for a run of a work item that completed or was canceled
+ * before it started, releasing the flushers waiting for it.
+ *
+ * Invoked with work lock held.
+ *
+ * @param work the work item whose run is over
+ */
+static void finalize_flush_locked(struct k_work *work)
+{
+	struct z_work_flusher *flusher, *tmp;
+	sys_snode_t *prev = NULL;
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&pending_flushes, flusher, tmp,
+					  work.node) {
+		if ((flusher->target == work) && (--flusher->runs == 0U)) {
+			sys_slist_remove(&pending_flushes, prev,
+					 &flusher->work.node);
+			k_sem_give(&flusher->sem);
+		} else {
+			prev = &flusher->work.node;
+		}
+	}
+}
+
+/* Remove the first work item of a list which is not being run by
+ * another thread of the queue.
+ *
+ * Invoked with work lock held.
+ *
+ * @param list the pending list of a queue thread or worker
+ *
+ * @return the removed work item, or NULL if there is none
+ */
+static struct k_work *take_work_locked(sys_slist_t *list)
+{
+	struct k_work *work;
+	sys_snode_t *prev = NULL;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(list, work, node) {
+		if (!flag_test(&work->flags, K_WORK_RUNNING_BIT)) {
+			sys_slist_remove(list, prev, &work->node);
+			return work;
+		}
+		prev = &work->node;
+	}
+
+	return NULL;
+}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
+/* Get the next work item to be run by a thread of the queue.
+ *
+ * Invoked with work lock held.
+ *
+ * @param queue the queue of the thread
+ * @param own the list of work submitted to the thread
+ *
+ * @return the work item removed from its list, or NULL if there is none
+ */
+static struct k_work *next_work_locked(struct k_work_q *queue,
+				       sys_slist_t *own)
+{
+	struct k_work *work = NULL;
+
+#ifdef CONFIG_WORKQUEUE_POOL
+	if (has_workers(queue)) {
+		struct k_work_q_worker *worker;
+
+		/* Items resubmitted while running stay on their list until
+		 * they complete, everything else can be stolen from the
+		 * other threads.
+		 */
+		work = take_work_locked(own);
+		if ((work == NULL) && (own != &queue->pending)) {
+			work = take_work_locked(&queue->pending);
+		}
+		SYS_SLIST_FOR_EACH_CONTAINER(&queue->workers, worker, node) {
+			if (work != NULL) {
+				break;
+			}
+			if (&worker->pending != own) {
+				work = take_work_locked(&worker->pending);
+			}
+		}
+
+		return work;
+	}
+#endif
+
+	sys_snode_t *node = sys_slist_get(own);
+
+	if (node != NULL) {
+		/* Static code analysis tool can raise a false-positive violation
+		 * in the line below that 'work' is checked for null after being
+		 * dereferenced.
+		 *
+		 * The work is figured out by CONTAINER_OF, as a container
+		 * of type struct k_work that contains the node.
+		 * The only way for it to be NULL is if node would be a member
+		 * of struct k_work object that has been placed at address NULL,
+		 * which should never happen, even line 'if (work != NULL)'
+		 * ensures that.
+		 * This means that if node is not NULL, then work will not be NULL.
+		 */
+		work = CONTAINER_OF(node, struct k_work, node);
+	}
+
+	return work;
+}
+
+/* Test whether a thread animates a work queue.
+ *
+ * Invoked with work lock held.
+ */
+static bool is_queue_thread(struct k_work_q *queue, struct k_thread *thread)
+{
+	if (thread == &queue->thread) {
+		return true;
+	}
+
+#ifdef CONFIG_WORKQUEUE_POOL
+	struct k_work_q_worker *worker;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&queue->workers, worker, node) {
+		if (thread == &worker->thread) {
+			return true;
+		}
+	}
+#endif
+
+	return false;
+}
+
+/* Select the list an item submitted to a work queue is added to.
+ *
+ * Invoked with work lock held.
+ */
+static sys_slist_t *submit_list_locked(struct k_work_q *queue)
+{
+#ifdef CONFIG_WORKQUEUE_POOL
+	struct k_work_q_worker *worker;
+
+	if (!has_workers(queue)) {
+		return &queue->pending;
+	}
+
+	/* Chained submissions stay with the submitting thread */
+	if (!k_is_in_isr()) {
+		if (_current == &queue->thread) {
+			return &queue->pending;
+		}
+		SYS_SLIST_FOR_EACH_CONTAINER(&queue->workers, worker, node) {
+			if (_current == &worker->thread) {
+				return &worker->pending;
+			}
+		}
+	}
+
+	/* Others are spread over all threads */
+	worker = queue->next_worker;
+	if (worker == NULL) {
+		queue->next_worker = SYS_SLIST_PEEK_HEAD_CONTAINER(
+			&queue->workers, worker, node);
+		return &queue->pending;
+	}
+
+	queue->next_worker = SYS_SLIST_PEEK_NEXT_CONTAINER(worker, node);
+	return &worker->pending;
+#else
+	return &queue->pending;
+#endif
+}
+
+/* Test whether work is queued or running on a work queue.
+ *
+ * Invoked with work lock held.
+ */
+static bool queue_is_idle_locked(struct k_work_q *queue)
+{
+	bool idle = !flag_test(&queue->flags, K_WORK_QUEUE_BUSY_BIT) &&
+		    sys_slist_is_empty(&queue->pending);
+
+#ifdef CONFIG_WORKQUEUE_POOL
+	struct k_work_q_worker *worker;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&queue->workers, worker, node) {
+		idle = idle && sys_slist_is_empty(&worker->pending);
+	}
+#endif
+
+	return idle;
+}
+
 void k_work_init(struct k_work *work,
 		  k_work_handler_t handler)
 {
@@ -175,6 +377,21 @@ static void queue_flusher_locked(struct k_work_q *queue,
 	bool in_list = false;
 	struct k_work *wn;
 
+#ifdef CONFIG_WORKQUEUE_POOL
+	/* A flusher queued behind the work item could be run by another
+	 * thread before the item completes, wait for the runs of the item
+	 * submitted so far to complete instead.
+	 */
+	if (has_workers(queue)) {
+		init_flusher(flusher);
+		flusher->target = work;
+		flusher->runs = (flag_test(&work->flags, K_WORK_QUEUED_BIT) ? 1U : 0U)
+			+ (flag_test(&work->flags, K_WORK_RUNNING_BIT) ? 1U : 0U);
+		sys_slist_append(&pending_flushes, &flusher->work.node);
+		return;
+	}
+#endif
+
 	/* Determine whether the work item is still queued. */
 	SYS_SLIST_FOR_EACH_CONTAINER(&queue->pending, wn, node) {
 		if (wn == work) {
@@ -203,6 +420,25 @@ static inline void queue_remove_locked(struct k_work_q *queue,
 				       struct k_work *work)
 {
 	if (flag_test_and_clear(&work->flags, K_WORK_QUEUED_BIT)) {
+#ifdef CONFIG_WORKQUEUE_POOL
+		struct k_work_q_worker *worker;
+
+		if (has_workers(queue)) {
+			if (!sys_slist_find_and_remove(&queue->pending,
+						       &work->node)) {
+				SYS_SLIST_FOR_EACH_CONTAINER(&queue->workers,
+							     worker, node) {
+					if (sys_slist_find_and_remove(
+						    &worker->pending,
+						    &work->node)) {
+						break;
+					}
+				}
+			}
+			finalize_flush_locked(work);
+			return;
+		}
+#endif
 		(void)sys_slist_find_and_remove(&queue->pending, &work->node);
 	}
 }
@@ -229,6 +465,60 @@ static inline bool notify_queue_locked(struct k_work_q *queue)
 	return rv;
 }
 
+#ifdef CONFIG_WORKQUEUE_NOTIFY_DELAY
+/* Timeout handler for delayed queue notifications.
+ *
+ * Invoked by timeout infrastructure.
+ * Takes and releases work lock.
+ */
+static void notify_timeout(struct _timeout *to)
+{
+	struct k_work_q *queue = CONTAINER_OF(to, struct k_work_q,
+					      notify_timeout);
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	(void)z_sched_wake_all(&queue->notifyq, 0, NULL);
+
+	k_spin_unlock(&lock, key);
+}
+#endif
+
+/* Notify a queue that work has been submitted to it.
+ *
+ * Wakes up to @p count idle threads of the queue.  If the queue delays its
+ * notifications, the first submission to an idle queue instead arms a
+ * timeout waking the queue, and later ones ride on it.
+ *
+ * Invoked with work lock held.
+ *
+ * @param queue the queue work was submitted to.  If this is null no
+ * notification is required.
+ * @param count number of work items submitted.
+ */
+static void notify_submit_locked(struct k_work_q *queue, unsigned int count)
+{
+	if (queue == NULL) {
+		return;
+	}
+
+#ifdef CONFIG_WORKQUEUE_NOTIFY_DELAY
+	if (!K_TIMEOUT_EQ(queue->notify_delay, K_NO_WAIT)) {
+		if ((z_waitq_head(&queue->notifyq) != NULL) &&
+		    z_is_inactive_timeout(&queue->notify_timeout)) {
+			z_add_timeout(&queue->notify_timeout, notify_timeout,
+				      queue->notify_delay);
+		}
+		return;
+	}
+#endif
+
+	for (unsigned int i = 0; i < count; i++) {
+		if (!notify_queue_locked(queue)) {
+			break;
+		}
+	}
+}
+
 /* Submit an work item to a queue if queue state allows new work.
  *
  * Submission is rejected if no queue is provided, or if the queue is
@@ -236,7 +526,7 @@ static inline bool notify_queue_locked(struct k_work_q *queue)
  * thread (chained submission).
  *
  * Invoked with work lock held.
- * Conditionally notifies queue.
+ * Does not notify the queue.
  *
  * @param queue the queue to which work should be submitted.  This may
  * be null, in which case the submission will fail.
@@ -256,7 +546,7 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 	}
 
 	int ret = -EBUSY;
-	bool chained = (_current == &queue->thread) && !k_is_in_isr();
+	bool chained = is_queue_thread(queue, _current) && !k_is_in_isr();
 	bool draining = flag_test(&queue->flags, K_WORK_QUEUE_DRAIN_BIT);
 	bool plugged = flag_test(&queue->flags, K_WORK_QUEUE_PLUGGED_BIT);
 
@@ -274,15 +564,14 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 	} else if (plugged && !draining) {
 		ret = -EBUSY;
 	} else {
-		sys_slist_append(&queue->pending, &work->node);
+		sys_slist_append(submit_list_locked(queue), &work->node);
 		ret = 1;
-		(void)notify_queue_locked(queue);
 	}
 
 	return ret;
 }
 
-/* Attempt to submit work to a queue.
+/* Attempt to queue work to a queue.
  *
  * The submission can fail if:
  * * the work is cancelling,
@@ -290,7 +579,7 @@ static inline int queue_submit_locked(struct k_work_q *queue,
  * * the candidate queue rejects the submission.
  *
  * Invoked with work lock held.
- * Conditionally notifies queue.
+ * Does not notify the queue, see submit_to_queue_locked().
  *
  * @param work the work structure to be submitted
 
@@ -308,8 +597,8 @@ static inline int queue_submit_locked(struct k_work_q *queue,
  * @retval -EINVAL if no queue is provided
  * @retval -ENODEV if the queue is not started
  */
-static int submit_to_queue_locked(struct k_work *work,
-				  struct k_work_q **queuep)
+static int queue_work_locked(struct k_work *work,
+			     struct k_work_q **queuep)
 {
 	int ret = 0;
 
@@ -355,6 +644,28 @@ static int submit_to_queue_locked(struct k_work *work,
 	return ret;
 }
 
+/* Attempt to submit work to a queue.
+ *
+ * Invoked with work lock held.
+ * Conditionally notifies queue.
+ *
+ * @param work the work structure to be submitted
+ * @param queuep pointer to a queue reference, see queue_work_locked().
+ *
+ * @retval see queue_work_locked()
+ */
+static int submit_to_queue_locked(struct k_work *work,
+				  struct k_work_q **queuep)
+{
+	int ret = queue_work_locked(work, queuep);
+
+	if (ret > 0) {
+		notify_submit_locked(*queuep, 1U);
+	}
+
+	return ret;
+}
+
 /* Submit work to a queue but do not yield the current thread.
  *
  * Intended for internal use.
@@ -413,6 +724,55 @@ int k_work_submit(struct k_work *work)
 	return ret;
 }
 
+int k_work_submit_batch_to_queue(struct k_work_q *queue,
+				 struct k_work **works, size_t count)
+{
+	__ASSERT_NO_MSG((works != NULL) || (count == 0U));
+
+	struct k_work_q *notify = NULL;
+	unsigned int notify_cnt = 0U;
+	int queued = 0;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	/* Queue everything first, then notify each queue once for the
+	 * consecutive items which went to it.  Items may go to another
+	 * queue than @p queue if they are running there.
+	 */
+	for (size_t i = 0; i < count; i++) {
+		struct k_work_q *wq = queue;
+
+		__ASSERT_NO_MSG(works[i] != NULL);
+		__ASSERT_NO_MSG(works[i]->handler != NULL);
+
+		if (queue_work_locked(works[i], &wq) <= 0) {
+			continue;
+		}
+
+		queued++;
+		if (wq != notify) {
+			notify_submit_locked(notify, notify_cnt);
+			notify = wq;
+			notify_cnt = 0U;
+		}
+		notify_cnt++;
+	}
+
+	notify_submit_locked(notify, notify_cnt);
+
+	k_spin_unlock(&lock, key);
+
+	if (queued > 0) {
+		z_reschedule_unlocked();
+	}
+
+	return queued;
+}
+
+int k_work_submit_batch(struct k_work **works, size_t count)
+{
+	return k_work_submit_batch_to_queue(&k_sys_work_q, works, count);
+}
+
 /* Flush the work item if necessary.
  *
  * Flushing is necessary only if the work is either queued or running.
@@ -596,46 +956,36 @@ bool k_work_cancel_sync(struct k_work *work,
 /* Loop executed by a work queue thread.
  *
  * @param workq_ptr pointer to the work queue structure
+ * @param pending_ptr pointer to the list of work submitted to the thread
  */
-static void work_queue_main(void *workq_ptr, void *p2, void *p3)
+static void work_queue_main(void *workq_ptr, void *pending_ptr, void *p3)
 {
-	ARG_UNUSED(p2);
 	ARG_UNUSED(p3);
 
 	struct k_work_q *queue = (struct k_work_q *)workq_ptr;
+	sys_slist_t *pending = (sys_slist_t *)pending_ptr;
 
 	while (true) {
-		sys_snode_t *node;
-		struct k_work *work = NULL;
+		struct k_work *work;
 		k_work_handler_t handler = NULL;
 		k_spinlock_key_t key = k_spin_lock(&lock);
 		bool yield;
 
 		/* Check for and prepare any new work. */
-		node = sys_slist_get(&queue->pending);
-		if (node != NULL) {
+		work = next_work_locked(queue, pending);
+		if (work != NULL) {
 			/* Mark that there's some work active that's
 			 * not on the pending list.
 			 */
 			flag_set(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
-			work = CONTAINER_OF(node, struct k_work, node);
+#ifdef CONFIG_WORKQUEUE_POOL
+			queue->num_busy++;
+#endif
 			flag_set(&work->flags, K_WORK_RUNNING_BIT);
 			flag_clear(&work->flags, K_WORK_QUEUED_BIT);
-
-			/* Static code analysis tool can raise a false-positive violation
-			 * in the line below that 'work' is checked for null after being
-			 * dereferenced.
-			 *
-			 * The work is figured out by CONTAINER_OF, as a container
-			 * of type struct k_work that contains the node.
-			 * The only way for it to be NULL is if node would be a member
-			 * of struct k_work object that has been placed at address NULL,
-			 * which should never happen, even line 'if (work != NULL)'
-			 * ensures that.
-			 * This means that if node is not NULL, then work will not be NULL.
-			 */
 			handler = work->handler;
-		} else if (flag_test_and_clear(&queue->flags,
+		} else if (!flag_test(&queue->flags, K_WORK_QUEUE_BUSY_BIT) &&
+			   flag_test_and_clear(&queue->flags,
 					       K_WORK_QUEUE_DRAIN_BIT)) {
 			/* Not busy and draining: move threads waiting for
 			 * drain to ready state.  The held spinlock inhibits
@@ -683,7 +1033,16 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			finalize_cancel_locked(work);
 		}
 
+#ifdef CONFIG_WORKQUEUE_POOL
+		if (has_workers(queue)) {
+			finalize_flush_locked(work);
+		}
+		if (--queue->num_busy == 0U) {
+			flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+		}
+#else
 		flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+#endif
 		yield = !flag_test(&queue->flags, K_WORK_QUEUE_NO_YIELD_BIT);
 		k_spin_unlock(&lock, key);
 
@@ -728,6 +1087,11 @@ void k_work_queue_start(struct k_work_q *queue,
 		flags |= K_WORK_QUEUE_NO_YIELD;
 	}
 
+#ifdef CONFIG_WORKQUEUE_NOTIFY_DELAY
+	z_init_timeout(&queue->notify_timeout);
+	queue->notify_delay = (cfg != NULL) ? cfg->notify_delay : K_NO_WAIT;
+#endif
+
 	/* It hasn't actually been started yet, but all the state is in place
 	 * so we can submit things and once the thread gets control it's ready
 	 * to roll.
@@ -735,7 +1099,7 @@ void k_work_queue_start(struct k_work_q *queue,
 	flags_set(&queue->flags, flags);
 
 	(void)k_thread_create(&queue->thread, stack, stack_size,
-			      work_queue_main, queue, NULL, NULL,
+			      work_queue_main, queue, &queue->pending, NULL,
 			      prio, 0, K_FOREVER);
 
 	if ((cfg != NULL) && (cfg->name != NULL)) {
@@ -747,6 +1111,50 @@ void k_work_queue_start(struct k_work_q *queue,
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, start, queue);
 }
 
+#ifdef CONFIG_WORKQUEUE_POOL
+int k_work_queue_add_worker(struct k_work_q *queue,
+			    struct k_work_q_worker *worker,
+			    k_thread_stack_t *stack, size_t stack_size,
+			    int cpu)
+{
+	__ASSERT_NO_MSG(queue);
+	__ASSERT_NO_MSG(worker);
+	__ASSERT_NO_MSG(stack);
+
+	if (!flag_test(&queue->flags, K_WORK_QUEUE_STARTED_BIT)) {
+		return -ENODEV;
+	}
+
+	if ((cpu >= 0) && !IS_ENABLED(CONFIG_SCHED_CPU_MASK)) {
+		return -ENOTSUP;
+	}
+
+	sys_slist_init(&worker->pending);
+	worker->queue = queue;
+
+	(void)k_thread_create(&worker->thread, stack, stack_size,
+			      work_queue_main, queue, &worker->pending, NULL,
+			      k_thread_priority_get(&queue->thread), 0,
+			      K_FOREVER);
+
+#ifdef CONFIG_SCHED_CPU_MASK
+	if (cpu >= 0) {
+		(void)k_thread_cpu_pin(&worker->thread, cpu);
+	}
+#endif
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	sys_slist_append(&queue->workers, &worker->node);
+
+	k_spin_unlock(&lock, key);
+
+	k_thread_start(&worker->thread);
+
+	return 0;
+}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
 int k_work_queue_drain(struct k_work_q *queue,
 		       bool plug)
 {
@@ -758,10 +1166,9 @@ int k_work_queue_drain(struct k_work_q *queue,
 	int ret = 0;
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
-	if (((flags_get(&queue->flags)
-	      & (K_WORK_QUEUE_BUSY | K_WORK_QUEUE_DRAIN)) != 0U)
-	    || plug
-	    || !sys_slist_is_empty(&queue->pending)) {
+	if (!queue_is_idle_locked(queue)
+	    || flag_test(&queue->flags, K_WORK_QUEUE_DRAIN_BIT)
+	    || plug) {
 		flag_set(&queue->flags, K_WORK_QUEUE_DRAIN_BIT);
 		if (plug) {
 			flag_set(&queue->flags, K_WORK_QUEUE_PLUGGED_BIT);
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <zephyr/sys/mpsc_pbuf.h>
+#include <zephyr/sys/barrier.h>
 
 #define MPSC_PBUF_DEBUG 0
 
@@ -20,11 +21,32 @@ static inline void mpsc_state_print(struct mpsc_pbuf_buffer *buffer)
 {
 	if (MPSC_PBUF_DEBUG) {
 		printk(", wr:%d/%d, rd:%d/%d\n",
-			buffer->wr_idx, buffer->tmp_wr_idx,
+			(int)atomic_get(&buffer->wr_idx),
+			(int)atomic_get(&buffer->tmp_wr_idx),
 			buffer->rd_idx, buffer->tmp_rd_idx);
 	}
 }
 
+/* Producers reserve space without the lock unless oldest packets are
+ * overwritten, since dropping a packet moves the read index from the producer
+ * side.
+ */
+static inline bool is_lock_free(struct mpsc_pbuf_buffer *buffer)
+{
+	return !(buffer->flags & MPSC_PBUF_MODE_OVERWRITE);
+}
+
+/* Free space of a lock-free buffer is kept zeroed, so that space reserved by
+ * a producer which has not written the packet header yet reads as invalid.
+ */
+static inline void clear_space(struct mpsc_pbuf_buffer *buffer,
+			       union mpsc_pbuf_generic *item, uint32_t wlen)
+{
+	if (is_lock_free(buffer)) {
+		memset(item, 0, wlen * sizeof(uint32_t));
+	}
+}
+
 void mpsc_pbuf_init(struct mpsc_pbuf_buffer *buffer,
 		    const struct mpsc_pbuf_buffer_config *cfg)
 {
@@ -42,6 +64,10 @@ void mpsc_pbuf_init(struct mpsc_pbuf_buffer *buffer,
 		buffer->flags |= MPSC_PBUF_SIZE_POW2;
 	}
 
+	if (is_lock_free(buffer)) {
+		memset(buffer->buf, 0, buffer->size * sizeof(uint32_t));
+	}
+
 	err = k_sem_init(&buffer->sem, 0, 1);
 	__ASSERT_NO_MSG(err == 0);
 	ARG_UNUSED(err);
@@ -50,24 +76,26 @@ void mpsc_pbuf_init(struct mpsc_pbuf_buffer *buffer,
 /* Calculate free space available or till end of buffer.
  *
  * @param buffer Buffer.
+ * @param idx Temporary write index.
  * @param[out] res Destination where free space is written.
  *
  * @retval true when space was calculated until end of buffer (and there might
  * be more space available after wrapping.
  * @retval false When result is total free space.
  */
-static inline bool free_space(struct mpsc_pbuf_buffer *buffer, uint32_t *res)
+static inline bool free_space(struct mpsc_pbuf_buffer *buffer, uint32_t idx,
+			      uint32_t *res)
 {
 	if (buffer->flags & MPSC_PBUF_FULL) {
 		*res = 0;
 		return false;
 	}
 
-	if (buffer->rd_idx > buffer->tmp_wr_idx) {
-		*res =  buffer->rd_idx - buffer->tmp_wr_idx;
+	if (buffer->rd_idx > idx) {
+		*res =  buffer->rd_idx - idx;
 		return false;
 	}
-	*res = buffer->size - buffer->tmp_wr_idx;
+	*res = buffer->size - idx;
 
 	return true;
 }
@@ -83,12 +111,14 @@ static inline bool free_space(struct mpsc_pbuf_buffer *buffer, uint32_t *res)
  */
 static inline bool available(struct mpsc_pbuf_buffer *buffer, uint32_t *res)
 {
-	if (buffer->flags & MPSC_PBUF_FULL || buffer->tmp_rd_idx > buffer->wr_idx) {
+	uint32_t wr_idx = atomic_get(&buffer->wr_idx);
+
+	if (buffer->flags & MPSC_PBUF_FULL || buffer->tmp_rd_idx > wr_idx) {
 		*res = buffer->size - buffer->tmp_rd_idx;
 		return true;
 	}
 
-	*res = (buffer->wr_idx - buffer->tmp_rd_idx);
+	*res = (wr_idx - buffer->tmp_rd_idx);
 
 	return false;
 }
@@ -97,7 +127,7 @@ static inline uint32_t get_usage(struct mpsc_pbuf_buffer *buffer)
 {
 	uint32_t f;
 
-	if (free_space(buffer, &f)) {
+	if (free_space(buffer, atomic_get(&buffer->tmp_wr_idx), &f)) {
 		f += (buffer->rd_idx - 1);
 	}
 
@@ -145,29 +175,68 @@ static inline uint32_t get_skip(union mpsc_pbuf_generic *item)
 }
 
 
-static ALWAYS_INLINE void tmp_wr_idx_inc(struct mpsc_pbuf_buffer *buffer, int32_t wlen)
+/* Move temporary write index from the index for which the free space was
+ * calculated. Fails if a lock-free producer allocated in the meantime.
+ */
+static ALWAYS_INLINE bool tmp_wr_idx_inc(struct mpsc_pbuf_buffer *buffer,
+					 uint32_t idx, int32_t wlen)
 {
-	buffer->tmp_wr_idx = idx_inc(buffer, buffer->tmp_wr_idx, wlen);
-	if (buffer->tmp_wr_idx == buffer->rd_idx) {
+	uint32_t new_idx = idx_inc(buffer, idx, wlen);
+	bool full = (new_idx == buffer->rd_idx);
+
+	/* Flag is set first, so that lock-free producers which see the new
+	 * index also see that buffer is full.
+	 */
+	if (full) {
 		buffer->flags |= MPSC_PBUF_FULL;
 	}
+
+	if (!atomic_cas(&buffer->tmp_wr_idx, idx, new_idx)) {
+		if (full) {
+			buffer->flags &= ~MPSC_PBUF_FULL;
+		}
+		return false;
+	}
+
+	return true;
+}
+
+static ALWAYS_INLINE void wr_idx_inc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
+{
+	atomic_val_t idx;
+
+	do {
+		idx = atomic_get(&buffer->wr_idx);
+	} while (!atomic_cas(&buffer->wr_idx, idx, idx_inc(buffer, idx, wlen)));
 }
 
 static void rd_idx_inc(struct mpsc_pbuf_buffer *buffer, int32_t wlen)
 {
+	/* Lock-free producers read the index after the full flag, so the
+	 * index and the cleared space must be visible before the flag is
+	 * cleared.
+	 */
+	barrier_dmem_fence_full();
 	buffer->rd_idx = idx_inc(buffer, buffer->rd_idx, wlen);
+	barrier_dmem_fence_full();
 	buffer->flags &= ~MPSC_PBUF_FULL;
 }
 
-static void add_skip_item(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
+static bool add_skip_item(struct mpsc_pbuf_buffer *buffer, uint32_t idx,
+			  uint32_t wlen)
 {
 	union mpsc_pbuf_generic skip = {
 		.skip = { .valid = 0, .busy = 1, .len = wlen }
 	};
 
-	buffer->buf[buffer->tmp_wr_idx] = skip.raw;
-	tmp_wr_idx_inc(buffer, wlen);
-	buffer->wr_idx = idx_inc(buffer, buffer->wr_idx, wlen);
+	if (!tmp_wr_idx_inc(buffer, idx, wlen)) {
+		return false;
+	}
+
+	buffer->buf[idx] = skip.raw;
+	wr_idx_inc(buffer, wlen);
+
+	return true;
 }
 
 static bool drop_item_locked(struct mpsc_pbuf_buffer *buffer,
@@ -187,6 +256,8 @@ static bool drop_item_locked(struct mpsc_pbuf_buffer *buffer,
 		/* Skip packet found, can be dropped to free some space */
 		MPSC_PBUF_DBG(buffer, "no space: Found skip packet %d len", skip_wlen);
 
+		/* Only the header of a skip packet is written. */
+		clear_space(buffer, item, 1);
 		rd_idx_inc(buffer, skip_wlen);
 		buffer->tmp_rd_idx = buffer->rd_idx;
 		return true;
@@ -206,11 +277,12 @@ static bool drop_item_locked(struct mpsc_pbuf_buffer *buffer,
 		MPSC_PBUF_DBG(buffer, "no space: Found busy packet %p (len:%d)", item, rd_wlen);
 		/* Add skip packet before claimed packet. */
 		if (free_wlen) {
-			add_skip_item(buffer, free_wlen);
+			(void)add_skip_item(buffer, atomic_get(&buffer->tmp_wr_idx),
+					    free_wlen);
 			MPSC_PBUF_DBG(buffer, "no space: Added skip packet (len:%d)", free_wlen);
 		}
 		/* Move all indexes forward, after claimed packet. */
-		buffer->wr_idx = idx_inc(buffer, buffer->wr_idx, rd_wlen);
+		wr_idx_inc(buffer, rd_wlen);
 
 		/* If allocation wrapped around the buffer and found busy packet
 		 * that was already ommited, skip it again.
@@ -219,7 +291,7 @@ static bool drop_item_locked(struct mpsc_pbuf_buffer *buffer,
 			buffer->tmp_rd_idx = idx_inc(buffer, buffer->tmp_rd_idx, rd_wlen);
 		}
 
-		buffer->tmp_wr_idx = buffer->tmp_rd_idx;
+		atomic_set(&buffer->tmp_wr_idx, buffer->tmp_rd_idx);
 		buffer->rd_idx = buffer->tmp_rd_idx;
 		buffer->flags |= MPSC_PBUF_FULL;
 	} else {
@@ -241,11 +313,13 @@ static bool drop_item_locked(struct mpsc_pbuf_buffer *buffer,
 				}
 			};
 
-			buffer->buf[buffer->tmp_wr_idx] = invalid.raw;
+			buffer->buf[atomic_get(&buffer->tmp_wr_idx)] = invalid.raw;
 		}
 
 		*tmp_wr_idx_shift = rd_wlen + free_wlen;
-		buffer->tmp_wr_idx = idx_inc(buffer, buffer->tmp_wr_idx, *tmp_wr_idx_shift);
+		atomic_set(&buffer->tmp_wr_idx,
+			   idx_inc(buffer, atomic_get(&buffer->tmp_wr_idx),
+				   *tmp_wr_idx_shift));
 		buffer->flags |= MPSC_PBUF_FULL;
 		item->hdr.valid = 0;
 		*item_to_drop = item;
@@ -262,9 +336,9 @@ static void post_drop_action(struct mpsc_pbuf_buffer *buffer,
 {
 	uint32_t cmp_tmp_wr_idx = idx_inc(buffer, prev_tmp_wr_idx, tmp_wr_idx_shift);
 
-	if (cmp_tmp_wr_idx == buffer->tmp_wr_idx) {
+	if (cmp_tmp_wr_idx == atomic_get(&buffer->tmp_wr_idx)) {
 		/* Operation not interrupted by another alloc. */
-		buffer->tmp_wr_idx = prev_tmp_wr_idx;
+		atomic_set(&buffer->tmp_wr_idx, prev_tmp_wr_idx);
 		buffer->flags &= ~MPSC_PBUF_FULL;
 		return;
 	}
@@ -279,9 +353,7 @@ static void post_drop_action(struct mpsc_pbuf_buffer *buffer,
 	};
 
 	buffer->buf[prev_tmp_wr_idx] = skip.raw;
-	buffer->wr_idx = idx_inc(buffer,
-				 buffer->wr_idx,
-				 tmp_wr_idx_shift);
+	wr_idx_inc(buffer, tmp_wr_idx_shift);
 	/* full flag? */
 }
 
@@ -296,6 +368,8 @@ void mpsc_pbuf_put_word(struct mpsc_pbuf_buffer *buffer,
 	uint32_t tmp_wr_idx_val = 0;
 
 	do {
+		uint32_t idx;
+
 		key = k_spin_lock(&buffer->lock);
 
 		if (tmp_wr_idx_shift) {
@@ -303,18 +377,20 @@ void mpsc_pbuf_put_word(struct mpsc_pbuf_buffer *buffer,
 			tmp_wr_idx_shift = 0;
 		}
 
-		(void)free_space(buffer, &free_wlen);
+		idx = atomic_get(&buffer->tmp_wr_idx);
+		(void)free_space(buffer, idx, &free_wlen);
 
 		MPSC_PBUF_DBG(buffer, "put_word (%d free space)", (int)free_wlen);
 
 		if (free_wlen) {
-			buffer->buf[buffer->tmp_wr_idx] = item.raw;
-			tmp_wr_idx_inc(buffer, 1);
-			cont = false;
-			buffer->wr_idx = idx_inc(buffer, buffer->wr_idx, 1);
-			max_utilization_update(buffer);
+			cont = !tmp_wr_idx_inc(buffer, idx, 1);
+			if (!cont) {
+				buffer->buf[idx] = item.raw;
+				wr_idx_inc(buffer, 1);
+				max_utilization_update(buffer);
+			}
 		} else {
-			tmp_wr_idx_val = buffer->tmp_wr_idx;
+			tmp_wr_idx_val = idx;
 			cont = drop_item_locked(buffer, free_wlen,
 						&dropped_item, &tmp_wr_idx_shift);
 		}
@@ -331,6 +407,40 @@ void mpsc_pbuf_put_word(struct mpsc_pbuf_buffer *buffer,
 	} while (cont);
 }
 
+/* Reserve space without taking the lock. Reservation never fills up the
+ * buffer, since equal read and write indexes are told apart by the full flag,
+ * which is set only with the lock held. Remaining cases are handled by the
+ * locked path.
+ */
+static union mpsc_pbuf_generic *alloc_lock_free(struct mpsc_pbuf_buffer *buffer,
+						size_t wlen)
+{
+	union mpsc_pbuf_generic *item;
+	uint32_t idx = atomic_get(&buffer->tmp_wr_idx);
+	uint32_t rd_idx;
+	uint32_t free_wlen;
+
+	if (buffer->flags & MPSC_PBUF_FULL) {
+		return NULL;
+	}
+
+	/* Read index is read after the flag, see rd_idx_inc(). */
+	barrier_dmem_fence_full();
+	rd_idx = buffer->rd_idx;
+	free_wlen = (rd_idx > idx) ? (rd_idx - idx) : (buffer->size - idx);
+
+	if ((free_wlen <= wlen) ||
+	    !atomic_cas(&buffer->tmp_wr_idx, idx, idx + wlen)) {
+		return NULL;
+	}
+
+	item = (union mpsc_pbuf_generic *)&buffer->buf[idx];
+	item->hdr.valid = 0;
+	item->hdr.busy = 0;
+
+	return item;
+}
+
 union mpsc_pbuf_generic *mpsc_pbuf_alloc(struct mpsc_pbuf_buffer *buffer,
 					 size_t wlen, k_timeout_t timeout)
 {
@@ -348,8 +458,14 @@ union mpsc_pbuf_generic *mpsc_pbuf_alloc(struct mpsc_pbuf_buffer *buffer,
 		return NULL;
 	}
 
-	do {
+	if (is_lock_free(buffer)) {
+		item = alloc_lock_free(buffer, wlen);
+		cont = (item == NULL);
+	}
+
+	while (cont) {
 		k_spinlock_key_t key;
+		uint32_t idx;
 		bool wrap;
 
 		key = k_spin_lock(&buffer->lock);
@@ -358,17 +474,18 @@ union mpsc_pbuf_generic *mpsc_pbuf_alloc(struct mpsc_pbuf_buffer *buffer,
 			tmp_wr_idx_shift = 0;
 		}
 
-		wrap = free_space(buffer, &free_wlen);
+		idx = atomic_get(&buffer->tmp_wr_idx);
+		wrap = free_space(buffer, idx, &free_wlen);
 
 		if (free_wlen >= wlen) {
-			item =
-			    (union mpsc_pbuf_generic *)&buffer->buf[buffer->tmp_wr_idx];
-			item->hdr.valid = 0;
-			item->hdr.busy = 0;
-			tmp_wr_idx_inc(buffer, wlen);
-			cont = false;
+			if (tmp_wr_idx_inc(buffer, idx, wlen)) {
+				item = (union mpsc_pbuf_generic *)&buffer->buf[idx];
+				item->hdr.valid = 0;
+				item->hdr.busy = 0;
+				cont = false;
+			}
 		} else if (wrap) {
-			add_skip_item(buffer, free_wlen);
+			(void)add_skip_item(buffer, idx, free_wlen);
 			cont = true;
 		} else if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT) && !k_is_in_isr()) {
 			int err;
@@ -378,7 +495,7 @@ union mpsc_pbuf_generic *mpsc_pbuf_alloc(struct mpsc_pbuf_buffer *buffer,
 			key = k_spin_lock(&buffer->lock);
 			cont = (err == 0) ? true : false;
 		} else if (cont) {
-			tmp_wr_idx_val = buffer->tmp_wr_idx;
+			tmp_wr_idx_val = idx;
 			cont = drop_item_locked(buffer, free_wlen,
 						&dropped_item, &tmp_wr_idx_shift);
 		}
@@ -391,8 +508,7 @@ union mpsc_pbuf_generic *mpsc_pbuf_alloc(struct mpsc_pbuf_buffer *buffer,
 			}
 			dropped_item = NULL;
 		}
-	} while (cont);
-
+	}
 
 	MPSC_PBUF_DBG(buffer, "allocated %p", item);
 
@@ -408,11 +524,23 @@ void mpsc_pbuf_commit(struct mpsc_pbuf_buffer *buffer,
 		       union mpsc_pbuf_generic *item)
 {
 	uint32_t wlen = buffer->get_wlen(item);
+	k_spinlock_key_t key;
 
-	k_spinlock_key_t key = k_spin_lock(&buffer->lock);
+	if (is_lock_free(buffer) &&
+	    !(buffer->flags & MPSC_PBUF_MAX_UTILIZATION)) {
+		/* Without the lock, the data must be visible before the header
+		 * marks it valid. Pairs with the fence in mpsc_pbuf_claim().
+		 */
+		barrier_dmem_fence_full();
+		item->hdr.valid = 1;
+		wr_idx_inc(buffer, wlen);
+		MPSC_PBUF_DBG(buffer, "committed %p", item);
+		return;
+	}
 
+	key = k_spin_lock(&buffer->lock);
 	item->hdr.valid = 1;
-	buffer->wr_idx = idx_inc(buffer, buffer->wr_idx, wlen);
+	wr_idx_inc(buffer, wlen);
 	max_utilization_update(buffer);
 	k_spin_unlock(&buffer->lock, key);
 	MPSC_PBUF_DBG(buffer, "committed %p", item);
@@ -432,6 +560,7 @@ void mpsc_pbuf_put_word_ext(struct mpsc_pbuf_buffer *buffer,
 	do {
 		k_spinlock_key_t key;
 		uint32_t free_wlen;
+		uint32_t idx;
 		bool wrap;
 
 		key = k_spin_lock(&buffer->lock);
@@ -441,23 +570,24 @@ void mpsc_pbuf_put_word_ext(struct mpsc_pbuf_buffer *buffer,
 			tmp_wr_idx_shift = 0;
 		}
 
-		wrap = free_space(buffer, &free_wlen);
+		idx = atomic_get(&buffer->tmp_wr_idx);
+		wrap = free_space(buffer, idx, &free_wlen);
 
 		if (free_wlen >= l) {
-			buffer->buf[buffer->tmp_wr_idx] = item.raw;
-			void **p =
-				(void **)&buffer->buf[buffer->tmp_wr_idx + 1];
-
-			*p = (void *)data;
-			tmp_wr_idx_inc(buffer, l);
-			buffer->wr_idx = idx_inc(buffer, buffer->wr_idx, l);
-			cont = false;
-			max_utilization_update(buffer);
+			cont = !tmp_wr_idx_inc(buffer, idx, l);
+			if (!cont) {
+				buffer->buf[idx] = item.raw;
+				void **p = (void **)&buffer->buf[idx + 1];
+
+				*p = (void *)data;
+				wr_idx_inc(buffer, l);
+				max_utilization_update(buffer);
+			}
 		} else if (wrap) {
-			add_skip_item(buffer, free_wlen);
+			(void)add_skip_item(buffer, idx, free_wlen);
 			cont = true;
 		} else {
-			tmp_wr_idx_val = buffer->tmp_wr_idx;
+			tmp_wr_idx_val = idx;
 			cont = drop_item_locked(buffer, free_wlen,
 						 &dropped_item, &tmp_wr_idx_shift);
 		}
@@ -485,6 +615,7 @@ void mpsc_pbuf_put_data(struct mpsc_pbuf_buffer *buffer, const uint32_t *data,
 	do {
 		uint32_t free_wlen;
 		k_spinlock_key_t key;
+		uint32_t idx;
 		bool wrap;
 
 		key = k_spin_lock(&buffer->lock);
@@ -494,20 +625,22 @@ void mpsc_pbuf_put_data(struct mpsc_pbuf_buffer *buffer, const uint32_t *data,
 			tmp_wr_idx_shift = 0;
 		}
 
-		wrap = free_space(buffer, &free_wlen);
+		idx = atomic_get(&buffer->tmp_wr_idx);
+		wrap = free_space(buffer, idx, &free_wlen);
 
 		if (free_wlen >= wlen) {
-			memcpy(&buffer->buf[buffer->tmp_wr_idx], data,
-				wlen * sizeof(uint32_t));
-			buffer->wr_idx = idx_inc(buffer, buffer->wr_idx, wlen);
-			tmp_wr_idx_inc(buffer, wlen);
-			cont = false;
-			max_utilization_update(buffer);
+			cont = !tmp_wr_idx_inc(buffer, idx, wlen);
+			if (!cont) {
+				memcpy(&buffer->buf[idx], data,
+					wlen * sizeof(uint32_t));
+				wr_idx_inc(buffer, wlen);
+				max_utilization_update(buffer);
+			}
 		} else if (wrap) {
-			add_skip_item(buffer, free_wlen);
+			(void)add_skip_item(buffer, idx, free_wlen);
 			cont = true;
 		} else {
-			tmp_wr_idx_val = buffer->tmp_wr_idx;
+			tmp_wr_idx_val = idx;
 			cont = drop_item_locked(buffer, free_wlen,
 						 &dropped_item, &tmp_wr_idx_shift);
 		}
@@ -550,11 +683,17 @@ const union mpsc_pbuf_generic *mpsc_pbuf_claim(struct mpsc_pbuf_buffer *buffer)
 				uint32_t inc =
 					skip ? skip : buffer->get_wlen(item);
 
+				/* Only the header of a skip packet is written. */
+				clear_space(buffer, item, skip ? 1 : inc);
 				buffer->tmp_rd_idx =
 				      idx_inc(buffer, buffer->tmp_rd_idx, inc);
 				rd_idx_inc(buffer, inc);
 				cont = true;
 			} else {
+				/* Read the data after the valid header, which
+				 * lock-free producers set last.
+				 */
+				barrier_dmem_fence_full();
 				item->hdr.busy = 1;
 				buffer->tmp_rd_idx =
 					idx_inc(buffer, buffer->tmp_rd_idx,
@@ -582,6 +721,7 @@ void mpsc_pbuf_free(struct mpsc_pbuf_buffer *buffer,
 	if (!(buffer->flags & MPSC_PBUF_MODE_OVERWRITE) ||
 		 ((uint32_t *)item == &buffer->buf[buffer->rd_idx])) {
 		witem->hdr.busy = 0;
+		clear_space(buffer, witem, wlen);
 		if (buffer->rd_idx == buffer->tmp_rd_idx) {
 			/* There is a chance that there are so many new packets
 			 * added between claim and free that rd_idx points again
@@ -8,6 +8,7 @@
 #include <zephyr/sys/mutex.h>
 #include <zephyr/syscall_handler.h>
 #include <zephyr/kernel_structs.h>
+#include <kernel_internal.h>
 
 static struct k_mutex *get_k_mutex(struct sys_mutex *mutex)
 {
@@ -23,22 +24,38 @@ static struct k_mutex *get_k_mutex(struct sys_mutex *mutex)
 
 static bool check_sys_mutex_addr(struct sys_mutex *addr)
 {
-	/* sys_mutex memory is never touched, just used to lookup the
-	 * underlying k_mutex, but we don't want threads using mutexes
-	 * that are outside their memory domain
+	/* sys_mutex memory holds the owner, the underlying k_mutex is only
+	 * used to wait for it
 	 */
 	return Z_SYSCALL_MEMORY_WRITE(addr, sizeof(struct sys_mutex));
 }
 
+static inline struct k_thread *get_owner(struct sys_mutex *mutex)
+{
+	return (struct k_thread *)(atomic_get(&mutex->val) &
+				   ~Z_SYS_MUTEX_CONTENDED);
+}
+
 int z_impl_z_sys_mutex_kernel_lock(struct sys_mutex *mutex, k_timeout_t timeout)
 {
 	struct k_mutex *kernel_mutex = get_k_mutex(mutex);
+	int ret;
 
 	if (kernel_mutex == NULL) {
 		return -EINVAL;
 	}
 
-	return k_mutex_lock(kernel_mutex, timeout);
+	if (get_owner(mutex) == _current) {
+		mutex->lock_count++;
+		return 0;
+	}
+
+	ret = z_mutex_word_lock(kernel_mutex, &mutex->val, timeout);
+	if (ret == 0) {
+		mutex->lock_count = 1U;
+	}
+
+	return ret;
 }
 
 static inline int z_vrfy_z_sys_mutex_kernel_lock(struct sys_mutex *mutex,
@@ -56,11 +73,23 @@ int z_impl_z_sys_mutex_kernel_unlock(struct sys_mutex *mutex)
 {
 	struct k_mutex *kernel_mutex = get_k_mutex(mutex);
 
-	if (kernel_mutex == NULL || kernel_mutex->lock_count == 0) {
+	if (kernel_mutex == NULL || get_owner(mutex) == NULL) {
 		return -EINVAL;
 	}
 
-	return k_mutex_unlock(kernel_mutex);
+	if (get_owner(mutex) != _current) {
+		return -EPERM;
+	}
+
+	/* User threads come here with the count already dropped */
+	if (mutex->lock_count > 1U) {
+		mutex->lock_count--;
+		return 0;
+	}
+
+	mutex->lock_count = 0U;
+
+	return z_mutex_word_unlock(kernel_mutex, &mutex->val);
 }
 
 static inline int z_vrfy_z_sys_mutex_kernel_unlock(struct sys_mutex *mutex)
@@ -11,11 +11,13 @@
 #define INITIALIZED 1
 #define NOT_INITIALIZED 0
 
-#define CONCURRENT_READER_LIMIT  (CONFIG_MAX_PTHREAD_COUNT + 1)
-
 int64_t timespec_to_timeoutms(const struct timespec *abstime);
-static uint32_t read_lock_acquire(pthread_rwlock_t *rwlock, int32_t timeout);
-static uint32_t write_lock_acquire(pthread_rwlock_t *rwlock, int32_t timeout);
+
+/* Timed locks report a lock still busy at the deadline as a timeout */
+static int timed_lock_result(int ret)
+{
+	return ((ret == -EBUSY) || (ret == -EAGAIN)) ? ETIMEDOUT : -ret;
+}
 
 /**
  * @brief Initialize read-write lock object.
@@ -25,11 +27,7 @@ static uint32_t write_lock_acquire(pthread_rwlock_t *rwlock, int32_t timeout);
 int pthread_rwlock_init(pthread_rwlock_t *rwlock,
 			const pthread_rwlockattr_t *attr)
 {
-	k_sem_init(&rwlock->rd_sem, CONCURRENT_READER_LIMIT,
-		   CONCURRENT_READER_LIMIT);
-	k_sem_init(&rwlock->wr_sem, 1, 1);
-	k_sem_init(&rwlock->reader_active, 1, 1);
-	rwlock->wr_owner = NULL;
+	(void)k_rwlock_init(&rwlock->rwlock, 0);
 	rwlock->status = INITIALIZED;
 	return 0;
 }
@@ -41,27 +39,23 @@ int pthread_rwlock_init(pthread_rwlock_t *rwlock,
  */
 int pthread_rwlock_destroy(pthread_rwlock_t *rwlock)
 {
-	if (rwlock->status == NOT_INITIALIZED) {
+	if (rwlock->status != INITIALIZED) {
 		return EINVAL;
 	}
 
-	if (rwlock->wr_owner != NULL) {
+	/* Fails while any thread holds the lock, or waits for it */
+	if (k_rwlock_write_lock(&rwlock->rwlock, K_NO_WAIT) != 0) {
 		return EBUSY;
 	}
 
-	if (rwlock->status == INITIALIZED) {
-		rwlock->status = NOT_INITIALIZED;
-		return 0;
-	}
-
-	return EINVAL;
+	rwlock->status = NOT_INITIALIZED;
+	return 0;
 }
 
 /**
  * @brief Lock a read-write lock object for reading.
  *
- * API behaviour is unpredictable if number of concurrent reader
- * lock held is greater than CONCURRENT_READER_LIMIT.
+ * Readers wait while a writer holds the lock or waits for it.
  *
  * See IEEE 1003.1
  */
@@ -71,14 +65,13 @@ int pthread_rwlock_rdlock(pthread_rwlock_t *rwlock)
 		return EINVAL;
 	}
 
-	return read_lock_acquire(rwlock, SYS_FOREVER_MS);
+	return -k_rwlock_read_lock(&rwlock->rwlock, K_FOREVER);
 }
 
 /**
  * @brief Lock a read-write lock object for reading within specific time.
  *
- * API behaviour is unpredictable if number of concurrent reader
- * lock held is greater than CONCURRENT_READER_LIMIT.
+ * Readers wait while a writer holds the lock or waits for it.
  *
  * See IEEE 1003.1
  */
@@ -86,7 +79,6 @@ int pthread_rwlock_timedrdlock(pthread_rwlock_t *rwlock,
 			       const struct timespec *abstime)
 {
 	int32_t timeout;
-	uint32_t ret = 0U;
 
 	if (rwlock->status == NOT_INITIALIZED || abstime->tv_nsec < 0 ||
 	    abstime->tv_nsec > NSEC_PER_SEC) {
@@ -95,19 +87,13 @@ int pthread_rwlock_timedrdlock(pthread_rwlock_t *rwlock,
 
 	timeout = (int32_t) timespec_to_timeoutms(abstime);
 
-	if (read_lock_acquire(rwlock, timeout) != 0U) {
-		ret = ETIMEDOUT;
-	}
-
-	return ret;
+	return timed_lock_result(k_rwlock_read_lock(&rwlock->rwlock,
+						    SYS_TIMEOUT_MS(timeout)));
 }
 
 /**
  * @brief Lock a read-write lock object for reading immediately.
  *
- * API behaviour is unpredictable if number of concurrent reader
- * lock held is greater than CONCURRENT_READER_LIMIT.
- *
  * See IEEE 1003.1
  */
 int pthread_rwlock_tryrdlock(pthread_rwlock_t *rwlock)
@@ -116,14 +102,14 @@ int pthread_rwlock_tryrdlock(pthread_rwlock_t *rwlock)
 		return EINVAL;
 	}
 
-	return read_lock_acquire(rwlock, 0);
+	return -k_rwlock_read_lock(&rwlock->rwlock, K_NO_WAIT);
 }
 
 /**
  * @brief Lock a read-write lock object for writing.
  *
- * Write lock does not have priority over reader lock,
- * threads get lock based on priority.
+ * Writers have priority over readers, and the writer holding the lock
+ * inherits the priority of the waiting threads.
  *
  * See IEEE 1003.1
  */
@@ -133,14 +119,14 @@ int pthread_rwlock_wrlock(pthread_rwlock_t *rwlock)
 		return EINVAL;
 	}
 
-	return write_lock_acquire(rwlock, SYS_FOREVER_MS);
+	return -k_rwlock_write_lock(&rwlock->rwlock, K_FOREVER);
 }
 
 /**
  * @brief Lock a read-write lock object for writing within specific time.
  *
- * Write lock does not have priority over reader lock,
- * threads get lock based on priority.
+ * Writers have priority over readers, and the writer holding the lock
+ * inherits the priority of the waiting threads.
  *
  * See IEEE 1003.1
  */
@@ -148,7 +134,6 @@ int pthread_rwlock_timedwrlock(pthread_rwlock_t *rwlock,
 			       const struct timespec *abstime)
 {
 	int32_t timeout;
-	uint32_t ret = 0U;
 
 	if (rwlock->status == NOT_INITIALIZED || abstime->tv_nsec < 0 ||
 	    abstime->tv_nsec > NSEC_PER_SEC) {
@@ -157,19 +142,13 @@ int pthread_rwlock_timedwrlock(pthread_rwlock_t *rwlock,
 
 	timeout = (int32_t) timespec_to_timeoutms(abstime);
 
-	if (write_lock_acquire(rwlock, timeout) != 0U) {
-		ret = ETIMEDOUT;
-	}
-
-	return ret;
+	return timed_lock_result(k_rwlock_write_lock(&rwlock->rwlock,
+						     SYS_TIMEOUT_MS(timeout)));
 }
 
 /**
  * @brief Lock a read-write lock object for writing immediately.
  *
- * Write lock does not have priority over reader lock,
- * threads get lock based on priority.
- *
  * See IEEE 1003.1
  */
 int pthread_rwlock_trywrlock(pthread_rwlock_t *rwlock)
@@ -178,7 +157,7 @@ int pthread_rwlock_trywrlock(pthread_rwlock_t *rwlock)
 		return EINVAL;
 	}
 
-	return write_lock_acquire(rwlock, 0);
+	return -k_rwlock_write_lock(&rwlock->rwlock, K_NO_WAIT);
 }
 
 /**
@@ -193,69 +172,10 @@ int pthread_rwlock_unlock(pthread_rwlock_t *rwlock)
 		return EINVAL;
 	}
 
-	if (k_current_get() == rwlock->wr_owner) {
-		/* Write unlock */
-		rwlock->wr_owner = NULL;
-		k_sem_give(&rwlock->reader_active);
-		k_sem_give(&rwlock->wr_sem);
-	} else {
-		/* Read unlock */
-		k_sem_give(&rwlock->rd_sem);
-
-		if (k_sem_count_get(&rwlock->rd_sem) ==
-				    CONCURRENT_READER_LIMIT) {
-			/* Last read lock, unlock writer */
-			k_sem_give(&rwlock->reader_active);
-		}
-	}
-	return 0;
-}
-
-
-static uint32_t read_lock_acquire(pthread_rwlock_t *rwlock, int32_t timeout)
-{
-	uint32_t ret = 0U;
-
-	if (k_sem_take(&rwlock->wr_sem, SYS_TIMEOUT_MS(timeout)) == 0) {
-		k_sem_take(&rwlock->reader_active, K_NO_WAIT);
-		k_sem_take(&rwlock->rd_sem, K_NO_WAIT);
-		k_sem_give(&rwlock->wr_sem);
-	} else {
-		ret = EBUSY;
+	/* The write lock is held by the caller, or else a read lock */
+	if (k_rwlock_write_unlock(&rwlock->rwlock) == 0) {
+		return 0;
 	}
 
-	return ret;
-}
-
-static uint32_t write_lock_acquire(pthread_rwlock_t *rwlock, int32_t timeout)
-{
-	uint32_t ret = 0U;
-	int64_t elapsed_time, st_time = k_uptime_get();
-	k_timeout_t k_timeout;
-
-	k_timeout = SYS_TIMEOUT_MS(timeout);
-
-	/* waiting for release of write lock */
-	if (k_sem_take(&rwlock->wr_sem, k_timeout) == 0) {
-		/* update remaining timeout time for 2nd sem */
-		if (timeout != SYS_FOREVER_MS) {
-			elapsed_time = k_uptime_get() - st_time;
-			timeout = timeout <= elapsed_time ? 0 :
-				  timeout - elapsed_time;
-		}
-
-		k_timeout = SYS_TIMEOUT_MS(timeout);
-
-		/* waiting for reader to complete operation */
-		if (k_sem_take(&rwlock->reader_active, k_timeout) == 0) {
-			rwlock->wr_owner = k_current_get();
-		} else {
-			k_sem_give(&rwlock->wr_sem);
-			ret = EBUSY;
-		}
-
-	} else {
-		ret = EBUSY;
-	}
-	return ret;
+	return -k_rwlock_read_unlock(&rwlock->rwlock);
 }
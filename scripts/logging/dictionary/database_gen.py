@@ -257,6 +257,11 @@ def process_kconfigs(elf, database):
         database.add_kconfig("CONFIG_LOG_TIMESTAMP_64BIT",
                              kconfigs['CONFIG_LOG_TIMESTAMP_64BIT'])
 
+    # Are messages wrapped in frames?
+    if "CONFIG_LOG_DICTIONARY_FRAMING" in kconfigs:
+        database.add_kconfig("CONFIG_LOG_DICTIONARY_FRAMING",
+                             kconfigs['CONFIG_LOG_DICTIONARY_FRAMING'])
+
 
 def extract_logging_subsys_information(elf, database, string_mappings):
     """
@@ -0,0 +1,105 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2023 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Frame decoder for dictionary-based logging
+
+When CONFIG_LOG_DICTIONARY_FRAMING is enabled, every log message is
+wrapped in a frame:
+
+    sync word (0x5A 0xA5) | length (uint16) | message | CRC-16/CCITT (uint16)
+
+The length and the CRC are little endian, whatever the endianness of the
+target.
+
+This extracts the messages from a byte stream which may start in the
+middle of a frame, or have lost or corrupted bytes.
+"""
+
+import struct
+
+
+FRAME_SYNC = b'\x5a\xa5'
+
+# Need to keep sync with struct log_dict_output_frame_hdr_t in
+# include/zephyr/logging/log_output_dict.h.
+FMT_FRAME_LEN = "<H"
+FMT_FRAME_CRC = "<H"
+
+FRAME_HDR_LEN = len(FRAME_SYNC) + struct.calcsize(FMT_FRAME_LEN)
+FRAME_CRC_LEN = struct.calcsize(FMT_FRAME_CRC)
+
+# Message header, 10-bit package length and 12-bit data length
+MAX_MSG_LEN = 32 + 1023 + 4095
+
+
+def crc16_ccitt(seed, data):
+    """Same as crc16_ccitt() in lib/crc/crc16_sw.c"""
+    for byte in data:
+        e = (seed ^ byte) & 0xFF
+        f = (e ^ (e << 4)) & 0xFF
+        seed = (seed >> 8) ^ (f << 8) ^ (f << 3) ^ (f >> 4)
+        seed &= 0xFFFF
+
+    return seed
+
+
+class LogFrameDecoder():
+    """Extract log messages from a stream of frames"""
+    def __init__(self):
+        self.buf = bytearray()
+        self.skipped_bytes = 0
+        self.bad_frames = 0
+
+
+    def feed(self, data):
+        """Add received data and return the list of complete messages"""
+        self.buf += data
+        msgs = []
+
+        while True:
+            idx = self.buf.find(FRAME_SYNC)
+            if idx < 0:
+                # Keep a trailing byte which may start the sync word
+                keep = 1 if self.buf[-1:] == FRAME_SYNC[:1] else 0
+                self.skipped_bytes += len(self.buf) - keep
+                del self.buf[:len(self.buf) - keep]
+                break
+
+            self.skipped_bytes += idx
+            del self.buf[:idx]
+
+            if len(self.buf) < FRAME_HDR_LEN:
+                break
+
+            msg_len = struct.unpack_from(FMT_FRAME_LEN, self.buf,
+                                         len(FRAME_SYNC))[0]
+            if msg_len > MAX_MSG_LEN:
+                # Do not wait for a frame which cannot exist
+                self.bad_frames += 1
+                self.skipped_bytes += 1
+                del self.buf[:1]
+                continue
+
+            frame_len = FRAME_HDR_LEN + msg_len + FRAME_CRC_LEN
+            if len(self.buf) < frame_len:
+                break
+
+            msg = bytes(self.buf[FRAME_HDR_LEN:FRAME_HDR_LEN + msg_len])
+            crc = struct.unpack_from(FMT_FRAME_CRC, self.buf,
+                                     FRAME_HDR_LEN + msg_len)[0]
+
+            if crc16_ccitt(0xFFFF, msg) != crc:
+                # Not a frame or a corrupted one, look for the next sync word
+                self.bad_frames += 1
+                self.skipped_bytes += 1
+                del self.buf[:1]
+                continue
+
+            msgs.append(msg)
+            del self.buf[:frame_len]
+
+        return msgs
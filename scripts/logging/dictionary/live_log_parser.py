@@ -0,0 +1,175 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2023 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Live Log Parser for Dictionary-based Logging
+
+This decodes a stream of dictionary-based log messages as it is received
+from a serial port, a file being written (e.g. by the file system backend
+or a capture tool) or the standard input, and prints the log messages.
+
+The firmware has to be built with CONFIG_LOG_DICTIONARY_FRAMING=y, so that
+message boundaries can be found when joining the stream at any point.
+"""
+
+import argparse
+import binascii
+import logging
+import os
+import sys
+import time
+
+import dictionary_parser
+from dictionary_parser.log_database import LogDatabase
+from dictionary_parser.log_frame import LogFrameDecoder
+
+
+LOGGER_FORMAT = "%(message)s"
+logger = logging.getLogger("parser")
+
+READ_SIZE = 1024
+POLL_INTERVAL_S = 0.1
+HEX_DIGITS = b"0123456789abcdefABCDEF"
+HEX_WHITESPACE = b" \t\r\n"
+
+
+def parse_args():
+    """Parse command line arguments"""
+    argparser = argparse.ArgumentParser(allow_abbrev=False)
+
+    argparser.add_argument("dbfile", help="Dictionary Logging Database file")
+    argparser.add_argument("input",
+                           help="Serial port, log data file, or - for standard input")
+    argparser.add_argument("--serial", action="store_true",
+                           help="Input is a serial port (requires pyserial)")
+    argparser.add_argument("--baudrate", type=int, default=115200,
+                           help="Serial port baud rate (default: 115200)")
+    argparser.add_argument("--follow", action="store_true",
+                           help="Keep reading the log data file as it grows")
+    argparser.add_argument("--hex", action="store_true",
+                           help="Log data is in hexadecimal characters; "
+                                "other characters are ignored")
+    argparser.add_argument("--debug", action="store_true",
+                           help="Print extra debugging information")
+
+    return argparser.parse_args()
+
+
+def open_input(args):
+    """Return a function reading the next chunk of log data, b'' at the end"""
+    if args.serial:
+        import serial # pylint: disable=import-outside-toplevel
+
+        port = serial.Serial(args.input, args.baudrate, timeout=POLL_INTERVAL_S)
+
+        def read_serial():
+            data = port.read(READ_SIZE)
+            # Timeouts are not the end of the stream
+            return data if data else None
+
+        return read_serial
+
+    if args.input == "-":
+        stdin = sys.stdin.buffer
+
+        return lambda: os.read(stdin.fileno(), READ_SIZE)
+
+    logfile = open(args.input, "rb") # pylint: disable=consider-using-with
+
+    def read_file():
+        data = logfile.read(READ_SIZE)
+        if not data and args.follow:
+            time.sleep(POLL_INTERVAL_S)
+            return None
+
+        return data
+
+    return read_file
+
+
+class HexDecoder():
+    """Convert hexadecimal characters to binary, skipping anything else"""
+    def __init__(self):
+        self.digits = bytearray()
+
+
+    def feed(self, data):
+        """Return the binary data of complete pairs of hexadecimal digits"""
+        out = bytearray()
+
+        for c in data:
+            if c in HEX_DIGITS:
+                self.digits.append(c)
+                if len(self.digits) == 2:
+                    out += binascii.unhexlify(self.digits)
+                    self.digits.clear()
+            elif c not in HEX_WHITESPACE:
+                # Other output (e.g. the ##ZLOGV1## marker) breaks the pairs
+                self.digits.clear()
+
+        return bytes(out)
+
+
+def main():
+    """Main function of live log parser"""
+    args = parse_args()
+
+    # Setup logging for parser
+    logging.basicConfig(format=LOGGER_FORMAT)
+    if args.debug:
+        logger.setLevel(logging.DEBUG)
+    else:
+        logger.setLevel(logging.INFO)
+
+    # Read from database file
+    database = LogDatabase.read_json_database(args.dbfile)
+    if database is None:
+        logger.error("ERROR: Cannot open database file: %s, exiting...", args.dbfile)
+        sys.exit(1)
+
+    if "CONFIG_LOG_DICTIONARY_FRAMING" not in database.get_kconfigs():
+        logger.error("ERROR: Live parsing requires CONFIG_LOG_DICTIONARY_FRAMING, exiting...")
+        sys.exit(1)
+
+    log_parser = dictionary_parser.get_parser(database)
+    if log_parser is None:
+        logger.error("ERROR: Cannot find a suitable parser matching database version!")
+        sys.exit(1)
+
+    logger.debug("# Build ID: %s", database.get_build_id())
+
+    read = open_input(args)
+    hex_decoder = HexDecoder() if args.hex else None
+    frame_decoder = LogFrameDecoder()
+    bad_frames = 0
+
+    # Messages are printed as they arrive
+    sys.stdout.reconfigure(line_buffering=True)
+
+    try:
+        while True:
+            data = read()
+            if data is None:
+                continue
+            if not data:
+                break
+
+            if hex_decoder is not None:
+                data = hex_decoder.feed(data)
+
+            for msg in frame_decoder.feed(data):
+                if not log_parser.parse_log_data(msg, debug=args.debug):
+                    logger.error("ERROR: cannot parse log message")
+
+            if frame_decoder.bad_frames != bad_frames:
+                bad_frames = frame_decoder.bad_frames
+                logger.debug("# %d corrupted frames so far", bad_frames)
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
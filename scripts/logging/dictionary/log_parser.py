@@ -18,6 +18,7 @@ import sys
 
 import dictionary_parser
 from dictionary_parser.log_database import LogDatabase
+from dictionary_parser.log_frame import LogFrameDecoder
 
 
 LOGGER_FORMAT = "%(message)s"
@@ -123,6 +124,12 @@ def main():
         logger.error("ERROR: cannot read log from file: %s, exiting...", args.logfile)
         sys.exit(1)
 
+    if "CONFIG_LOG_DICTIONARY_FRAMING" in database.get_kconfigs():
+        frame_decoder = LogFrameDecoder()
+        logdata = b''.join(frame_decoder.feed(logdata))
+        if frame_decoder.bad_frames > 0:
+            logger.warning("WARNING: skipped %d corrupted frames", frame_decoder.bad_frames)
+
     log_parser = dictionary_parser.get_parser(database)
     if log_parser is not None:
         logger.debug("# Build ID: %s", database.get_build_id())
@@ -0,0 +1,184 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2023 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Convert the samples recorded by the sampling profiler (CONFIG_PROFILING_PERF)
+into folded stacks, one line per distinct call stack followed by the number of
+samples, as used by flame graph tools:
+
+    stackcollapse.py build/zephyr/zephyr.elf perf.log > perf.folded
+    flamegraph.pl perf.folded > perf.svg
+
+The input is either a log holding the output of the "perf dump" shell command
+or a raw binary dump written by perf_dump().
+"""
+
+import argparse
+import binascii
+import bisect
+import collections
+import struct
+import sys
+
+from elftools.elf.elffile import ELFFile
+from elftools.elf.sections import SymbolTableSection
+
+
+PERF_PREFIX_STR = "#PERF:"
+PERF_BEGIN_STR = PERF_PREFIX_STR + "BEGIN#"
+PERF_END_STR = PERF_PREFIX_STR + "END#"
+
+PERF_DUMP_MAGIC = 0x46524550
+PERF_DUMP_VERSION = 1
+
+# Functions through which interrupts are taken on the native targets, the
+# frames from the sampled interrupt up to them are not part of the profile.
+IRQ_ENTRY_SYMBOLS = ("posix_irq_handler",)
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(allow_abbrev=False,
+        description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+
+    parser.add_argument("elffile", help="Zephyr ELF file")
+    parser.add_argument("infile", help="Log holding a perf dump, or binary dump")
+    parser.add_argument("-o", "--output", help="Output file, stdout by default")
+    parser.add_argument("--cpu", type=int, help="Only include samples of this CPU")
+
+    return parser.parse_args()
+
+
+def read_dump(path):
+    """Return the binary dump held by the input file."""
+    with open(path, "rb") as f:
+        data = f.read()
+
+    for endian in ("<", ">"):
+        if len(data) >= 4 and struct.unpack(endian + "I", data[:4])[0] == PERF_DUMP_MAGIC:
+            return data
+
+    dump = bytearray()
+    in_dump = False
+    for line in data.decode("utf-8", errors="replace").splitlines():
+        if PERF_BEGIN_STR in line:
+            # Only keep the last dump of the log
+            dump = bytearray()
+            in_dump = True
+        elif PERF_END_STR in line:
+            in_dump = False
+        elif in_dump and PERF_PREFIX_STR in line:
+            hex_str = line[line.find(PERF_PREFIX_STR) + len(PERF_PREFIX_STR):].strip()
+            dump += binascii.unhexlify(hex_str)
+
+    if not dump:
+        sys.exit(f"ERROR: no perf dump found in {path}")
+
+    return bytes(dump)
+
+
+def parse_dump(dump):
+    """Return the sampling frequency and a list of (cpu, frames) samples."""
+    endian = "<" if struct.unpack("<I", dump[:4])[0] == PERF_DUMP_MAGIC else ">"
+    header = struct.Struct(endian + "IBBBBI")
+    cpu_header = struct.Struct(endian + "IIII")
+
+    magic, version, word_size, num_cpus, _, frequency = header.unpack_from(dump, 0)
+    if magic != PERF_DUMP_MAGIC or version != PERF_DUMP_VERSION:
+        sys.exit("ERROR: unsupported perf dump")
+
+    word = struct.Struct(endian + {4: "I", 8: "Q"}[word_size])
+    offset = header.size
+    samples = []
+
+    for _ in range(num_cpus):
+        cpu, count, dropped, words = cpu_header.unpack_from(dump, offset)
+        offset += cpu_header.size
+
+        values = [word.unpack_from(dump, offset + i * word_size)[0] for i in range(words)]
+        offset += words * word_size
+
+        pos = 0
+        while pos < len(values):
+            depth = values[pos]
+            samples.append((cpu, values[pos + 1:pos + 1 + depth]))
+            pos += 1 + depth
+
+        if dropped:
+            print(f"CPU {cpu}: {dropped} of {count + dropped} samples dropped, "
+                  "increase CONFIG_PROFILING_PERF_BUFFER_SIZE", file=sys.stderr)
+
+    return frequency, samples
+
+
+class Symbolizer:
+    def __init__(self, path):
+        self.starts = []
+        self.symbols = []
+
+        with open(path, "rb") as f:
+            elf = ELFFile(f)
+            # Clear the Thumb bit of ARM function addresses
+            mask = ~1 if elf["e_machine"] == "EM_ARM" else ~0
+            funcs = []
+            for section in elf.iter_sections():
+                if not isinstance(section, SymbolTableSection):
+                    continue
+                for sym in section.iter_symbols():
+                    if sym["st_info"]["type"] == "STT_FUNC" and sym["st_size"] > 0:
+                        funcs.append((sym["st_value"] & mask, sym["st_size"], sym.name))
+
+        for start, size, name in sorted(funcs):
+            self.starts.append(start)
+            self.symbols.append((start + size, name))
+
+    def lookup(self, addr):
+        i = bisect.bisect_right(self.starts, addr) - 1
+        if i >= 0 and addr < self.symbols[i][0]:
+            return self.symbols[i][1]
+        return None
+
+
+def fold(samples, symbolizer, cpu_filter):
+    stacks = collections.Counter()
+
+    for cpu, frames in samples:
+        if cpu_filter is not None and cpu != cpu_filter:
+            continue
+
+        names = []
+        for i, addr in enumerate(frames):
+            # Return addresses point after the call instruction
+            name = symbolizer.lookup(addr if i == 0 else addr - 1)
+            names.append(name if name is not None else f"0x{addr:x}")
+
+        for i, name in enumerate(names):
+            if name in IRQ_ENTRY_SYMBOLS:
+                names = names[i + 1:]
+                break
+
+        if names:
+            stacks[";".join(reversed(names))] += 1
+
+    return stacks
+
+
+def main():
+    args = parse_args()
+
+    frequency, samples = parse_dump(read_dump(args.infile))
+    stacks = fold(samples, Symbolizer(args.elffile), args.cpu)
+
+    print(f"{len(samples)} samples at {frequency} Hz", file=sys.stderr)
+
+    out = open(args.output, "w") if args.output else sys.stdout
+    for stack, count in sorted(stacks.items()):
+        out.write(f"{stack} {count}\n")
+    if args.output:
+        out.close()
+
+
+if __name__ == "__main__":
+    main()
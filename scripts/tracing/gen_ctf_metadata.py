@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2023 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: Apache-2.0
+"""
+Generate the CTF metadata matching the tracing configuration of a build.
+
+The metadata in subsys/tracing/ctf/tsdl/metadata describes events with the
+default event header. When CONFIG_TRACING_CTF_COMPACT_HEADER is enabled the
+event header is replaced by a compact one, with timestamps mapped to a clock
+running at the frequency of the cycle counter.
+"""
+
+import argparse
+import re
+import sys
+
+COMPACT_HEADER = """\
+clock {{
+	name = cycles;
+	freq = {freq};
+	offset = 0;
+}};
+
+typealias integer {{ size = 16; align = 8; signed = false; map = clock.cycles.value; }} := uint16_clock_t;
+typealias integer {{ size = 32; align = 8; signed = false; map = clock.cycles.value; }} := uint32_clock_t;
+
+struct event_header {{
+	enum : uint8_t {{ compact = 0 ... 254, extended = 255 }} id;
+	variant <id> {{
+		struct {{
+			uint16_clock_t timestamp;
+		}} compact;
+		struct {{
+			uint8_t id;
+			uint32_clock_t timestamp;
+		}} extended;
+	}} v;
+}};
+"""
+
+HEADER_RE = re.compile(r"^struct event_header \{.*?^\};\n", re.MULTILINE | re.DOTALL)
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter, allow_abbrev=False)
+    parser.add_argument("-t", "--template", required=True,
+                        help="CTF metadata with the default event header")
+    parser.add_argument("-o", "--output", required=True,
+                        help="generated CTF metadata")
+    parser.add_argument("--compact", action="store_true",
+                        help="use the compact event header")
+    parser.add_argument("--freq", type=int, default=0,
+                        help="cycle counter frequency (required with --compact)")
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+
+    with open(args.template, "r", encoding="utf-8") as f:
+        metadata = f.read()
+
+    if args.compact:
+        if args.freq <= 0:
+            sys.exit("Cycle counter frequency is required for the compact header")
+
+        metadata, count = HEADER_RE.subn(COMPACT_HEADER.format(freq=args.freq),
+                                         metadata, count=1)
+        if count != 1:
+            sys.exit(f"Event header not found in {args.template}")
+
+    with open(args.output, "w", encoding="utf-8") as f:
+        f.write(metadata)
+
+
+if __name__ == "__main__":
+    main()
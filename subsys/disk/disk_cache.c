@@ -0,0 +1,411 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/storage/disk_access.h>
+#include "disk_cache.h"
+
+#define LOG_LEVEL CONFIG_DISK_LOG_LEVEL
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(disk);
+
+#define CACHE_SECTORS CONFIG_DISK_CACHE_SECTORS
+#define CACHE_SECTOR_SIZE CONFIG_DISK_CACHE_SECTOR_SIZE
+#define XFER_SECTORS CONFIG_DISK_CACHE_XFER_SECTORS
+
+/* Requests larger than this are not worth caching */
+#define BYPASS_SECTORS (CACHE_SECTORS / 2)
+
+struct disk_cache_entry {
+	/* Disk the sector belongs to, NULL if the entry is free */
+	struct disk_info *disk;
+	uint32_t sector;
+	/* Value of the access counter when the entry was last used */
+	uint32_t last_use;
+	/* Set if the data has not been written to the disk yet */
+	bool dirty;
+	uint8_t data[CACHE_SECTOR_SIZE];
+};
+
+static struct disk_cache_entry cache_entries[CACHE_SECTORS];
+static uint8_t xfer_buf[XFER_SECTORS * CACHE_SECTOR_SIZE];
+static struct disk_access_cache_stats cache_stats;
+static uint32_t cache_access_cnt;
+static K_MUTEX_DEFINE(cache_lock);
+
+#ifdef CONFIG_DISK_CACHE_READ_AHEAD
+/* Disk and sector that would continue the last read */
+static struct disk_info *seq_disk;
+static uint32_t seq_sector;
+#endif
+
+static struct disk_cache_entry *cache_lookup(struct disk_info *disk,
+					     uint32_t sector)
+{
+	for (int i = 0; i < CACHE_SECTORS; i++) {
+		if (cache_entries[i].disk == disk &&
+		    cache_entries[i].sector == sector) {
+			return &cache_entries[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void cache_touch(struct disk_cache_entry *entry)
+{
+	entry->last_use = ++cache_access_cnt;
+}
+
+/* Must be called with cache_lock held */
+static int cache_flush(struct disk_info *disk)
+{
+	uint32_t size = disk->cache_sector_size;
+	int rc;
+
+	while (true) {
+		struct disk_cache_entry *first = NULL;
+		struct disk_cache_entry *entry;
+		uint32_t cnt;
+
+		for (int i = 0; i < CACHE_SECTORS; i++) {
+			entry = &cache_entries[i];
+			if (entry->disk == disk && entry->dirty &&
+			    (first == NULL || entry->sector < first->sector)) {
+				first = entry;
+			}
+		}
+
+		if (first == NULL) {
+			return 0;
+		}
+
+		/* Merge the dirty sectors following the first one */
+		memcpy(xfer_buf, first->data, size);
+		for (cnt = 1; cnt < XFER_SECTORS; cnt++) {
+			entry = cache_lookup(disk, first->sector + cnt);
+			if (entry == NULL || !entry->dirty) {
+				break;
+			}
+			memcpy(&xfer_buf[cnt * size], entry->data, size);
+		}
+
+		rc = disk->ops->write(disk, xfer_buf, first->sector, cnt);
+		if (rc != 0) {
+			LOG_ERR("Write back of %u sectors at %u failed: %d",
+				cnt, first->sector, rc);
+			return rc;
+		}
+
+		for (uint32_t i = 0; i < cnt; i++) {
+			cache_lookup(disk, first->sector + i)->dirty = false;
+		}
+
+		cache_stats.write_backs++;
+		cache_stats.written_back += cnt;
+	}
+}
+
+/* Must be called with cache_lock held, returns NULL if a write back failed */
+static struct disk_cache_entry *cache_alloc(struct disk_info *disk,
+					    uint32_t sector)
+{
+	struct disk_cache_entry *victim = &cache_entries[0];
+
+	for (int i = 0; i < CACHE_SECTORS; i++) {
+		if (cache_entries[i].disk == NULL) {
+			victim = &cache_entries[i];
+			break;
+		}
+		/* Wrap-around safe comparison of access counter values */
+		if ((int32_t)(cache_entries[i].last_use - victim->last_use) < 0) {
+			victim = &cache_entries[i];
+		}
+	}
+
+	if (victim->disk != NULL && victim->dirty &&
+	    cache_flush(victim->disk) != 0) {
+		return NULL;
+	}
+
+	victim->disk = disk;
+	victim->sector = sector;
+	victim->dirty = false;
+	cache_touch(victim);
+
+	return victim;
+}
+
+/* Must be called with cache_lock held */
+static void cache_insert(struct disk_info *disk, const uint8_t *data,
+			 uint32_t start_sector, uint32_t num_sector,
+			 uint32_t size)
+{
+	for (uint32_t i = 0; i < num_sector; i++) {
+		struct disk_cache_entry *entry =
+			cache_alloc(disk, start_sector + i);
+
+		if (entry == NULL) {
+			return;
+		}
+		memcpy(entry->data, &data[i * size], size);
+	}
+}
+
+/* Must be called with cache_lock held */
+static void cache_drop(struct disk_info *disk, uint32_t start_sector,
+		       uint32_t num_sector)
+{
+	for (int i = 0; i < CACHE_SECTORS; i++) {
+		struct disk_cache_entry *entry = &cache_entries[i];
+
+		if (entry->disk == disk && entry->sector >= start_sector &&
+		    entry->sector - start_sector < num_sector) {
+			entry->disk = NULL;
+		}
+	}
+}
+
+#ifdef CONFIG_DISK_CACHE_READ_AHEAD
+/* Must be called with cache_lock held */
+static void cache_read_ahead(struct disk_info *disk, uint32_t sector,
+			     uint32_t size)
+{
+	struct disk_cache_entry *entries[XFER_SECTORS];
+	uint32_t sector_count;
+	uint32_t cnt = 0;
+
+	if (disk->ops->ioctl(disk, DISK_IOCTL_GET_SECTOR_COUNT,
+			     &sector_count) != 0) {
+		return;
+	}
+
+	while (cnt < XFER_SECTORS && sector + cnt < sector_count &&
+	       cache_lookup(disk, sector + cnt) == NULL) {
+		cnt++;
+	}
+
+	/*
+	 * Entries are allocated before reading, as evicting a dirty entry
+	 * writes it back through the transfer buffer.
+	 */
+	for (uint32_t i = 0; i < cnt; i++) {
+		entries[i] = cache_alloc(disk, sector + i);
+		if (entries[i] == NULL) {
+			cnt = i;
+			break;
+		}
+	}
+
+	if (cnt == 0) {
+		return;
+	}
+
+	if (disk->ops->read(disk, xfer_buf, sector, cnt) != 0) {
+		cache_drop(disk, sector, cnt);
+		return;
+	}
+
+	for (uint32_t i = 0; i < cnt; i++) {
+		memcpy(entries[i]->data, &xfer_buf[i * size], size);
+	}
+	cache_stats.read_ahead += cnt;
+}
+#endif /* CONFIG_DISK_CACHE_READ_AHEAD */
+
+int disk_cache_read(struct disk_info *disk, uint8_t *data_buf,
+		    uint32_t start_sector, uint32_t num_sector)
+{
+	uint32_t size = disk->cache_sector_size;
+	int rc = 0;
+
+	if (size == 0) {
+		return disk->ops->read(disk, data_buf, start_sector, num_sector);
+	}
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	if (num_sector > BYPASS_SECTORS) {
+		/* The disk has to hold the latest data before reading it */
+		rc = cache_flush(disk);
+		if (rc == 0) {
+			cache_stats.bypasses++;
+			rc = disk->ops->read(disk, data_buf, start_sector,
+					     num_sector);
+		}
+		goto out;
+	}
+
+	for (uint32_t i = 0; i < num_sector; i++) {
+		struct disk_cache_entry *entry =
+			cache_lookup(disk, start_sector + i);
+		uint32_t run = 1;
+
+		if (entry != NULL) {
+			memcpy(&data_buf[i * size], entry->data, size);
+			cache_touch(entry);
+			cache_stats.hits++;
+			continue;
+		}
+
+		/* Read consecutive missing sectors with a single command */
+		while (i + run < num_sector &&
+		       cache_lookup(disk, start_sector + i + run) == NULL) {
+			run++;
+		}
+
+		rc = disk->ops->read(disk, &data_buf[i * size],
+				     start_sector + i, run);
+		if (rc != 0) {
+			goto out;
+		}
+
+		cache_insert(disk, &data_buf[i * size], start_sector + i, run,
+			     size);
+		cache_stats.misses += run;
+		i += run - 1;
+	}
+
+#ifdef CONFIG_DISK_CACHE_READ_AHEAD
+	if (seq_disk == disk && seq_sector == start_sector) {
+		cache_read_ahead(disk, start_sector + num_sector, size);
+	}
+#endif
+
+out:
+#ifdef CONFIG_DISK_CACHE_READ_AHEAD
+	seq_disk = disk;
+	seq_sector = start_sector + num_sector;
+#endif
+	k_mutex_unlock(&cache_lock);
+
+	return rc;
+}
+
+int disk_cache_write(struct disk_info *disk, const uint8_t *data_buf,
+		     uint32_t start_sector, uint32_t num_sector)
+{
+	uint32_t size = disk->cache_sector_size;
+	int rc = 0;
+
+	if (size == 0) {
+		return disk->ops->write(disk, data_buf, start_sector, num_sector);
+	}
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	if (num_sector > BYPASS_SECTORS) {
+		/* Cached copies, dirty or not, are superseded by the new data */
+		cache_drop(disk, start_sector, num_sector);
+		cache_stats.bypasses++;
+		rc = disk->ops->write(disk, data_buf, start_sector, num_sector);
+		goto out;
+	}
+
+	if (!IS_ENABLED(CONFIG_DISK_CACHE_WRITE_BACK)) {
+		rc = disk->ops->write(disk, data_buf, start_sector, num_sector);
+		if (rc != 0) {
+			cache_drop(disk, start_sector, num_sector);
+			goto out;
+		}
+	}
+
+	for (uint32_t i = 0; i < num_sector; i++) {
+		struct disk_cache_entry *entry =
+			cache_lookup(disk, start_sector + i);
+
+		if (entry == NULL) {
+			if (!IS_ENABLED(CONFIG_DISK_CACHE_WRITE_BACK)) {
+				continue;
+			}
+
+			entry = cache_alloc(disk, start_sector + i);
+			if (entry == NULL) {
+				rc = -EIO;
+				goto out;
+			}
+		}
+
+		memcpy(entry->data, &data_buf[i * size], size);
+		entry->dirty = IS_ENABLED(CONFIG_DISK_CACHE_WRITE_BACK);
+		cache_touch(entry);
+	}
+
+out:
+	k_mutex_unlock(&cache_lock);
+
+	return rc;
+}
+
+int disk_cache_sync(struct disk_info *disk)
+{
+	int rc;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+	rc = cache_flush(disk);
+	k_mutex_unlock(&cache_lock);
+
+	return rc;
+}
+
+/* Must be called with cache_lock held */
+static void cache_forget(struct disk_info *disk)
+{
+	cache_drop(disk, 0, UINT32_MAX);
+#ifdef CONFIG_DISK_CACHE_READ_AHEAD
+	if (seq_disk == disk) {
+		seq_disk = NULL;
+	}
+#endif
+}
+
+void disk_cache_setup(struct disk_info *disk)
+{
+	uint32_t size;
+
+	if (disk->ops->ioctl == NULL ||
+	    disk->ops->ioctl(disk, DISK_IOCTL_GET_SECTOR_SIZE, &size) != 0 ||
+	    size > CACHE_SECTOR_SIZE) {
+		size = 0;
+	}
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+	/* Sectors of the previous media must not be written to the new one */
+	cache_forget(disk);
+	disk->cache_sector_size = size;
+	k_mutex_unlock(&cache_lock);
+}
+
+int disk_cache_invalidate(struct disk_info *disk)
+{
+	int rc;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+	rc = cache_flush(disk);
+	cache_forget(disk);
+	disk->cache_sector_size = 0;
+	k_mutex_unlock(&cache_lock);
+
+	return rc;
+}
+
+void disk_access_cache_stats_get(struct disk_access_cache_stats *stats)
+{
+	k_mutex_lock(&cache_lock, K_FOREVER);
+	*stats = cache_stats;
+	k_mutex_unlock(&cache_lock);
+}
+
+void disk_access_cache_stats_reset(void)
+{
+	k_mutex_lock(&cache_lock, K_FOREVER);
+	memset(&cache_stats, 0, sizeof(cache_stats));
+	k_mutex_unlock(&cache_lock);
+}
@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_SUBSYS_DISK_DISK_CACHE_H_
+#define ZEPHYR_SUBSYS_DISK_DISK_CACHE_H_
+
+#include <zephyr/drivers/disk.h>
+
+/* Read sectors through the cache */
+int disk_cache_read(struct disk_info *disk, uint8_t *data_buf,
+		    uint32_t start_sector, uint32_t num_sector);
+
+/* Write sectors through the cache */
+int disk_cache_write(struct disk_info *disk, const uint8_t *data_buf,
+		     uint32_t start_sector, uint32_t num_sector);
+
+/* Write back all dirty sectors of the disk */
+int disk_cache_sync(struct disk_info *disk);
+
+/* Drop all cached sectors of the newly initialized disk, without writing
+ * them back, and start caching it with its current sector size
+ */
+void disk_cache_setup(struct disk_info *disk);
+
+/* Write back and drop all cached sectors of the disk, and stop caching it */
+int disk_cache_invalidate(struct disk_info *disk);
+
+#endif /* ZEPHYR_SUBSYS_DISK_DISK_CACHE_H_ */
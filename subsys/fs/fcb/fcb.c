@@ -14,6 +14,7 @@
 #include <errno.h>
 #include <zephyr/device.h>
 #include <zephyr/drivers/flash.h>
+#include <zephyr/init.h>
 
 uint8_t
 fcb_get_align(const struct fcb *fcb)
@@ -51,6 +52,44 @@ int fcb_flash_read(const struct fcb *fcb, const struct flash_sector *sector,
 	return 0;
 }
 
+#ifdef CONFIG_FCB_READ_AHEAD
+/*
+ * Serve the read from the read-ahead buffer, refilling it from flash,
+ * starting at the requested offset, on a miss. Caller must hold f_mtx.
+ */
+int fcb_flash_read_ahead(struct fcb *fcb, struct flash_sector *sector,
+			 off_t off, void *dst, size_t len)
+{
+	size_t rd_len;
+	int rc;
+
+	if (len > sizeof(fcb->f_rd_buf)) {
+		return fcb_flash_read(fcb, sector, off, dst, len);
+	}
+
+	if (fcb->f_rd_len == 0U || fcb->f_rd_sector != sector ||
+	    off < fcb->f_rd_off || off + len > fcb->f_rd_off + fcb->f_rd_len) {
+		if (off + len > sector->fs_size) {
+			return -EINVAL;
+		}
+
+		rd_len = MIN(sizeof(fcb->f_rd_buf), sector->fs_size - off);
+		rc = fcb_flash_read(fcb, sector, off, fcb->f_rd_buf, rd_len);
+		if (rc) {
+			fcb->f_rd_len = 0U;
+			return rc;
+		}
+		fcb->f_rd_sector = sector;
+		fcb->f_rd_off = off;
+		fcb->f_rd_len = rd_len;
+	}
+
+	memcpy(dst, &fcb->f_rd_buf[off - fcb->f_rd_off], len);
+
+	return 0;
+}
+#endif /* CONFIG_FCB_READ_AHEAD */
+
 int fcb_flash_write(const struct fcb *fcb, const struct flash_sector *sector,
 		    off_t off, const void *src, size_t len)
 {
@@ -91,6 +130,79 @@ fcb_erase_sector(const struct fcb *fcb, const struct flash_sector *sector)
 	return 0;
 }
 
+#ifdef CONFIG_FCB_BACKGROUND_ERASE
+static K_THREAD_STACK_DEFINE(fcb_erase_stack, CONFIG_FCB_BACKGROUND_ERASE_STACK_SIZE);
+static struct k_work_q fcb_erase_wq;
+
+static int
+fcb_erase_wq_init(void)
+{
+	const struct k_work_queue_config cfg = {.name = "fcb_erase"};
+
+	k_work_queue_start(&fcb_erase_wq, fcb_erase_stack,
+			   K_THREAD_STACK_SIZEOF(fcb_erase_stack),
+			   CONFIG_FCB_BACKGROUND_ERASE_PRIO, &cfg);
+
+	return 0;
+}
+
+SYS_INIT(fcb_erase_wq_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+static void fcb_erase_work_handler(struct k_work *work)
+{
+	struct fcb *fcb = CONTAINER_OF(work, struct fcb, f_erase_work);
+
+	fcb->f_erase_rc = fcb_erase_sector(fcb, fcb->f_erase_sector);
+}
+
+/*
+ * Wait for the pending background erase, if any, and collect its result.
+ * Caller must hold f_mtx.
+ */
+int
+fcb_erase_wait(struct fcb *fcb)
+{
+	struct k_work_sync sync;
+	int rc;
+
+	if (fcb->f_erase_sector == NULL) {
+		return 0;
+	}
+
+	(void)k_work_flush(&fcb->f_erase_work, &sync);
+	rc = fcb->f_erase_rc;
+	fcb->f_erase_sector = NULL;
+	fcb->f_erase_rc = 0;
+
+	return rc;
+}
+
+/*
+ * Schedule erase of the sector on the FCB erase work queue. Only one erase
+ * is kept in flight, so a previous one is waited for first.
+ * Caller must hold f_mtx.
+ */
+int
+fcb_erase_sector_async(struct fcb *fcb, struct flash_sector *sector)
+{
+	int rc;
+
+	rc = fcb_erase_wait(fcb);
+	if (rc) {
+		return rc;
+	}
+
+	fcb->f_erase_sector = sector;
+	rc = k_work_submit_to_queue(&fcb_erase_wq, &fcb->f_erase_work);
+	if (rc < 0) {
+		fcb->f_erase_sector = NULL;
+		return -EIO;
+	}
+
+	return 0;
+}
+#endif /* CONFIG_FCB_BACKGROUND_ERASE */
+
 int
 fcb_init(int f_area_id, struct fcb *fcb)
 {
@@ -107,6 +219,19 @@ fcb_init(int f_area_id, struct fcb *fcb)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_FCB_BACKGROUND_ERASE
+	if (fcb->f_erase_init) {
+		/* Instance re-initialized, maybe with an erase still in flight */
+		(void)fcb_erase_wait(fcb);
+	} else {
+		k_work_init(&fcb->f_erase_work, fcb_erase_work_handler);
+		fcb->f_erase_sector = NULL;
+		fcb->f_erase_rc = 0;
+		fcb->f_erase_init = true;
+	}
+#endif
+	fcb_read_ahead_invalidate(fcb);
+
 	rc = flash_area_open(f_area_id, &fcb->fap);
 	if (rc != 0) {
 		return -EINVAL;
@@ -267,6 +392,7 @@ fcb_sector_hdr_init(struct fcb *fcb, struct flash_sector *sector, uint16_t id)
 	fda.fd_id = id;
 
 	rc = fcb_flash_write(fcb, sector, 0, &fda, sizeof(fda));
+	fcb_read_ahead_invalidate(fcb);
 	if (rc != 0) {
 		return -EIO;
 	}
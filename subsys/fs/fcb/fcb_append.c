@@ -46,6 +46,10 @@ fcb_append_to_scratch(struct fcb *fcb)
 	if (!sector) {
 		return -ENOSPC;
 	}
+	rc = fcb_erase_wait(fcb);
+	if (rc) {
+		return rc;
+	}
 	rc = fcb_sector_hdr_init(fcb, sector, fcb->f_active_id + 1);
 	if (rc) {
 		return rc;
@@ -89,6 +93,10 @@ fcb_append(struct fcb *fcb, uint16_t len, struct fcb_entry *append_loc)
 			rc = -ENOSPC;
 			goto err;
 		}
+		rc = fcb_erase_wait(fcb);
+		if (rc) {
+			goto err;
+		}
 		rc = fcb_sector_hdr_init(fcb, sector, fcb->f_active_id + 1);
 		if (rc) {
 			goto err;
@@ -99,6 +107,7 @@ fcb_append(struct fcb *fcb, uint16_t len, struct fcb_entry *append_loc)
 	}
 
 	rc = fcb_flash_write(fcb, active->fe_sector, active->fe_elem_off, tmp_str, cnt);
+	fcb_read_ahead_invalidate(fcb);
 	if (rc) {
 		rc = -EIO;
 		goto err;
@@ -126,15 +135,26 @@ fcb_append_finish(struct fcb *fcb, struct fcb_entry *loc)
 
 	(void)memset(em, 0xFF, sizeof(em));
 
+	rc = k_mutex_lock(&fcb->f_mtx, K_FOREVER);
+	if (rc) {
+		return -EINVAL;
+	}
+
+	/* Payload has been written behind the read-ahead buffer's back */
+	fcb_read_ahead_invalidate(fcb);
+
 	rc = fcb_elem_endmarker(fcb, loc, &em[0]);
 	if (rc) {
-		return rc;
+		goto out;
 	}
 	off = loc->fe_data_off + fcb_len_in_flash(fcb, loc->fe_data_len);
 
 	rc = fcb_flash_write(fcb, loc->fe_sector, off, em, fcb->f_align);
+	fcb_read_ahead_invalidate(fcb);
 	if (rc) {
-		return -EIO;
+		rc = -EIO;
 	}
-	return 0;
+out:
+	k_mutex_unlock(&fcb->f_mtx);
+	return rc;
 }
@@ -14,10 +14,14 @@
 
 /*
  * Given offset in flash sector, fill in rest of the fcb_entry, and crc8 over
- * the data.
+ * the data. The element header is read together with the beginning of the
+ * payload; if the endmarker also falls within that first read and fl_emp is
+ * not NULL, the endmarker found in flash is stored there and *fl_em_read is
+ * set, so the caller does not have to read it again.
  */
 static int
-fcb_elem_crc8(struct fcb *_fcb, struct fcb_entry *loc, uint8_t *c8p)
+fcb_elem_crc8(struct fcb *_fcb, struct fcb_entry *loc, uint8_t *c8p,
+	      uint8_t *fl_emp, bool *fl_em_read)
 {
 	uint8_t tmp_str[FCB_TMP_BUF_SZ];
 	int cnt;
@@ -26,16 +30,21 @@ fcb_elem_crc8(struct fcb *_fcb, struct fcb_entry *loc, uint8_t *c8p)
 	uint16_t len;
 	uint32_t off;
 	uint32_t end;
+	uint32_t rd_end;
+	uint32_t em_off;
 	int rc;
 
 	if (loc->fe_elem_off + 2 > loc->fe_sector->fs_size) {
 		return -ENOTSUP;
 	}
 
-	rc = fcb_flash_read(_fcb, loc->fe_sector, loc->fe_elem_off, tmp_str, 2);
+	blk_sz = MIN(sizeof(tmp_str), loc->fe_sector->fs_size - loc->fe_elem_off);
+	rc = fcb_flash_read_ahead(_fcb, loc->fe_sector, loc->fe_elem_off, tmp_str,
+				  blk_sz);
 	if (rc) {
 		return -EIO;
 	}
+	rd_end = loc->fe_elem_off + blk_sz;
 
 	cnt = fcb_get_len(_fcb, tmp_str, &len);
 	if (cnt < 0) {
@@ -49,13 +58,28 @@ fcb_elem_crc8(struct fcb *_fcb, struct fcb_entry *loc, uint8_t *c8p)
 
 	off = loc->fe_data_off;
 	end = loc->fe_data_off + len;
+
+	/* Consume the part of the payload fetched along with the header */
+	if (off < rd_end) {
+		blk_sz = MIN(end, rd_end) - off;
+		crc8 = crc8_ccitt(crc8, &tmp_str[off - loc->fe_elem_off], blk_sz);
+		off += blk_sz;
+	}
+
+	em_off = loc->fe_data_off + fcb_len_in_flash(_fcb, len);
+	if (fl_emp != NULL && em_off < rd_end) {
+		*fl_emp = tmp_str[em_off - loc->fe_elem_off];
+		*fl_em_read = true;
+	}
+
 	for (; off < end; off += blk_sz) {
 		blk_sz = end - off;
 		if (blk_sz > sizeof(tmp_str)) {
 			blk_sz = sizeof(tmp_str);
 		}
 
-		rc = fcb_flash_read(_fcb, loc->fe_sector, off, tmp_str, blk_sz);
+		rc = fcb_flash_read_ahead(_fcb, loc->fe_sector, off, tmp_str,
+					  blk_sz);
 		if (rc) {
 			return -EIO;
 		}
@@ -82,7 +106,8 @@ fcb_elem_endmarker_fixed(struct fcb *_fcb, struct fcb_entry *loc, uint8_t *em)
 		return -ENOTSUP;
 	}
 
-	rc = fcb_flash_read(_fcb, loc->fe_sector, loc->fe_elem_off, tmp_str, 2);
+	rc = fcb_flash_read_ahead(_fcb, loc->fe_sector, loc->fe_elem_off,
+				  tmp_str, 2);
 	if (rc) {
 		return -EIO;
 	}
@@ -100,10 +125,12 @@ fcb_elem_endmarker_fixed(struct fcb *_fcb, struct fcb_entry *loc, uint8_t *em)
 #endif /* IS_ENABLED(CONFIG_FCB_ALLOW_FIXED_ENDMARKER) */
 
 /* Given the offset in flash sector, calculate the FCB entry data offset and size, and calculate
- * the expected endmarker.
+ * the expected endmarker. The endmarker stored in flash is returned as well when it has been
+ * read on the way.
  */
-int
-fcb_elem_endmarker(struct fcb *_fcb, struct fcb_entry *loc, uint8_t *em)
+static int
+fcb_elem_endmarker_fl(struct fcb *_fcb, struct fcb_entry *loc, uint8_t *em,
+		      uint8_t *fl_em, bool *fl_em_read)
 {
 #if IS_ENABLED(CONFIG_FCB_ALLOW_FIXED_ENDMARKER)
 	if (_fcb->f_flags & FCB_FLAGS_CRC_DISABLED) {
@@ -111,7 +138,16 @@ fcb_elem_endmarker(struct fcb *_fcb, struct fcb_entry *loc, uint8_t *em)
 	}
 #endif /* IS_ENABLED(CONFIG_FCB_ALLOW_FIXED_ENDMARKER) */
 
-	return fcb_elem_crc8(_fcb, loc, em);
+	return fcb_elem_crc8(_fcb, loc, em, fl_em, fl_em_read);
+}
+
+/* Given the offset in flash sector, calculate the FCB entry data offset and size, and calculate
+ * the expected endmarker.
+ */
+int
+fcb_elem_endmarker(struct fcb *_fcb, struct fcb_entry *loc, uint8_t *em)
+{
+	return fcb_elem_endmarker_fl(_fcb, loc, em, NULL, NULL);
 }
 
 /* Given the offset in flash sector, calculate the FCB entry data offset and size, and verify that
@@ -122,21 +158,26 @@ int fcb_elem_info(struct fcb *_fcb, struct fcb_entry *loc)
 	int rc;
 	uint8_t em;
 	uint8_t fl_em;
+	bool fl_em_read = false;
 	off_t off;
 
-	rc = fcb_elem_endmarker(_fcb, loc, &em);
+	rc = fcb_elem_endmarker_fl(_fcb, loc, &em, &fl_em, &fl_em_read);
 	if (rc) {
 		return rc;
 	}
-	off = loc->fe_data_off + fcb_len_in_flash(_fcb, loc->fe_data_len);
 
-	rc = fcb_flash_read(_fcb, loc->fe_sector, off, &fl_em, sizeof(fl_em));
-	if (rc) {
-		return -EIO;
+	if (!fl_em_read) {
+		off = loc->fe_data_off + fcb_len_in_flash(_fcb, loc->fe_data_len);
+
+		rc = fcb_flash_read_ahead(_fcb, loc->fe_sector, off, &fl_em,
+					  sizeof(fl_em));
+		if (rc) {
+			return -EIO;
+		}
 	}
 
 	if (IS_ENABLED(CONFIG_FCB_ALLOW_FIXED_ENDMARKER) && (fl_em != em)) {
-		rc = fcb_elem_crc8(_fcb, loc, &em);
+		rc = fcb_elem_crc8(_fcb, loc, &em, NULL, NULL);
 		if (rc) {
 			return rc;
 		}
@@ -64,6 +64,45 @@ const struct flash_area *fcb_open_flash(const struct fcb *fcb);
 uint8_t fcb_get_align(const struct fcb *fcb);
 int fcb_erase_sector(const struct fcb *fcb, const struct flash_sector *sector);
 
+#ifdef CONFIG_FCB_READ_AHEAD
+int fcb_flash_read_ahead(struct fcb *fcb, struct flash_sector *sector,
+			 off_t off, void *dst, size_t len);
+
+static inline void fcb_read_ahead_invalidate(struct fcb *fcb)
+{
+	fcb->f_rd_len = 0U;
+}
+#else
+static inline int fcb_flash_read_ahead(struct fcb *fcb,
+				       struct flash_sector *sector,
+				       off_t off, void *dst, size_t len)
+{
+	return fcb_flash_read(fcb, sector, off, dst, len);
+}
+
+static inline void fcb_read_ahead_invalidate(struct fcb *fcb)
+{
+	ARG_UNUSED(fcb);
+}
+#endif
+
+#ifdef CONFIG_FCB_BACKGROUND_ERASE
+int fcb_erase_sector_async(struct fcb *fcb, struct flash_sector *sector);
+int fcb_erase_wait(struct fcb *fcb);
+#else
+static inline int fcb_erase_sector_async(struct fcb *fcb,
+					 struct flash_sector *sector)
+{
+	return fcb_erase_sector(fcb, sector);
+}
+
+static inline int fcb_erase_wait(struct fcb *fcb)
+{
+	ARG_UNUSED(fcb);
+	return 0;
+}
+#endif
+
 int fcb_getnext_in_sector(struct fcb *fcb, struct fcb_entry *loc);
 struct flash_sector *fcb_getnext_sector(struct fcb *fcb,
 					struct flash_sector *sector);
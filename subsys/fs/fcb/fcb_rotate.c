@@ -19,17 +19,25 @@ fcb_rotate(struct fcb *fcb)
 		return -EINVAL;
 	}
 
-	rc = fcb_erase_sector(fcb, fcb->f_oldest);
+	rc = fcb_erase_sector_async(fcb, fcb->f_oldest);
 	if (rc) {
 		rc = -EIO;
 		goto out;
 	}
+	fcb_read_ahead_invalidate(fcb);
 	if (fcb->f_oldest == fcb->f_active.fe_sector) {
 		/*
 		 * Need to create a new active area, as we're wiping
 		 * the current.
 		 */
 		sector = fcb_getnext_sector(fcb, fcb->f_oldest);
+		if (sector == fcb->f_oldest) {
+			/* Single sector FCB, its erase has to complete first */
+			rc = fcb_erase_wait(fcb);
+			if (rc) {
+				goto out;
+			}
+		}
 		rc = fcb_sector_hdr_init(fcb, sector, fcb->f_active_id + 1);
 		if (rc) {
 			goto out;
@@ -138,22 +138,6 @@ static int cmd_log_backend_status(const struct shell *sh,
 	return 0;
 }
 
-static int module_id_get(const char *name)
-{
-	uint32_t modules_cnt = log_src_cnt_get(Z_LOG_LOCAL_DOMAIN_ID);
-	const char *tmp_name;
-	uint32_t i;
-
-	for (i = 0U; i < modules_cnt; i++) {
-		tmp_name = log_source_name_get(Z_LOG_LOCAL_DOMAIN_ID, i);
-
-		if (strncmp(tmp_name, name, 64) == 0) {
-			return i;
-		}
-	}
-	return -1;
-}
-
 static void filters_set(const struct shell *sh,
 			const struct log_backend *backend,
 			size_t argc, char **argv, uint32_t level)
@@ -168,7 +152,7 @@ static void filters_set(const struct shell *sh,
 	}
 
 	for (i = 0; i < cnt; i++) {
-		id = all ? i : module_id_get(argv[i]);
+		id = all ? i : log_source_id_get(argv[i]);
 		if (id >= 0) {
 			uint32_t set_lvl = log_filter_set(backend,
 						       Z_LOG_LOCAL_DOMAIN_ID,
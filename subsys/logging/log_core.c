@@ -113,6 +113,27 @@ static STRUCT_SECTION_ITERABLE(log_msg_ptr, log_msg_ptr);
 static STRUCT_SECTION_ITERABLE_ALTERNATE(log_mpsc_pbuf, mpsc_pbuf_buffer, log_buffer);
 static struct mpsc_pbuf_buffer *curr_log_buffer;
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+/* CPU 0 uses log_buffer, other CPUs get a dedicated buffer each. */
+#define LOG_CPU_BUFFER_DEFINE(i, _) \
+	COND_CODE_0(i, (), ( \
+		static STRUCT_SECTION_ITERABLE(log_msg_ptr, log_msg_ptr_cpu##i); \
+		static STRUCT_SECTION_ITERABLE_ALTERNATE(log_mpsc_pbuf, mpsc_pbuf_buffer, \
+							 log_buffer_cpu##i);))
+
+#define LOG_CPU_BUFFER_PTR(i, _) \
+	COND_CODE_0(i, (&log_buffer), (&log_buffer_cpu##i))
+
+LISTIFY(CONFIG_MP_MAX_NUM_CPUS, LOG_CPU_BUFFER_DEFINE, ())
+
+static struct mpsc_pbuf_buffer *const cpu_log_buffers[] = {
+	LISTIFY(CONFIG_MP_MAX_NUM_CPUS, LOG_CPU_BUFFER_PTR, (,))
+};
+
+static uint32_t __aligned(Z_LOG_MSG_ALIGNMENT)
+	cpu_buf32[CONFIG_MP_MAX_NUM_CPUS - 1][CONFIG_LOG_BUFFER_SIZE / sizeof(int)];
+#endif
+
 #ifdef CONFIG_MPSC_PBUF
 static uint32_t __aligned(Z_LOG_MSG_ALIGNMENT)
 	buf32[CONFIG_LOG_BUFFER_SIZE / sizeof(int)];
@@ -583,12 +604,93 @@ bool z_log_dropped_pending(void)
 	return dropped_cnt > 0;
 }
 
+#ifdef CONFIG_LOG_RATELIMIT
+bool z_log_ratelimit_check(struct log_ratelimit *rl, const void *source,
+			   uint8_t level, uint32_t burst, uint32_t interval)
+{
+	uint32_t now = sys_clock_tick_get_32();
+	uint32_t limit = burst * interval;
+	atomic_val_t full_at;
+	uint32_t suppressed;
+	uint32_t ahead;
+
+	/* Each message moves the time at which the bucket is full again by one
+	 * interval, it cannot get further than the burst ahead of now.
+	 */
+	do {
+		full_at = atomic_get(&rl->full_at);
+		ahead = (uint32_t)full_at - now;
+		if (ahead > limit) {
+			/* Full since then. */
+			ahead = 0;
+		}
+
+		if ((ahead + interval) > limit) {
+			atomic_inc(&rl->suppressed);
+			return false;
+		}
+	} while (!atomic_cas(&rl->full_at, full_at,
+			     (atomic_val_t)(now + ahead + interval)));
+
+	suppressed = (uint32_t)atomic_clear(&rl->suppressed);
+	if (suppressed > 0) {
+		z_log_msg_runtime_create(Z_LOG_LOCAL_DOMAIN_ID, source, level,
+					 NULL, 0, 0, "%u messages suppressed",
+					 suppressed);
+	}
+
+	return true;
+}
+#endif /* CONFIG_LOG_RATELIMIT */
+
 void z_log_msg_init(void)
 {
 #ifdef CONFIG_MPSC_PBUF
 	mpsc_pbuf_init(&log_buffer, &mpsc_config);
 	curr_log_buffer = &log_buffer;
 #endif
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	for (int i = 1; i < ARRAY_SIZE(cpu_log_buffers); i++) {
+		struct mpsc_pbuf_buffer_config config = mpsc_config;
+
+		config.buf = cpu_buf32[i - 1];
+		mpsc_pbuf_init(cpu_log_buffers[i], &config);
+	}
+#endif
+}
+
+/* Buffer for messages created on the current CPU. */
+static struct mpsc_pbuf_buffer *local_buffer(void)
+{
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	return cpu_log_buffers[arch_curr_cpu()->id];
+#else
+	return &log_buffer;
+#endif
+}
+
+/* Buffer from which message was allocated. Thread may have been moved to
+ * another CPU since the allocation.
+ */
+static struct mpsc_pbuf_buffer *msg_buffer(struct log_msg *msg)
+{
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	for (int i = 1; i < ARRAY_SIZE(cpu_log_buffers); i++) {
+		uint32_t *start = cpu_buf32[i - 1];
+
+		if ((uint32_t *)msg >= start && (uint32_t *)msg < &start[ARRAY_SIZE(cpu_buf32[0])]) {
+			return cpu_log_buffers[i];
+		}
+	}
+#endif
+	return &log_buffer;
+}
+
+/* Messages are spread over multiple buffers and must be merged. */
+static bool multi_buffer(size_t len)
+{
+	return (IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) ||
+		IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFERS)) && (len > 1);
 }
 
 static struct log_msg *msg_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
@@ -603,7 +705,7 @@ static struct log_msg *msg_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
 
 struct log_msg *z_log_msg_alloc(uint32_t wlen)
 {
-	return msg_alloc(&log_buffer, wlen);
+	return msg_alloc(local_buffer(), wlen);
 }
 
 static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
@@ -625,7 +727,7 @@ static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
 void z_log_msg_commit(struct log_msg *msg)
 {
 	msg->hdr.timestamp = timestamp_func();
-	msg_commit(&log_buffer, msg);
+	msg_commit(msg_buffer(msg), msg);
 }
 
 union log_msg_generic *z_log_msg_local_claim(void)
@@ -712,7 +814,7 @@ union log_msg_generic *z_log_msg_claim(k_timeout_t *backoff)
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
 
 	/* Use only one buffer if others are not registered. */
-	if (IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) && len > 1) {
+	if (multi_buffer(len)) {
 		return z_log_msg_claim_oldest(backoff);
 	}
 
@@ -747,7 +849,7 @@ bool z_log_msg_pending(void)
 
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
 
-	if (!IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) || (len == 1)) {
+	if (!multi_buffer(len)) {
 		return msg_pending(&log_buffer);
 	}
 
@@ -829,6 +931,16 @@ int log_mem_get_usage(uint32_t *buf_size, uint32_t *usage)
 
 	mpsc_pbuf_get_utilization(&log_buffer, buf_size, usage);
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	for (int i = 1; i < ARRAY_SIZE(cpu_log_buffers); i++) {
+		uint32_t size, now;
+
+		mpsc_pbuf_get_utilization(cpu_log_buffers[i], &size, &now);
+		*buf_size += size;
+		*usage += now;
+	}
+#endif
+
 	return 0;
 }
 
@@ -840,7 +952,23 @@ int log_mem_get_max_usage(uint32_t *max)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	/* Sum of maximums of all buffers, which may not have peaked together. */
+	*max = 0;
+	for (int i = 0; i < ARRAY_SIZE(cpu_log_buffers); i++) {
+		uint32_t buf_max;
+		int err = mpsc_pbuf_get_max_utilization(cpu_log_buffers[i], &buf_max);
+
+		if (err < 0) {
+			return err;
+		}
+		*max += buf_max;
+	}
+
+	return 0;
+#else
 	return mpsc_pbuf_get_max_utilization(&log_buffer, max);
+#endif
 }
 
 static void log_backend_notify_all(enum log_backend_evt event,
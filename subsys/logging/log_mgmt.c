@@ -360,15 +360,99 @@ void z_log_runtime_filters_init(void)
 	}
 }
 
+/* Character of the source name at given position, in the order used by the
+ * linker to sort the constant data of sources. Data is placed in the
+ * log_const_<name>_ section, where the dot separating module and instance
+ * names is replaced by an underscore.
+ */
+static unsigned char source_sort_char(const char *name, size_t len, size_t i)
+{
+	if (i < len) {
+		return (name[i] == '.') ? '_' : name[i];
+	}
+
+	return (i == len) ? '_' : '\0';
+}
+
+static int source_name_cmp(const void *key, const void *elem)
+{
+	const char *name = key;
+	const char *sname = ((const struct log_source_const_data *)elem)->name;
+	size_t len = strlen(name);
+	size_t slen = strlen(sname);
+
+	for (size_t i = 0; i <= MAX(len, slen); i++) {
+		int diff = source_sort_char(name, len, i) -
+			   source_sort_char(sname, slen, i);
+
+		if (diff != 0) {
+			return diff;
+		}
+	}
+
+	return 0;
+}
+
+static bool sources_sorted(void)
+{
+	/* 0: not checked yet, 1: sorted, -1: not sorted */
+	static int sorted;
+
+	if (sorted == 0) {
+		const struct log_source_const_data *sources =
+			TYPE_SECTION_START(log_const);
+		int res = 1;
+
+		for (uint32_t i = 1; i < z_log_sources_count(); i++) {
+			if (source_name_cmp(sources[i].name, &sources[i - 1]) < 0) {
+				res = -1;
+				break;
+			}
+		}
+
+		sorted = res;
+	}
+
+	return sorted > 0;
+}
+
 int log_source_id_get(const char *name)
 {
-	for (int i = 0; i < log_src_cnt_get(Z_LOG_LOCAL_DOMAIN_ID); i++) {
-		const char *sname = log_source_name_get(Z_LOG_LOCAL_DOMAIN_ID, i);
+	const struct log_source_const_data *sources = TYPE_SECTION_START(log_const);
+	const struct log_source_const_data *source;
+	uint32_t end = z_log_sources_count();
+	uint32_t first = 0;
+
+	/* Without the expected order, all sources are scanned. */
+	if (sources_sorted()) {
+		TYPE_SECTION_BSEARCH(struct log_source_const_data, log_const, name,
+				     source_name_cmp, &source);
+		if (source == NULL) {
+			return -1;
+		}
+
+		/* Names which only differ by a dot or an underscore compare
+		 * equal, the search may have found any of them.
+		 */
+		first = log_const_source_id(source);
+		while ((first > 0) &&
+		       (source_name_cmp(name, &sources[first - 1]) == 0)) {
+			first--;
+		}
 
-		if ((sname != NULL) && (strcmp(sname, name) == 0)) {
+		end = log_const_source_id(source) + 1;
+		while ((end < z_log_sources_count()) &&
+		       (source_name_cmp(name, &sources[end]) == 0)) {
+			end++;
+		}
+	}
+
+	for (uint32_t i = first; i < end; i++) {
+		if (strcmp(sources[i].name, name) == 0) {
 			return i;
 		}
 	}
+
 	return -1;
 }
 
@@ -61,7 +61,8 @@ void z_impl_z_log_msg_static_create(const void *source,
 
 	if (inlen > 0) {
 		uint32_t flags = CBPRINTF_PACKAGE_CONVERT_RW_STR |
-				 CBPRINTF_PACKAGE_CONVERT_PTR_CHECK;
+				 (IS_ENABLED(CONFIG_LOG_FMT_STRING_VALIDATE) ?
+				  CBPRINTF_PACKAGE_CONVERT_PTR_CHECK : 0);
 		uint16_t strl[4];
 		int len;
 
@@ -10,6 +10,8 @@
 #include <zephyr/logging/log_output.h>
 #include <zephyr/logging/log_output_dict.h>
 #include <zephyr/sys/__assert.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/crc.h>
 #include <zephyr/sys/util.h>
 
 static void buffer_write(log_output_func_t outf, uint8_t *buf, size_t len,
@@ -24,6 +26,49 @@ static void buffer_write(log_output_func_t outf, uint8_t *buf, size_t len,
 	} while (len != 0);
 }
 
+/* Returns false if the message is too long to be framed, and must be dropped */
+static bool frame_start(const struct log_output *output, size_t len,
+			uint16_t *crc)
+{
+	if (IS_ENABLED(CONFIG_LOG_DICTIONARY_FRAMING)) {
+		struct log_dict_output_frame_hdr_t hdr = {
+			.sync = { LOG_DICT_OUTPUT_FRAME_SYNC0,
+				  LOG_DICT_OUTPUT_FRAME_SYNC1 },
+		};
+
+		__ASSERT(len <= UINT16_MAX, "Message too long to be framed");
+		if (len > UINT16_MAX) {
+			return false;
+		}
+
+		sys_put_le16(len, (uint8_t *)&hdr.len);
+		*crc = 0xffff;
+		buffer_write(output->func, (uint8_t *)&hdr, sizeof(hdr),
+			     (void *)output);
+	}
+
+	return true;
+}
+
+static void frame_write(const struct log_output *output, uint8_t *buf,
+			size_t len, uint16_t *crc)
+{
+#ifdef CONFIG_LOG_DICTIONARY_FRAMING
+	*crc = crc16_ccitt(*crc, buf, len);
+#endif
+	buffer_write(output->func, buf, len, (void *)output);
+}
+
+static void frame_end(const struct log_output *output, uint16_t crc)
+{
+	if (IS_ENABLED(CONFIG_LOG_DICTIONARY_FRAMING)) {
+		uint8_t buf[sizeof(crc)];
+
+		sys_put_le16(crc, buf);
+		buffer_write(output->func, buf, sizeof(buf), (void *)output);
+	}
+}
+
 void log_dict_output_msg_process(const struct log_output *output,
 				 struct log_msg *msg, uint32_t flags)
 {
@@ -44,21 +89,27 @@ void log_dict_output_msg_process(const struct log_output *output,
 					log_const_source_id(source)) :
 				0U;
 
-	buffer_write(output->func, (uint8_t *)&output_hdr, sizeof(output_hdr),
-		     (void *)output);
+	uint16_t crc = 0;
+
+	if (!frame_start(output, sizeof(output_hdr) + output_hdr.package_len +
+			 output_hdr.data_len, &crc)) {
+		return;
+	}
+	frame_write(output, (uint8_t *)&output_hdr, sizeof(output_hdr), &crc);
 
 	size_t len;
 	uint8_t *data = log_msg_get_package(msg, &len);
 
 	if (len > 0U) {
-		buffer_write(output->func, data, len, (void *)output);
+		frame_write(output, data, len, &crc);
 	}
 
 	data = log_msg_get_data(msg, &len);
 	if (len > 0U) {
-		buffer_write(output->func, data, len, (void *)output);
+		frame_write(output, data, len, &crc);
 	}
 
+	frame_end(output, crc);
 	log_output_flush(output);
 }
 
@@ -69,6 +120,9 @@ void log_dict_output_dropped_process(const struct log_output *output, uint32_t c
 	msg.type = MSG_DROPPED_MSG;
 	msg.num_dropped_messages = MIN(cnt, 9999);
 
-	buffer_write(output->func, (uint8_t *)&msg, sizeof(msg),
-		     (void *)output);
+	uint16_t crc = 0;
+
+	(void)frame_start(output, sizeof(msg), &crc);
+	frame_write(output, (uint8_t *)&msg, sizeof(msg), &crc);
+	frame_end(output, crc);
 }
@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <cmsis_core.h>
+#include "../perf_backend.h"
+
+/* Index of the return address in the basic exception stack frame */
+#define PERF_ESF_PC 6
+
+size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size)
+{
+	uint32_t *esf;
+
+	ARG_UNUSED(size);
+
+#if defined(CONFIG_ARMV7_M_ARMV8_M_MAINLINE)
+	/* The frame of an interrupted exception handler is on the main stack */
+	if ((SCB->ICSR & SCB_ICSR_RETTOBASE_Msk) == 0) {
+		return 0;
+	}
+#endif
+
+	/* Threads, including the idle thread, run on the process stack */
+	esf = (uint32_t *)__get_PSP();
+	buf[0] = esf[PERF_ESF_PC];
+
+	return 1;
+}
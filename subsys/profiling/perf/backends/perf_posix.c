@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include "../perf_backend.h"
+
+/* Frames further apart are assumed to belong to a corrupted chain */
+#define MAX_FRAME_SIZE (64 * 1024)
+
+/*
+ * Interrupts are only taken when the simulated CPU lets time pass, on the
+ * host stack of the interrupted thread. The interrupted code is found by
+ * walking up the frames of the interrupt handling code, which are left for
+ * the host side tools to strip.
+ */
+size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size)
+{
+	uintptr_t *fp = __builtin_frame_address(0);
+	size_t depth = 0;
+
+	while (depth < size && fp != NULL) {
+		uintptr_t *next = (uintptr_t *)fp[0];
+
+		buf[depth++] = fp[1];
+
+		if (next <= fp || (uintptr_t)next - (uintptr_t)fp > MAX_FRAME_SIZE) {
+			break;
+		}
+		fp = next;
+	}
+
+	return depth;
+}
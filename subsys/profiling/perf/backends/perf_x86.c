@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include "../perf_backend.h"
+
+/*
+ * Layout of the interrupted thread stack after _interrupt_enter saved its
+ * registers, see arch/x86/core/ia32/intstub.S.
+ */
+struct perf_x86_isf {
+	uint32_t edi;
+	uint32_t ecx;
+	uint32_t edx;
+	uint32_t eax;
+	uint32_t eip;
+	uint32_t cs;
+	uint32_t eflags;
+};
+
+static bool perf_on_irq_stack(uintptr_t addr)
+{
+	uintptr_t top = (uintptr_t)_current_cpu->irq_stack;
+
+	return addr < top && addr >= top - CONFIG_ISR_STACK_SIZE;
+}
+
+size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size)
+{
+	struct perf_x86_isf *isf;
+	size_t depth = 0;
+
+	/* Nested interrupts do not save the interrupted context in a known place */
+	if (_current_cpu->nested != 1) {
+		return 0;
+	}
+
+	/* _interrupt_enter saves the thread stack pointer at the base of the IRQ stack */
+	isf = ((struct perf_x86_isf **)_current_cpu->irq_stack)[-1];
+	buf[depth++] = isf->eip;
+
+#ifdef CONFIG_PROFILING_PERF_CALL_STACK
+	uintptr_t *fp = __builtin_frame_address(0);
+
+	/* The first frame pushed on the IRQ stack holds the interrupted EBP */
+	while (fp != NULL && perf_on_irq_stack((uintptr_t)fp)) {
+		fp = (uintptr_t *)fp[0];
+	}
+
+	while (depth < size && fp != NULL) {
+		uintptr_t *next = (uintptr_t *)fp[0];
+
+#ifdef CONFIG_THREAD_STACK_INFO
+		if ((uintptr_t)fp < _current->stack_info.start ||
+		    (uintptr_t)fp >= _current->stack_info.start +
+				      _current->stack_info.size) {
+			break;
+		}
+#endif
+		buf[depth++] = fp[1];
+
+		if (next <= fp) {
+			break;
+		}
+		fp = next;
+	}
+#endif /* CONFIG_PROFILING_PERF_CALL_STACK */
+
+	return depth;
+}
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/profiling/perf.h>
+#include "perf_backend.h"
+
+#ifdef CONFIG_PROFILING_PERF_CALL_STACK
+#define PERF_STACK_DEPTH CONFIG_PROFILING_PERF_STACK_DEPTH
+#else
+#define PERF_STACK_DEPTH 1
+#endif
+
+struct perf_cpu_data {
+	uintptr_t buf[CONFIG_PROFILING_PERF_BUFFER_SIZE];
+	/* Number of words used in buf */
+	uint32_t used;
+	uint32_t samples;
+	uint32_t dropped;
+};
+
+static struct perf_cpu_data perf_data[CONFIG_MP_MAX_NUM_CPUS];
+static uint32_t perf_frequency;
+static atomic_t perf_running;
+
+/* Runs in the system clock interrupt, on the CPU taking it */
+static void perf_sample(struct k_timer *timer)
+{
+	struct perf_cpu_data *data = &perf_data[_current_cpu->id];
+	uint32_t room = ARRAY_SIZE(data->buf) - data->used;
+	size_t depth;
+
+	ARG_UNUSED(timer);
+
+	if (room < 2) {
+		data->dropped++;
+		return;
+	}
+
+	depth = arch_perf_current_stack_trace(&data->buf[data->used + 1],
+					      MIN(room - 1, PERF_STACK_DEPTH));
+	if (depth == 0) {
+		return;
+	}
+
+	data->buf[data->used] = depth;
+	data->used += depth + 1;
+	data->samples++;
+}
+
+static void perf_duration_expired(struct k_timer *timer);
+
+static K_TIMER_DEFINE(perf_sample_timer, perf_sample, NULL);
+static K_TIMER_DEFINE(perf_duration_timer, perf_duration_expired, NULL);
+
+static void perf_duration_expired(struct k_timer *timer)
+{
+	ARG_UNUSED(timer);
+
+	(void)perf_stop();
+}
+
+int perf_start(uint32_t frequency, k_timeout_t duration)
+{
+	k_timeout_t period;
+
+	if (frequency == 0 || frequency > CONFIG_SYS_CLOCK_TICKS_PER_SEC) {
+		return -EINVAL;
+	}
+
+	if (!atomic_cas(&perf_running, 0, 1)) {
+		return -EALREADY;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(perf_data); i++) {
+		perf_data[i].used = 0;
+		perf_data[i].samples = 0;
+		perf_data[i].dropped = 0;
+	}
+
+	perf_frequency = frequency;
+	period = K_TICKS(CONFIG_SYS_CLOCK_TICKS_PER_SEC / frequency);
+
+	if (!K_TIMEOUT_EQ(duration, K_FOREVER)) {
+		k_timer_start(&perf_duration_timer, duration, K_NO_WAIT);
+	}
+	k_timer_start(&perf_sample_timer, period, period);
+
+	return 0;
+}
+
+int perf_stop(void)
+{
+	if (!atomic_cas(&perf_running, 1, 0)) {
+		return -EALREADY;
+	}
+
+	k_timer_stop(&perf_sample_timer);
+	k_timer_stop(&perf_duration_timer);
+
+	return 0;
+}
+
+bool perf_is_running(void)
+{
+	return atomic_get(&perf_running) != 0;
+}
+
+void perf_stats_get(unsigned int cpu, struct perf_dump_cpu_header *stats)
+{
+	struct perf_cpu_data *data = &perf_data[cpu];
+
+	stats->cpu = cpu;
+	stats->samples = data->samples;
+	stats->dropped = data->dropped;
+	stats->words = data->used;
+}
+
+int perf_dump(perf_dump_cb_t cb, void *user_data)
+{
+	struct perf_dump_header header = {
+		.magic = PERF_DUMP_MAGIC,
+		.version = PERF_DUMP_VERSION,
+		.word_size = sizeof(uintptr_t),
+		.num_cpus = arch_num_cpus(),
+		.frequency = perf_frequency,
+	};
+
+	if (perf_is_running()) {
+		return -EBUSY;
+	}
+
+	cb((const uint8_t *)&header, sizeof(header), user_data);
+
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+		struct perf_cpu_data *data = &perf_data[cpu];
+		struct perf_dump_cpu_header cpu_header;
+
+		perf_stats_get(cpu, &cpu_header);
+		cb((const uint8_t *)&cpu_header, sizeof(cpu_header), user_data);
+		if (data->used > 0) {
+			cb((const uint8_t *)data->buf,
+			   data->used * sizeof(data->buf[0]), user_data);
+		}
+	}
+
+	return 0;
+}
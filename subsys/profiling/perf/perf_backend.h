@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_SUBSYS_PROFILING_PERF_PERF_BACKEND_H_
+#define ZEPHYR_SUBSYS_PROFILING_PERF_PERF_BACKEND_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Called from the system clock interrupt to sample the interrupted context.
+ * Fills buf with the interrupted program counter followed by up to size - 1
+ * return addresses of the call stack, and returns the number of frames
+ * written. Returns 0 if the interrupted context cannot be sampled.
+ */
+size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size);
+
+#endif /* ZEPHYR_SUBSYS_PROFILING_PERF_PERF_BACKEND_H_ */
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/profiling/perf.h>
+
+#define PERF_PREFIX_STR "#PERF:"
+#define PERF_BEGIN_STR "BEGIN#"
+#define PERF_END_STR "END#"
+
+/* Bytes printed on each line of a dump */
+#define PERF_LINE_BYTES 32
+
+struct perf_shell_dump {
+	const struct shell *sh;
+	char line[2 * PERF_LINE_BYTES + 1];
+	size_t len;
+};
+
+static void perf_shell_dump_flush(struct perf_shell_dump *dump)
+{
+	if (dump->len > 0) {
+		dump->line[dump->len] = '\0';
+		shell_print(dump->sh, PERF_PREFIX_STR "%s", dump->line);
+		dump->len = 0;
+	}
+}
+
+static void perf_shell_dump_cb(const uint8_t *data, size_t len, void *user_data)
+{
+	struct perf_shell_dump *dump = user_data;
+
+	for (size_t i = 0; i < len; i++) {
+		dump->len += bin2hex(&data[i], 1, &dump->line[dump->len],
+				     sizeof(dump->line) - dump->len);
+		if (dump->len == 2 * PERF_LINE_BYTES) {
+			perf_shell_dump_flush(dump);
+		}
+	}
+}
+
+static int cmd_perf_record(const struct shell *sh, size_t argc, char **argv)
+{
+	uint32_t duration = strtoul(argv[1], NULL, 10);
+	uint32_t frequency = CONFIG_SYS_CLOCK_TICKS_PER_SEC;
+	int rc;
+
+	if (argc > 2) {
+		frequency = strtoul(argv[2], NULL, 10);
+	}
+
+	rc = perf_start(frequency, K_MSEC(duration));
+	if (rc == -EINVAL) {
+		shell_error(sh, "Frequency must be between 1 and %u Hz",
+			    CONFIG_SYS_CLOCK_TICKS_PER_SEC);
+	} else if (rc == -EALREADY) {
+		shell_error(sh, "Already recording");
+	} else {
+		shell_print(sh, "Recording for %u ms at %u Hz", duration,
+			    frequency);
+	}
+
+	return rc;
+}
+
+static int cmd_perf_stop(const struct shell *sh, size_t argc, char **argv)
+{
+	int rc = perf_stop();
+
+	if (rc != 0) {
+		shell_error(sh, "Not recording");
+	}
+
+	return rc;
+}
+
+static int cmd_perf_status(const struct shell *sh, size_t argc, char **argv)
+{
+	struct perf_dump_cpu_header stats;
+
+	shell_print(sh, "%s", perf_is_running() ? "Recording" : "Stopped");
+
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+		perf_stats_get(cpu, &stats);
+		shell_print(sh, "CPU %u: %u samples, %u dropped, %u words used",
+			    cpu, stats.samples, stats.dropped, stats.words);
+	}
+
+	return 0;
+}
+
+static int cmd_perf_dump(const struct shell *sh, size_t argc, char **argv)
+{
+	struct perf_shell_dump dump = { .sh = sh };
+	int rc;
+
+	if (perf_is_running()) {
+		shell_error(sh, "Recording, stop it first");
+		return -EBUSY;
+	}
+
+	shell_print(sh, PERF_PREFIX_STR PERF_BEGIN_STR);
+	rc = perf_dump(perf_shell_dump_cb, &dump);
+	perf_shell_dump_flush(&dump);
+	shell_print(sh, PERF_PREFIX_STR PERF_END_STR);
+
+	return rc;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_perf,
+	SHELL_CMD_ARG(record, NULL,
+		      "Record samples\n"
+		      "Usage: record <duration ms> [frequency Hz]",
+		      cmd_perf_record, 2, 1),
+	SHELL_CMD(stop, NULL, "Stop recording", cmd_perf_stop),
+	SHELL_CMD(status, NULL, "Show the number of recorded samples",
+		  cmd_perf_status),
+	SHELL_CMD(dump, NULL,
+		  "Dump recorded samples for scripts/profiling/stackcollapse.py",
+		  cmd_perf_dump),
+	SHELL_SUBCMD_SET_END /* Array terminated. */
+);
+
+SHELL_CMD_REGISTER(perf, &sub_perf, "Sampling profiler", NULL);
@@ -181,6 +181,124 @@ static void uart_callback(const struct device *dev, void *user_data)
 }
 #endif /* CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN */
 
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC
+static void async_rx_handle(const struct shell_uart *sh_uart,
+			    const uint8_t *data, size_t len)
+{
+	uint32_t put;
+
+#ifdef CONFIG_MCUMGR_TRANSPORT_SHELL
+	/* Divert bytes from shell handling if they are part of an mcumgr
+	 * frame.
+	 */
+	size_t i = smp_shell_rx_bytes(&sh_uart->ctrl_blk->smp, data, len);
+
+	data += i;
+	len -= i;
+#endif /* CONFIG_MCUMGR_TRANSPORT_SHELL */
+
+	put = ring_buf_put(sh_uart->rx_ringbuf, data, len);
+	if (put < len) {
+		LOG_WRN("RX ring buffer full.");
+	}
+
+	sh_uart->ctrl_blk->handler(SHELL_TRANSPORT_EVT_RX_RDY,
+				   sh_uart->ctrl_blk->context);
+}
+
+static int async_rx_enable(const struct shell_uart *sh_uart)
+{
+	struct shell_uart_ctrl_blk *ctrl_blk = sh_uart->ctrl_blk;
+
+	ctrl_blk->rx_buf_idx = 1;
+
+	return uart_rx_enable(ctrl_blk->dev, ctrl_blk->rx_bufs[0],
+			      sizeof(ctrl_blk->rx_bufs[0]),
+			      CONFIG_SHELL_BACKEND_SERIAL_ASYNC_RX_TIMEOUT);
+}
+
+/* Send everything queued in the TX ring buffer up to its end with one
+ * transfer.
+ */
+static bool async_tx_start(const struct shell_uart *sh_uart)
+{
+	struct shell_uart_ctrl_blk *ctrl_blk = sh_uart->ctrl_blk;
+	uint8_t *data;
+	int err;
+
+	ctrl_blk->tx_len = ring_buf_get_claim(sh_uart->tx_ringbuf, &data,
+					      sh_uart->tx_ringbuf->size);
+	if (ctrl_blk->tx_len == 0) {
+		return false;
+	}
+
+	err = uart_tx(ctrl_blk->dev, data, ctrl_blk->tx_len, SYS_FOREVER_US);
+	if (err != 0) {
+		LOG_ERR("TX failed: %d", err);
+		(void)ring_buf_get_finish(sh_uart->tx_ringbuf, ctrl_blk->tx_len);
+		return false;
+	}
+
+	return true;
+}
+
+/* Called by the owner of the tx_busy flag, releases it once there is
+ * nothing left to send.
+ */
+static void async_tx_kick(const struct shell_uart *sh_uart)
+{
+	struct shell_uart_ctrl_blk *ctrl_blk = sh_uart->ctrl_blk;
+
+	do {
+		if (!ctrl_blk->blocking_tx && async_tx_start(sh_uart)) {
+			return;
+		}
+
+		atomic_clear(&ctrl_blk->tx_busy);
+
+		/* Data may have been queued after the ring buffer was found
+		 * empty and before the flag was cleared.
+		 */
+	} while (!ctrl_blk->blocking_tx &&
+		 !ring_buf_is_empty(sh_uart->tx_ringbuf) &&
+		 atomic_cas(&ctrl_blk->tx_busy, 0, 1));
+}
+
+static void async_callback(const struct device *dev, struct uart_event *evt,
+			   void *user_data)
+{
+	const struct shell_uart *sh_uart = (struct shell_uart *)user_data;
+	struct shell_uart_ctrl_blk *ctrl_blk = sh_uart->ctrl_blk;
+
+	switch (evt->type) {
+	case UART_TX_DONE:
+	case UART_TX_ABORTED:
+		/* Aborted data is dropped, as a blocking write follows */
+		(void)ring_buf_get_finish(sh_uart->tx_ringbuf, ctrl_blk->tx_len);
+		async_tx_kick(sh_uart);
+		ctrl_blk->handler(SHELL_TRANSPORT_EVT_TX_RDY, ctrl_blk->context);
+		break;
+	case UART_RX_RDY:
+		async_rx_handle(sh_uart, &evt->data.rx.buf[evt->data.rx.offset],
+				evt->data.rx.len);
+		break;
+	case UART_RX_BUF_REQUEST:
+		(void)uart_rx_buf_rsp(dev, ctrl_blk->rx_bufs[ctrl_blk->rx_buf_idx],
+				      sizeof(ctrl_blk->rx_bufs[0]));
+		ctrl_blk->rx_buf_idx ^= 1;
+		break;
+	case UART_RX_DISABLED:
+		/* Reception stops on line errors, resume it */
+		if (!ctrl_blk->rx_stop) {
+			(void)async_rx_enable(sh_uart);
+		}
+		break;
+	default:
+		break;
+	}
+}
+#endif /* CONFIG_SHELL_BACKEND_SERIAL_ASYNC */
+
 static void uart_irq_init(const struct shell_uart *sh_uart)
 {
 #ifdef CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN
@@ -199,6 +317,37 @@ static void uart_irq_init(const struct shell_uart *sh_uart)
 #endif
 }
 
+static void async_init(const struct shell_uart *sh_uart)
+{
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC
+	struct shell_uart_ctrl_blk *ctrl_blk = sh_uart->ctrl_blk;
+	int err;
+
+	ring_buf_reset(sh_uart->tx_ringbuf);
+	ring_buf_reset(sh_uart->rx_ringbuf);
+	ctrl_blk->tx_busy = 0;
+	ctrl_blk->rx_stop = false;
+
+	err = uart_callback_set(ctrl_blk->dev, async_callback, (void *)sh_uart);
+	if (err == 0) {
+		err = async_rx_enable(sh_uart);
+	}
+
+	if (err != 0) {
+		LOG_ERR("Failed to enable asynchronous API: %d", err);
+	}
+#endif
+}
+
+static void async_uninit(const struct shell_uart *sh_uart)
+{
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC
+	sh_uart->ctrl_blk->rx_stop = true;
+	(void)uart_rx_disable(sh_uart->ctrl_blk->dev);
+	(void)uart_tx_abort(sh_uart->ctrl_blk->dev);
+#endif
+}
+
 static void timer_handler(struct k_timer *timer)
 {
 	uint8_t c;
@@ -232,6 +381,8 @@ static int init(const struct shell_transport *transport,
 
 	if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN)) {
 		uart_irq_init(sh_uart);
+	} else if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_ASYNC)) {
+		async_init(sh_uart);
 	} else {
 		k_timer_init(sh_uart->timer, timer_handler, NULL);
 		k_timer_user_data_set(sh_uart->timer, (void *)sh_uart);
@@ -251,6 +402,8 @@ static int uninit(const struct shell_transport *transport)
 		k_timer_stop(sh_uart->dtr_timer);
 		uart_irq_tx_disable(dev);
 		uart_irq_rx_disable(dev);
+	} else if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_ASYNC)) {
+		async_uninit(sh_uart);
 	} else {
 		k_timer_stop(sh_uart->timer);
 	}
@@ -267,6 +420,8 @@ static int enable(const struct shell_transport *transport, bool blocking_tx)
 	if (blocking_tx) {
 #ifdef CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN
 		uart_irq_tx_disable(sh_uart->ctrl_blk->dev);
+#elif defined(CONFIG_SHELL_BACKEND_SERIAL_ASYNC)
+		(void)uart_tx_abort(sh_uart->ctrl_blk->dev);
 #endif
 	}
 
@@ -281,6 +436,8 @@ static void irq_write(const struct shell_uart *sh_uart, const void *data,
 	if (atomic_set(&sh_uart->ctrl_blk->tx_busy, 1) == 0) {
 #ifdef CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN
 		uart_irq_tx_enable(sh_uart->ctrl_blk->dev);
+#elif defined(CONFIG_SHELL_BACKEND_SERIAL_ASYNC)
+		async_tx_kick(sh_uart);
 #endif
 	}
 }
@@ -291,7 +448,8 @@ static int write(const struct shell_transport *transport,
 	const struct shell_uart *sh_uart = (struct shell_uart *)transport->ctx;
 	const uint8_t *data8 = (const uint8_t *)data;
 
-	if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN) &&
+	if ((IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN) ||
+	     IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_ASYNC)) &&
 		!sh_uart->ctrl_blk->blocking_tx) {
 		irq_write(sh_uart, data, length, cnt);
 	} else {
@@ -276,6 +276,108 @@ static int cmd_kernel_stacks(const struct shell *sh,
 }
 #endif
 
+#if defined(CONFIG_SCHED_THREAD_USAGE_HISTOGRAM) || \
+	defined(CONFIG_SCHED_ISR_USAGE_HISTOGRAM)
+/* Print the non-empty buckets as <upper bound in cycles>:<count> */
+static void shell_histogram_print(const struct shell *sh, const char *name,
+				  const uint32_t *hist)
+{
+	bool empty = true;
+
+	shell_fprintf(sh, SHELL_NORMAL, "\t%s:", name);
+
+	for (int i = 0; i < CONFIG_SCHED_USAGE_HISTOGRAM_BUCKETS; i++) {
+		if (hist[i] == 0) {
+			continue;
+		}
+
+		empty = false;
+		if (i == CONFIG_SCHED_USAGE_HISTOGRAM_BUCKETS - 1) {
+			shell_fprintf(sh, SHELL_NORMAL, " >=%llu:%u",
+				      BIT64(i - 1), hist[i]);
+		} else {
+			shell_fprintf(sh, SHELL_NORMAL, " <%llu:%u",
+				      BIT64(i), hist[i]);
+		}
+	}
+
+	shell_fprintf(sh, SHELL_NORMAL, "%s\n", empty ? " -" : "");
+}
+#endif
+
+#if defined(CONFIG_SCHED_THREAD_USAGE_HISTOGRAM) && defined(CONFIG_THREAD_MONITOR)
+static void shell_thread_histograms(const struct k_thread *cthread,
+				    void *user_data)
+{
+	struct k_thread *thread = (struct k_thread *)cthread;
+	const struct shell *sh = (const struct shell *)user_data;
+	k_thread_runtime_stats_t stats;
+	const char *tname = k_thread_name_get(thread);
+
+	if (k_thread_runtime_stats_get(thread, &stats) != 0) {
+		return;
+	}
+
+	shell_print(sh, "%p %-10s", thread, tname ? tname : "NA");
+	shell_histogram_print(sh, "run cycles", stats.run_histogram);
+	shell_histogram_print(sh, "latency cycles", stats.latency_histogram);
+}
+#endif
+
+#if defined(CONFIG_SCHED_THREAD_USAGE_HISTOGRAM) || \
+	defined(CONFIG_SCHED_ISR_USAGE_HISTOGRAM)
+static int cmd_kernel_histograms(const struct shell *sh,
+				 size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+#ifdef CONFIG_SCHED_THREAD_USAGE_HISTOGRAM
+#ifdef CONFIG_THREAD_MONITOR
+	shell_print(sh, "Threads:");
+#ifdef CONFIG_SMP
+	k_thread_foreach_unlocked(shell_thread_histograms, (void *)sh);
+#else
+	k_thread_foreach(shell_thread_histograms, (void *)sh);
+#endif
+#endif
+
+#ifdef CONFIG_SCHED_THREAD_USAGE_ALL
+	k_thread_runtime_stats_t stats;
+
+	if (k_thread_runtime_stats_all_get(&stats) == 0) {
+		shell_print(sh, "All CPUs:");
+		shell_histogram_print(sh, "run cycles", stats.run_histogram);
+		shell_histogram_print(sh, "latency cycles",
+				      stats.latency_histogram);
+	}
+#endif
+#endif
+
+#ifdef CONFIG_SCHED_ISR_USAGE_HISTOGRAM
+	uint32_t hist[CONFIG_SCHED_USAGE_HISTOGRAM_BUCKETS];
+	char name[16];
+
+	shell_print(sh, "IRQs:");
+	for (unsigned int irq = 0; irq < CONFIG_NUM_IRQS; irq++) {
+		bool empty = true;
+
+		(void)k_isr_usage_histogram_get(irq, hist);
+		for (int i = 0; i < ARRAY_SIZE(hist); i++) {
+			empty = empty && (hist[i] == 0);
+		}
+
+		if (!empty) {
+			snprintk(name, sizeof(name), "IRQ %u cycles", irq);
+			shell_histogram_print(sh, name, hist);
+		}
+	}
+#endif
+
+	return 0;
+}
+#endif
+
 #if defined(CONFIG_SYS_HEAP_RUNTIME_STATS) && (CONFIG_HEAP_MEM_POOL_SIZE > 0)
 extern struct sys_heap _system_heap;
 
@@ -402,6 +504,11 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel,
 #endif
 #if defined(CONFIG_SYS_HEAP_RUNTIME_STATS) && (CONFIG_HEAP_MEM_POOL_SIZE > 0)
 	SHELL_CMD(heap, NULL, "System heap usage statistics.", cmd_kernel_heap),
+#endif
+#if defined(CONFIG_SCHED_THREAD_USAGE_HISTOGRAM) || \
+	defined(CONFIG_SCHED_ISR_USAGE_HISTOGRAM)
+	SHELL_CMD(histograms, NULL, "Thread run length, wakeup latency and ISR duration histograms.",
+		  cmd_kernel_histograms),
 #endif
 	SHELL_CMD_ARG(uptime, NULL, "Kernel uptime. Can be called with the -p or --pretty options",
 		      cmd_kernel_uptime, 1, 1),
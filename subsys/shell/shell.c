@@ -329,13 +329,17 @@ static void find_completion_candidates(const struct shell *sh,
 	const struct shell_static_entry *candidate;
 	struct shell_static_entry dloc;
 	size_t incompl_cmd_len;
-	size_t idx = 0;
+	size_t idx;
+	size_t end;
 
 	incompl_cmd_len = z_shell_strlen(incompl_cmd);
 	*longest = 0U;
 	*cnt = 0;
 
-	while ((candidate = z_shell_cmd_get(cmd, idx, &dloc)) != NULL) {
+	z_shell_cmd_prefix_range(cmd, incompl_cmd, &idx, &end);
+
+	while ((idx < end) &&
+	       ((candidate = z_shell_cmd_get(cmd, idx, &dloc)) != NULL)) {
 		bool is_candidate;
 		is_candidate = is_completion_candidate(candidate->syntax,
 						incompl_cmd, incompl_cmd_len);
@@ -266,12 +266,104 @@ static inline uint32_t shell_root_cmd_count(void)
 	return len;
 }
 
+#ifdef CONFIG_SHELL_ROOT_CMD_BSEARCH
+/* Compare the root command syntax with the first len characters of str,
+ * including the terminating character if full is set.
+ *
+ * The linker sorts root commands by section name, which ends with the syntax
+ * followed by an underscore, so the same underscore is appended to the syntax
+ * and, for a full comparison, to str.
+ */
+static int root_cmd_cmp(const char *syntax, const char *str, size_t len,
+			bool full)
+{
+	size_t syntax_len = strlen(syntax);
+	size_t n = full ? len + 1 : len;
+
+	for (size_t i = 0; i < n; i++) {
+		char c1 = (i < syntax_len) ? syntax[i] :
+			  ((i == syntax_len) ? '_' : '\0');
+		char c2 = (i < len) ? str[i] : '_';
+
+		if (c1 != c2) {
+			return (unsigned char)c1 - (unsigned char)c2;
+		}
+	}
+
+	return (full && (syntax_len + 1 > n)) ? 1 : 0;
+}
+
+static bool root_cmds_sorted(void)
+{
+	/* 0: not checked yet, 1: sorted, -1: not sorted */
+	static int sorted;
+
+	if (sorted == 0) {
+		const size_t cmd_count = shell_root_cmd_count();
+		int res = 1;
+
+		for (size_t idx = 1; idx < cmd_count; idx++) {
+			const char *prev = shell_root_cmd_get(idx - 1)->entry->syntax;
+			const char *syntax = shell_root_cmd_get(idx)->entry->syntax;
+
+			if (root_cmd_cmp(prev, syntax, strlen(syntax), true) >= 0) {
+				res = -1;
+				break;
+			}
+		}
+
+		sorted = res;
+	}
+
+	return sorted > 0;
+}
+
+/* Returns the index of the first root command which does not compare lower
+ * than str, or greater if upper is set.
+ */
+static size_t root_cmd_bound(const char *str, size_t len, bool full, bool upper)
+{
+	size_t lo = 0;
+	size_t hi = shell_root_cmd_count();
+
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		int res = root_cmd_cmp(shell_root_cmd_get(mid)->entry->syntax,
+				       str, len, full);
+
+		if ((res < 0) || (upper && (res == 0))) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+#endif /* CONFIG_SHELL_ROOT_CMD_BSEARCH */
+
 /* Function returning pointer to parent command matching requested syntax. */
 const struct shell_static_entry *root_cmd_find(const char *syntax)
 {
 	const size_t cmd_count = shell_root_cmd_count();
 	const union shell_cmd_entry *cmd;
 
+#ifdef CONFIG_SHELL_ROOT_CMD_BSEARCH
+	if (root_cmds_sorted()) {
+		size_t len = strlen(syntax);
+		size_t cmd_idx = root_cmd_bound(syntax, len, true, false);
+
+		if (cmd_idx < cmd_count) {
+			cmd = shell_root_cmd_get(cmd_idx);
+			if (root_cmd_cmp(cmd->entry->syntax, syntax, len, true) == 0) {
+				return cmd->entry;
+			}
+		}
+
+		return NULL;
+	}
+#endif
+
 	for (size_t cmd_idx = 0; cmd_idx < cmd_count; ++cmd_idx) {
 		cmd = shell_root_cmd_get(cmd_idx);
 		if (strcmp(syntax, cmd->entry->syntax) == 0) {
@@ -282,6 +374,23 @@ const struct shell_static_entry *root_cmd_find(const char *syntax)
 	return NULL;
 }
 
+void z_shell_cmd_prefix_range(const struct shell_static_entry *parent,
+			      const char *prefix, size_t *first, size_t *end)
+{
+#ifdef CONFIG_SHELL_ROOT_CMD_BSEARCH
+	if ((parent == NULL) && root_cmds_sorted()) {
+		size_t len = z_shell_strlen(prefix);
+
+		*first = root_cmd_bound(prefix, len, false, false);
+		*end = root_cmd_bound(prefix, len, false, true);
+		return;
+	}
+#endif
+
+	*first = 0;
+	*end = SIZE_MAX;
+}
+
 const struct shell_static_entry *z_shell_cmd_get(
 					const struct shell_static_entry *parent,
 					size_t idx,
@@ -352,6 +461,8 @@ const struct shell_static_entry *z_shell_find_cmd(
 	if (parent) {
 		memcpy(&parent_cpy, parent, sizeof(struct shell_static_entry));
 		parent = &parent_cpy;
+	} else if (IS_ENABLED(CONFIG_SHELL_ROOT_CMD_BSEARCH)) {
+		return root_cmd_find(cmd_str);
 	}
 
 	while ((entry = z_shell_cmd_get(parent, idx++, dloc)) != NULL) {
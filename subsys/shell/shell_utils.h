@@ -53,6 +53,20 @@ const struct shell_static_entry *z_shell_cmd_get(
 					size_t idx,
 					struct shell_static_entry *dloc);
 
+/** @brief Get range of subcommand indexes which may start with a prefix.
+ *
+ * Subcommands out of the range do not start with the prefix, the ones in the
+ * range still need to be checked. The end of the range is SIZE_MAX if it is
+ * not known.
+ *
+ * @param parent	Parent entry. Null for root commands.
+ * @param prefix	Prefix of the subcommands.
+ * @param first		Location to write the first index of the range.
+ * @param end		Location to write the index after the range.
+ */
+void z_shell_cmd_prefix_range(const struct shell_static_entry *parent,
+			      const char *prefix, size_t *first, size_t *end);
+
 const struct shell_static_entry *z_shell_find_cmd(
 					const struct shell_static_entry *parent,
 					const char *cmd_str,
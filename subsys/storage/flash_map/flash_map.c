@@ -60,7 +60,11 @@ int flash_area_read(const struct flash_area *fa, off_t off, void *dst,
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_FLASH_MAP_CACHE
+	return flash_map_cache_read(fa->fa_dev, fa->fa_off + off, dst, len);
+#else
 	return flash_read(fa->fa_dev, fa->fa_off + off, dst, len);
+#endif
 }
 
 int flash_area_write(const struct flash_area *fa, off_t off, const void *src,
@@ -70,7 +74,14 @@ int flash_area_write(const struct flash_area *fa, off_t off, const void *src,
 		return -EINVAL;
 	}
 
-	return flash_write(fa->fa_dev, fa->fa_off + off, (void *)src, len);
+	int rc;
+
+	rc = flash_write(fa->fa_dev, fa->fa_off + off, (void *)src, len);
+#ifdef CONFIG_FLASH_MAP_CACHE
+	flash_area_cache_invalidate_range(fa->fa_dev, fa->fa_off + off, len);
+#endif
+
+	return rc;
 }
 
 int flash_area_erase(const struct flash_area *fa, off_t off, size_t len)
@@ -79,7 +90,14 @@ int flash_area_erase(const struct flash_area *fa, off_t off, size_t len)
 		return -EINVAL;
 	}
 
-	return flash_erase(fa->fa_dev, fa->fa_off + off, len);
+	int rc;
+
+	rc = flash_erase(fa->fa_dev, fa->fa_off + off, len);
+#ifdef CONFIG_FLASH_MAP_CACHE
+	flash_area_cache_invalidate_range(fa->fa_dev, fa->fa_off + off, len);
+#endif
+
+	return rc;
 }
 
 uint32_t flash_area_align(const struct flash_area *fa)
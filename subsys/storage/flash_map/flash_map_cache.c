@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/util.h>
+#include "flash_map_priv.h"
+
+#define CACHE_PAGE_SIZE CONFIG_FLASH_MAP_CACHE_PAGE_SIZE
+#define CACHE_PAGES CONFIG_FLASH_MAP_CACHE_PAGES
+
+BUILD_ASSERT((CACHE_PAGE_SIZE & (CACHE_PAGE_SIZE - 1)) == 0,
+	     "Flash map cache page size must be a power of two");
+
+struct flash_map_cache_page {
+	/* Device the page has been read from, NULL if the page is free */
+	const struct device *dev;
+	/* Device offset of the page, aligned to CACHE_PAGE_SIZE */
+	off_t off;
+	/* Value of the access counter when the page was last used */
+	uint32_t last_use;
+	uint8_t data[CACHE_PAGE_SIZE];
+};
+
+static struct flash_map_cache_page cache_pages[CACHE_PAGES];
+static struct flash_area_cache_stats cache_stats;
+static uint32_t cache_access_cnt;
+static K_MUTEX_DEFINE(cache_lock);
+
+static struct flash_map_cache_page *cache_lookup(const struct device *dev,
+						 off_t page_off)
+{
+	for (int i = 0; i < CACHE_PAGES; i++) {
+		if (cache_pages[i].dev == dev && cache_pages[i].off == page_off) {
+			return &cache_pages[i];
+		}
+	}
+
+	return NULL;
+}
+
+static struct flash_map_cache_page *cache_victim(void)
+{
+	struct flash_map_cache_page *victim = &cache_pages[0];
+
+	for (int i = 0; i < CACHE_PAGES; i++) {
+		if (cache_pages[i].dev == NULL) {
+			return &cache_pages[i];
+		}
+		/* Wrap-around safe comparison of access counter values */
+		if ((int32_t)(cache_pages[i].last_use - victim->last_use) < 0) {
+			victim = &cache_pages[i];
+		}
+	}
+
+	return victim;
+}
+
+/* Must be called with cache_lock held */
+static int cache_fill(const struct device *dev, off_t page_off,
+		      struct flash_map_cache_page **page)
+{
+	struct flash_map_cache_page *victim = cache_victim();
+	int rc;
+
+	victim->dev = NULL;
+	rc = flash_read(dev, page_off, victim->data, CACHE_PAGE_SIZE);
+	if (rc < 0) {
+		return rc;
+	}
+
+	victim->dev = dev;
+	victim->off = page_off;
+	*page = victim;
+
+	return 0;
+}
+
+int flash_map_cache_read(const struct device *dev, off_t off, void *dst,
+			 size_t len)
+{
+	struct flash_map_cache_page *page;
+	uint8_t *out = dst;
+	bool hit = true;
+	int rc = 0;
+
+	if (len >= CACHE_PAGE_SIZE) {
+		k_mutex_lock(&cache_lock, K_FOREVER);
+		cache_stats.bypasses++;
+		k_mutex_unlock(&cache_lock);
+
+		return flash_read(dev, off, dst, len);
+	}
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	while (len > 0) {
+		off_t page_off = ROUND_DOWN(off, CACHE_PAGE_SIZE);
+		size_t in_page = off - page_off;
+		size_t chunk = MIN(len, CACHE_PAGE_SIZE - in_page);
+
+		page = cache_lookup(dev, page_off);
+		if (page == NULL) {
+			hit = false;
+			rc = cache_fill(dev, page_off, &page);
+			if (rc < 0) {
+				break;
+			}
+		}
+
+		page->last_use = ++cache_access_cnt;
+		memcpy(out, &page->data[in_page], chunk);
+
+		out += chunk;
+		off += chunk;
+		len -= chunk;
+	}
+
+	if (rc == 0) {
+		if (hit) {
+			cache_stats.hits++;
+		} else {
+			cache_stats.misses++;
+		}
+	}
+
+	k_mutex_unlock(&cache_lock);
+
+	if (rc < 0) {
+		/*
+		 * The page could not be fetched as a whole, which happens
+		 * when it would extend past the end of the device; read
+		 * the remainder directly.
+		 */
+		k_mutex_lock(&cache_lock, K_FOREVER);
+		cache_stats.bypasses++;
+		k_mutex_unlock(&cache_lock);
+
+		rc = flash_read(dev, off, out, len);
+	}
+
+	return rc;
+}
+
+void flash_area_cache_invalidate_range(const struct device *dev, off_t off,
+				       size_t len)
+{
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	for (int i = 0; i < CACHE_PAGES; i++) {
+		if (cache_pages[i].dev == dev &&
+		    cache_pages[i].off < off + (off_t)len &&
+		    cache_pages[i].off + CACHE_PAGE_SIZE > off) {
+			cache_pages[i].dev = NULL;
+			cache_stats.invalidations++;
+		}
+	}
+
+	k_mutex_unlock(&cache_lock);
+}
+
+void flash_area_cache_invalidate(void)
+{
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	for (int i = 0; i < CACHE_PAGES; i++) {
+		if (cache_pages[i].dev != NULL) {
+			cache_pages[i].dev = NULL;
+			cache_stats.invalidations++;
+		}
+	}
+
+	k_mutex_unlock(&cache_lock);
+}
+
+void flash_area_cache_stats_get(struct flash_area_cache_stats *stats)
+{
+	k_mutex_lock(&cache_lock, K_FOREVER);
+	*stats = cache_stats;
+	k_mutex_unlock(&cache_lock);
+}
+
+void flash_area_cache_stats_reset(void)
+{
+	k_mutex_lock(&cache_lock, K_FOREVER);
+	memset(&cache_stats, 0, sizeof(cache_stats));
+	k_mutex_unlock(&cache_lock);
+}
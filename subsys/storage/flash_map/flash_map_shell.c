@@ -56,8 +56,35 @@ static int cmd_flash_map_list(const struct shell *sh, size_t argc, char **argv)
 	return 0;
 }
 
+#ifdef CONFIG_FLASH_MAP_CACHE
+static int cmd_flash_map_cache(const struct shell *sh, size_t argc, char **argv)
+{
+	struct flash_area_cache_stats stats;
+	uint32_t reads;
+
+	flash_area_cache_stats_get(&stats);
+	reads = stats.hits + stats.misses + stats.bypasses;
+
+	shell_print(sh, "Hits:          %u", stats.hits);
+	shell_print(sh, "Misses:        %u", stats.misses);
+	shell_print(sh, "Bypasses:      %u", stats.bypasses);
+	shell_print(sh, "Invalidations: %u", stats.invalidations);
+	shell_print(sh, "Hit rate:      %u%%", reads ? (stats.hits * 100U) / reads : 0U);
+
+	if (argc > 1 && strcmp(argv[1], "reset") == 0) {
+		flash_area_cache_stats_reset();
+	}
+
+	return 0;
+}
+#endif
+
 SHELL_STATIC_SUBCMD_SET_CREATE(sub_flash_map,
 	/* Alphabetically sorted. */
+#ifdef CONFIG_FLASH_MAP_CACHE
+	SHELL_CMD_ARG(cache, NULL, "Show read cache statistics [reset]",
+		      cmd_flash_map_cache, 1, 1),
+#endif
 	SHELL_CMD(list, NULL, "List flash areas", cmd_flash_map_list),
 	SHELL_SUBCMD_SET_END /* Array terminated. */
 );
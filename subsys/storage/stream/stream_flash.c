@@ -15,6 +15,34 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME, CONFIG_STREAM_FLASH_LOG_LEVEL);
 #include <zephyr/drivers/flash.h>
 
 #include <zephyr/storage/stream_flash.h>
+#include <zephyr/storage/flash_map.h>
+
+/* The flash progress of asynchronous contexts is updated by the work queue */
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+static K_MUTEX_DEFINE(stream_flash_lock);
+
+static inline void ctx_lock(struct stream_flash_ctx *ctx)
+{
+	ARG_UNUSED(ctx);
+	(void)k_mutex_lock(&stream_flash_lock, K_FOREVER);
+}
+
+static inline void ctx_unlock(struct stream_flash_ctx *ctx)
+{
+	ARG_UNUSED(ctx);
+	(void)k_mutex_unlock(&stream_flash_lock);
+}
+#else
+static inline void ctx_lock(struct stream_flash_ctx *ctx)
+{
+	ARG_UNUSED(ctx);
+}
+
+static inline void ctx_unlock(struct stream_flash_ctx *ctx)
+{
+	ARG_UNUSED(ctx);
+}
+#endif /* CONFIG_STREAM_FLASH_ASYNC */
 
 #ifdef CONFIG_STREAM_FLASH_PROGRESS
 #include <zephyr/settings/settings.h>
@@ -39,6 +67,9 @@ static int settings_direct_loader(const char *key, size_t len,
 		/* Check that loaded progress is not outdated. */
 		if (bytes_written >= ctx->bytes_written) {
 			ctx->bytes_written = bytes_written;
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+			ctx->bytes_queued = bytes_written;
+#endif
 		} else {
 			LOG_WRN("Loaded outdated bytes_written %zu < %zu",
 				bytes_written, ctx->bytes_written);
@@ -85,13 +116,20 @@ int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off)
 		return rc;
 	}
 
+	ctx_lock(ctx);
+
 	if (ctx->last_erased_page_start_offset == page.start_offset) {
+		ctx_unlock(ctx);
 		return 0;
 	}
 
 	LOG_DBG("Erasing page at offset 0x%08lx", (long)page.start_offset);
 
 	rc = flash_erase(ctx->fdev, page.start_offset, page.size);
+#ifdef CONFIG_FLASH_MAP_CACHE
+	flash_area_cache_invalidate_range(ctx->fdev, page.start_offset,
+					  page.size);
+#endif
 
 	if (rc != 0) {
 		LOG_ERR("Error %d while erasing page", rc);
@@ -99,12 +137,15 @@ int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off)
 		ctx->last_erased_page_start_offset = page.start_offset;
 	}
 
+	ctx_unlock(ctx);
+
 	return rc;
 }
 
 #endif /* CONFIG_STREAM_FLASH_ERASE */
 
-static int flash_sync(struct stream_flash_ctx *ctx)
+static int flash_sync_buf(struct stream_flash_ctx *ctx, uint8_t *buf,
+			  size_t buf_bytes)
 {
 	int rc = 0;
 	size_t write_addr = ctx->offset + ctx->bytes_written;
@@ -113,14 +154,14 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 	uint8_t filler;
 
 
-	if (ctx->buf_bytes == 0) {
+	if (buf_bytes == 0) {
 		return 0;
 	}
 
 	if (IS_ENABLED(CONFIG_STREAM_FLASH_ERASE)) {
 
 		rc = stream_flash_erase_page(ctx,
-					     write_addr + ctx->buf_bytes - 1);
+					     write_addr + buf_bytes - 1);
 		if (rc < 0) {
 			LOG_ERR("stream_flash_erase_page err %d offset=0x%08zx",
 				rc, write_addr);
@@ -129,17 +170,21 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 	}
 
 	fill_length = flash_get_write_block_size(ctx->fdev);
-	if (ctx->buf_bytes % fill_length) {
-		fill_length -= ctx->buf_bytes % fill_length;
+	if (buf_bytes % fill_length) {
+		fill_length -= buf_bytes % fill_length;
 		filler = flash_get_parameters(ctx->fdev)->erase_value;
 
-		memset(ctx->buf + ctx->buf_bytes, filler, fill_length);
+		memset(buf + buf_bytes, filler, fill_length);
 	} else {
 		fill_length = 0;
 	}
 
-	buf_bytes_aligned = ctx->buf_bytes + fill_length;
-	rc = flash_write(ctx->fdev, write_addr, ctx->buf, buf_bytes_aligned);
+	buf_bytes_aligned = buf_bytes + fill_length;
+	rc = flash_write(ctx->fdev, write_addr, buf, buf_bytes_aligned);
+#ifdef CONFIG_FLASH_MAP_CACHE
+	flash_area_cache_invalidate_range(ctx->fdev, write_addr,
+					  buf_bytes_aligned);
+#endif
 
 	if (rc != 0) {
 		LOG_ERR("flash_write error %d offset=0x%08zx", rc,
@@ -151,30 +196,179 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 		/* Invert to ensure that caller is able to discover a faulty
 		 * flash_read() even if no error code is returned.
 		 */
-		for (int i = 0; i < ctx->buf_bytes; i++) {
-			ctx->buf[i] = ~ctx->buf[i];
+		for (int i = 0; i < buf_bytes; i++) {
+			buf[i] = ~buf[i];
 		}
 
-		rc = flash_read(ctx->fdev, write_addr, ctx->buf,
-				ctx->buf_bytes);
+		rc = flash_read(ctx->fdev, write_addr, buf, buf_bytes);
 		if (rc != 0) {
 			LOG_ERR("flash read failed: %d", rc);
 			return rc;
 		}
 
-		rc = ctx->callback(ctx->buf, ctx->buf_bytes, write_addr);
+		rc = ctx->callback(buf, buf_bytes, write_addr);
 		if (rc != 0) {
 			LOG_ERR("callback failed: %d", rc);
 			return rc;
 		}
 	}
 
-	ctx->bytes_written += ctx->buf_bytes;
+	ctx->bytes_written += buf_bytes;
+
+	return rc;
+}
+
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+
+static K_THREAD_STACK_DEFINE(stream_flash_work_q_stack,
+			     CONFIG_STREAM_FLASH_ASYNC_STACK_SIZE);
+static struct k_work_q stream_flash_work_q;
+
+static inline bool is_async(struct stream_flash_ctx *ctx)
+{
+	return ctx->bufs != NULL;
+}
+
+static void stream_flash_work_handler(struct k_work *work)
+{
+	struct stream_flash_ctx *ctx =
+		CONTAINER_OF(work, struct stream_flash_ctx, work);
+	uint8_t *buf;
+	size_t len;
+	int rc;
+
+	while (atomic_get(&ctx->queued) > 0) {
+		buf = ctx->bufs + ctx->write_idx * ctx->buf_len;
+		len = ctx->queued_len[ctx->write_idx];
+
+		ctx_lock(ctx);
+
+		/* After a failure remaining buffers are only released */
+		if (ctx->async_rc == 0) {
+			rc = flash_sync_buf(ctx, buf, len);
+			if (rc != 0) {
+				ctx->async_rc = rc;
+			}
+		}
+
+#ifdef CONFIG_STREAM_FLASH_ASYNC_ERASE_AHEAD
+		if (ctx->async_rc == 0 && ctx->bytes_written < ctx->available) {
+			rc = stream_flash_erase_page(ctx, ctx->offset + ctx->bytes_written);
+			if (rc != 0) {
+				ctx->async_rc = rc;
+			}
+		}
+#endif
+
+		ctx_unlock(ctx);
+
+		ctx->write_idx = (ctx->write_idx + 1) % ctx->buf_cnt;
+		atomic_dec(&ctx->queued);
+		k_sem_give(&ctx->free_bufs);
+	}
+}
+
+/* Hand the buffer being filled over to the work queue and get a free one */
+static int flash_queue(struct stream_flash_ctx *ctx)
+{
+	if (ctx->buf_bytes == 0) {
+		return ctx->async_rc;
+	}
+
+	ctx->queued_len[ctx->fill_idx] = ctx->buf_bytes;
+	ctx->bytes_queued += ctx->buf_bytes;
+	atomic_inc(&ctx->queued);
+	(void)k_work_submit_to_queue(&stream_flash_work_q, &ctx->work);
+
+	ctx->fill_idx = (ctx->fill_idx + 1) % ctx->buf_cnt;
+	(void)k_sem_take(&ctx->free_bufs, K_FOREVER);
+	ctx->buf = ctx->bufs + ctx->fill_idx * ctx->buf_len;
 	ctx->buf_bytes = 0U;
 
+	return ctx->async_rc;
+}
+
+int stream_flash_wait(struct stream_flash_ctx *ctx)
+{
+	if (!ctx) {
+		return -EFAULT;
+	}
+
+	if (!is_async(ctx)) {
+		return 0;
+	}
+
+	/* All buffers but the one being filled are free once written */
+	for (int i = 0; i < ctx->buf_cnt - 1; i++) {
+		(void)k_sem_take(&ctx->free_bufs, K_FOREVER);
+	}
+	for (int i = 0; i < ctx->buf_cnt - 1; i++) {
+		k_sem_give(&ctx->free_bufs);
+	}
+
+	return ctx->async_rc;
+}
+
+static int stream_flash_work_q_init(void)
+{
+	k_work_queue_start(&stream_flash_work_q, stream_flash_work_q_stack,
+			   K_THREAD_STACK_SIZEOF(stream_flash_work_q_stack),
+			   CONFIG_STREAM_FLASH_ASYNC_PRIORITY, NULL);
+	k_thread_name_set(&stream_flash_work_q.thread, "stream_flash");
+
+	return 0;
+}
+
+SYS_INIT(stream_flash_work_q_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+#else
+
+static inline bool is_async(struct stream_flash_ctx *ctx)
+{
+	ARG_UNUSED(ctx);
+	return false;
+}
+
+static inline int flash_queue(struct stream_flash_ctx *ctx)
+{
+	ARG_UNUSED(ctx);
+	return -ENOTSUP;
+}
+
+int stream_flash_wait(struct stream_flash_ctx *ctx)
+{
+	return ctx ? 0 : -EFAULT;
+}
+
+#endif /* CONFIG_STREAM_FLASH_ASYNC */
+
+static int flash_sync(struct stream_flash_ctx *ctx)
+{
+	int rc;
+
+	if (is_async(ctx)) {
+		return flash_queue(ctx);
+	}
+
+	rc = flash_sync_buf(ctx, ctx->buf, ctx->buf_bytes);
+	if (rc == 0) {
+		ctx->buf_bytes = 0U;
+	}
+
 	return rc;
 }
 
+/* Number of bytes written and queued for writing, excluding the fill buffer */
+static size_t bytes_committed(struct stream_flash_ctx *ctx)
+{
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	if (is_async(ctx)) {
+		return ctx->bytes_queued;
+	}
+#endif
+	return ctx->bytes_written;
+}
+
 int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *data,
 				size_t len, bool flush)
 {
@@ -186,7 +380,7 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 		return -EFAULT;
 	}
 
-	if (ctx->bytes_written + ctx->buf_bytes + len > ctx->available) {
+	if (bytes_committed(ctx) + ctx->buf_bytes + len > ctx->available) {
 		return -ENOMEM;
 	}
 
@@ -216,12 +410,22 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 		rc = flash_sync(ctx);
 	}
 
+	if (flush && rc == 0) {
+		rc = stream_flash_wait(ctx);
+	}
+
 	return rc;
 }
 
 size_t stream_flash_bytes_written(struct stream_flash_ctx *ctx)
 {
-	return ctx->bytes_written;
+	size_t bytes_written;
+
+	ctx_lock(ctx);
+	bytes_written = ctx->bytes_written;
+	ctx_unlock(ctx);
+
+	return bytes_written;
 }
 
 struct _inspect_flash {
@@ -245,9 +449,10 @@ static bool find_flash_total_size(const struct flash_pages_info *info,
 	return true;
 }
 
-int stream_flash_init(struct stream_flash_ctx *ctx, const struct device *fdev,
-		      uint8_t *buf, size_t buf_len, size_t offset, size_t size,
-		      stream_flash_callback_t cb)
+static int stream_flash_ctx_init(struct stream_flash_ctx *ctx,
+				 const struct device *fdev, uint8_t *buf,
+				 size_t buf_len, size_t offset, size_t size,
+				 stream_flash_callback_t cb)
 {
 	if (!ctx || !fdev || !buf) {
 		return -EFAULT;
@@ -303,6 +508,64 @@ int stream_flash_init(struct stream_flash_ctx *ctx, const struct device *fdev,
 	return 0;
 }
 
+int stream_flash_init(struct stream_flash_ctx *ctx, const struct device *fdev,
+		      uint8_t *buf, size_t buf_len, size_t offset, size_t size,
+		      stream_flash_callback_t cb)
+{
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	if (ctx) {
+		/* Drop what a previous stream still queued, and wait for the
+		 * work queue to be done with the context: after an error, the
+		 * work handler only releases the buffers
+		 */
+		if (is_async(ctx)) {
+			struct k_work_sync sync;
+
+			ctx_lock(ctx);
+			ctx->async_rc = -ECANCELED;
+			ctx_unlock(ctx);
+			(void)k_work_cancel_sync(&ctx->work, &sync);
+		}
+
+		ctx->bufs = NULL;
+	}
+#endif
+
+	return stream_flash_ctx_init(ctx, fdev, buf, buf_len, offset, size, cb);
+}
+
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+int stream_flash_init_async(struct stream_flash_ctx *ctx,
+			    const struct device *fdev, uint8_t *buf,
+			    size_t buf_len, size_t buf_cnt, size_t offset,
+			    size_t size, stream_flash_callback_t cb)
+{
+	int rc;
+
+	if (buf_cnt < 2 || buf_cnt > CONFIG_STREAM_FLASH_ASYNC_MAX_BUFFERS) {
+		LOG_ERR("Unsupported number of buffers %zu", buf_cnt);
+		return -EINVAL;
+	}
+
+	rc = stream_flash_init(ctx, fdev, buf, buf_len, offset, size, cb);
+	if (rc != 0) {
+		return rc;
+	}
+
+	ctx->bufs = buf;
+	ctx->buf_cnt = buf_cnt;
+	ctx->fill_idx = 0U;
+	ctx->write_idx = 0U;
+	atomic_set(&ctx->queued, 0);
+	ctx->bytes_queued = 0;
+	ctx->async_rc = 0;
+	k_sem_init(&ctx->free_bufs, buf_cnt - 1, buf_cnt - 1);
+	k_work_init(&ctx->work, stream_flash_work_handler);
+
+	return 0;
+}
+#endif /* CONFIG_STREAM_FLASH_ASYNC */
+
 #ifdef CONFIG_STREAM_FLASH_PROGRESS
 
 int stream_flash_progress_load(struct stream_flash_ctx *ctx,
@@ -312,9 +575,11 @@ int stream_flash_progress_load(struct stream_flash_ctx *ctx,
 		return -EFAULT;
 	}
 
+	ctx_lock(ctx);
 	int rc = settings_load_subtree_direct(settings_key,
 					      settings_direct_loader,
 					      (void *) ctx);
+	ctx_unlock(ctx);
 
 	if (rc != 0) {
 		LOG_ERR("Error %d while loading progress for \"%s\"",
@@ -331,9 +596,10 @@ int stream_flash_progress_save(struct stream_flash_ctx *ctx,
 		return -EFAULT;
 	}
 
+	size_t bytes_written = stream_flash_bytes_written(ctx);
 	int rc = settings_save_one(settings_key,
-				   &ctx->bytes_written,
-				   sizeof(ctx->bytes_written));
+				   &bytes_written,
+				   sizeof(bytes_written));
 
 	if (rc != 0) {
 		LOG_ERR("Error %d while storing progress for \"%s\"",
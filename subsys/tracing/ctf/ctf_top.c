@@ -6,9 +6,75 @@
 
 #include <zephyr/kernel.h>
 #include <zephyr/kernel_structs.h>
+#include <zephyr/sys/byteorder.h>
 #include <kernel_internal.h>
 #include <ctf_top.h>
+#include <tracing_core.h>
 
+#ifdef CONFIG_TRACING_CTF_COMPACT_HEADER
+#define CTF_EXTENDED_HEADER_ID 0xFF
+
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+#define CTF_STREAMS CONFIG_MP_MAX_NUM_CPUS
+#else
+#define CTF_STREAMS 1
+#endif
+
+/* Last timestamp of each stream, as known by the trace reader */
+static struct {
+	uint32_t tstamp;
+	uint32_t drop_num;
+	bool valid;
+} ctf_stream[CTF_STREAMS];
+
+void ctf_top_event_emit(uint8_t *epacket, size_t len)
+{
+	uint8_t id = epacket[CTF_HEADER_ROOM];
+	uint8_t *start;
+	uint32_t tstamp;
+	uint32_t drop_num;
+
+	/* Event would be discarded, leave the stream state untouched */
+	if (!is_tracing_enabled() ||
+	    (IS_ENABLED(CONFIG_TRACING_ASYNC) && is_tracing_thread())) {
+		return;
+	}
+
+	/* Timestamps must be written to the stream in order */
+	TRACING_LOCK();
+#if defined(CONFIG_TRACING_PER_CPU_BUFFERS) && defined(CONFIG_SMP)
+	unsigned int stream = arch_curr_cpu()->id;
+#else
+	unsigned int stream = 0;
+#endif
+
+	tstamp = k_cycle_get_32();
+	drop_num = tracing_packet_drop_num_get();
+
+	/*
+	 * The reader restores the upper bits of a compact timestamp from the
+	 * previous event, which must have reached it.
+	 */
+	if (ctf_stream[stream].valid && ctf_stream[stream].drop_num == drop_num &&
+	    (tstamp - ctf_stream[stream].tstamp) <= UINT16_MAX) {
+		start = &epacket[CTF_HEADER_ROOM - 2];
+		start[0] = id;
+		sys_put_le16((uint16_t)tstamp, &start[1]);
+	} else {
+		start = &epacket[0];
+		start[0] = CTF_EXTENDED_HEADER_ID;
+		start[1] = id;
+		sys_put_le32(tstamp, &start[2]);
+	}
+
+	ctf_stream[stream].tstamp = tstamp;
+	ctf_stream[stream].drop_num = drop_num;
+	ctf_stream[stream].valid = true;
+
+	tracing_format_raw_data(start, len - (start - epacket));
+	TRACING_UNLOCK();
+}
+#endif /* CONFIG_TRACING_CTF_COMPACT_HEADER */
 
 static void _get_thread_name(struct k_thread *thread,
 			     ctf_bounded_string_t *name)
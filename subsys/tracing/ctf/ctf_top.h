@@ -41,7 +41,28 @@
 		tracing_format_raw_data(epacket, sizeof(epacket));              \
 	}
 
-#ifdef CONFIG_TRACING_CTF_TIMESTAMP
+#if defined(CONFIG_TRACING_CTF_COMPACT_HEADER)
+/*
+ * Room left in front of the event ID for the largest (extended) header.
+ */
+#define CTF_HEADER_ROOM 5
+
+/*
+ * Emit an event-packet made of CTF_HEADER_ROOM free bytes followed by the
+ * event ID and fields. The header is built in the free bytes.
+ */
+void ctf_top_event_emit(uint8_t *epacket, size_t len);
+
+#define CTF_EVENT(...)                                                         \
+	{                                                                      \
+		uint8_t epacket[CTF_HEADER_ROOM                                \
+				MAP(CTF_INTERNAL_FIELD_SIZE, ##__VA_ARGS__)];  \
+		uint8_t *epacket_cursor = &epacket[CTF_HEADER_ROOM];           \
+									       \
+		MAP(CTF_INTERNAL_FIELD_APPEND, ##__VA_ARGS__)                  \
+		ctf_top_event_emit(epacket, sizeof(epacket));                  \
+	}
+#elif defined(CONFIG_TRACING_CTF_TIMESTAMP)
 #define CTF_EVENT(...)                                                         \
 	{                                                                      \
 		const uint32_t tstamp = k_cyc_to_ns_floor64(k_cycle_get_32()); \
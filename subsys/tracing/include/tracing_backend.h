@@ -31,6 +31,9 @@ struct tracing_backend_api {
 	void (*init)(void);
 	void (*output)(const struct tracing_backend *backend,
 		       uint8_t *data, uint32_t length);
+	/* Optional, outputs data traced on given CPU to a dedicated stream. */
+	void (*output_cpu)(const struct tracing_backend *backend,
+			   unsigned int cpu, uint8_t *data, uint32_t length);
 };
 
 /**
@@ -82,6 +85,30 @@ static inline void tracing_backend_output(
 	}
 }
 
+/**
+ * @brief Output tracing packet traced on given CPU with tracing backend.
+ *
+ * Backends without support for per-CPU streams get data of all CPUs in one
+ * stream.
+ *
+ * @param backend Pointer to tracing_backend instance.
+ * @param cpu     CPU index.
+ * @param data    Address of outputting buffer.
+ * @param length  Length of outputting buffer.
+ */
+static inline void tracing_backend_output_cpu(
+		const struct tracing_backend *backend,
+		unsigned int cpu, uint8_t *data, uint32_t length)
+{
+	if (backend && backend->api) {
+		if (backend->api->output_cpu) {
+			backend->api->output_cpu(backend, cpu, data, length);
+		} else {
+			backend->api->output(backend, data, length);
+		}
+	}
+}
+
 /**
  * @brief Get tracing backend based on the name of
  *        tracing backend in tracing backend section.
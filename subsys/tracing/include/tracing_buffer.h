@@ -14,6 +14,11 @@
 extern "C" {
 #endif
 
+/*
+ * With per-CPU tracing buffers, functions not taking a CPU index operate on
+ * the buffer of the current CPU and must be called with interrupts locked.
+ */
+
 /**
  * @brief Initialize tracing buffer.
  */
@@ -104,6 +109,40 @@ int tracing_buffer_get_finish(uint32_t size);
  */
 uint32_t tracing_buffer_get(uint8_t *data, uint32_t size);
 
+/**
+ * @brief Tracing buffer of given CPU is empty or not.
+ *
+ * @param cpu CPU index.
+ *
+ * @return true if the ring buffer is empty, or false if not.
+ */
+bool tracing_buffer_cpu_is_empty(unsigned int cpu);
+
+/**
+ * @brief Get address of the first valid data in tracing buffer of given CPU.
+ *
+ * @param cpu  CPU index.
+ * @param data Pointer to the address. It's set to a location pointing to
+ *             the first valid data within the tracing buffer.
+ * @param size Requested buffer size (in bytes).
+ *
+ * @return Size of valid buffer which can be smaller than requested
+ *         if there isn't enough valid data or buffer wraps.
+ */
+uint32_t tracing_buffer_cpu_get_claim(unsigned int cpu, uint8_t **data,
+				      uint32_t size);
+
+/**
+ * @brief Indicate number of bytes read from claimed buffer of given CPU.
+ *
+ * @param cpu  CPU index.
+ * @param size Number of bytes read from claimed buffer.
+ *
+ * @retval 0 Successful operation.
+ * @retval -EINVAL Given @a size exceeds available data of tracing buffer.
+ */
+int tracing_buffer_cpu_get_finish(unsigned int cpu, uint32_t size);
+
 /**
  * @brief Get buffer from tracing command buffer.
  *
@@ -14,9 +14,16 @@
 extern "C" {
 #endif
 
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+/* Each CPU writes to its own buffer, only local interrupts are locked. */
+#define TRACING_LOCK()		{ unsigned int key; key = arch_irq_lock()
+
+#define TRACING_UNLOCK()	{ arch_irq_unlock(key); } }
+#else
 #define TRACING_LOCK()		{ int key; key = irq_lock()
 
 #define TRACING_UNLOCK()	{ irq_unlock(key); } }
+#endif
 
 /**
  * @brief Check tracing enabled or not.
@@ -33,11 +40,27 @@ bool is_tracing_enabled(void);
  */
 void tracing_buffer_handle(uint8_t *data, uint32_t length);
 
+/**
+ * @brief Give tracing buffer of given CPU to backend.
+ *
+ * @param cpu CPU index.
+ * @param data Tracing buffer address.
+ * @param length Tracing buffer length.
+ */
+void tracing_buffer_cpu_handle(unsigned int cpu, uint8_t *data, uint32_t length);
+
 /**
  * @brief Handle tracing packet drop.
  */
 void tracing_packet_drop_handle(void);
 
+/**
+ * @brief Get number of tracing packets dropped so far.
+ *
+ * @return Number of dropped packets.
+ */
+uint32_t tracing_packet_drop_num_get(void);
+
 /**
  * @brief Handle tracing command.
  *
@@ -6,12 +6,42 @@
 
 #include <soc.h>
 #include <cmdline.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
 #include <tracing_backend.h>
 #include "tracing_backend_posix_bottom.h"
 
 static void *out_stream;
 static const char *file_name;
 
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+/* Stream of each CPU is written to <file_name>_<cpu> */
+static void *cpu_out_stream[CONFIG_MP_MAX_NUM_CPUS];
+
+static void tracing_backend_posix_init(void)
+{
+	char name[256];
+
+	if (file_name == NULL) {
+		file_name = "channel0";
+	}
+
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+		snprintk(name, sizeof(name), "%s_%u", file_name, cpu);
+		cpu_out_stream[cpu] = tracing_backend_posix_init_bottom(name);
+	}
+	out_stream = cpu_out_stream[0];
+}
+
+static void tracing_backend_posix_output_cpu(
+		const struct tracing_backend *backend,
+		unsigned int cpu, uint8_t *data, uint32_t length)
+{
+	ARG_UNUSED(backend);
+
+	tracing_backend_posix_output_bottom(data, length, cpu_out_stream[cpu]);
+}
+#else
 static void tracing_backend_posix_init(void)
 {
 	if (file_name == NULL) {
@@ -20,6 +50,7 @@ static void tracing_backend_posix_init(void)
 
 	out_stream = tracing_backend_posix_init_bottom(file_name);
 }
+#endif
 
 static void tracing_backend_posix_output(
 		const struct tracing_backend *backend,
@@ -32,7 +63,10 @@ static void tracing_backend_posix_output(
 
 const struct tracing_backend_api tracing_backend_posix_api = {
 	.init = tracing_backend_posix_init,
-	.output  = tracing_backend_posix_output
+	.output  = tracing_backend_posix_output,
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+	.output_cpu = tracing_backend_posix_output_cpu,
+#endif
 };
 
 TRACING_BACKEND_DEFINE(tracing_backend_posix, tracing_backend_posix_api);
@@ -11,25 +11,43 @@
 #include <tracing_buffer.h>
 #include <tracing_backend.h>
 
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+#define RAM_TRACING_STREAMS CONFIG_MP_MAX_NUM_CPUS
+#else
+#define RAM_TRACING_STREAMS 1
+#endif
+
+/* Each CPU stream gets an equal part of the buffer */
+#define RAM_TRACING_STREAM_SIZE \
+	(CONFIG_RAM_TRACING_BUFFER_SIZE / RAM_TRACING_STREAMS)
+
 uint8_t ram_tracing[CONFIG_RAM_TRACING_BUFFER_SIZE];
-static uint32_t pos;
-static bool buffer_full;
+static uint32_t pos[RAM_TRACING_STREAMS];
+static bool buffer_full[RAM_TRACING_STREAMS];
 
-static void tracing_backend_ram_output(
+static void tracing_backend_ram_output_cpu(
 		const struct tracing_backend *backend,
-		uint8_t *data, uint32_t length)
+		unsigned int cpu, uint8_t *data, uint32_t length)
 {
-	if (buffer_full) {
+	if (buffer_full[cpu]) {
 		return;
 	}
 
-	if ((pos + length) > CONFIG_RAM_TRACING_BUFFER_SIZE) {
-		buffer_full = true;
+	if ((pos[cpu] + length) > RAM_TRACING_STREAM_SIZE) {
+		buffer_full[cpu] = true;
 		return;
 	}
 
-	memcpy(ram_tracing + pos, data, length);
-	pos += length;
+	memcpy(ram_tracing + cpu * RAM_TRACING_STREAM_SIZE + pos[cpu], data,
+	       length);
+	pos[cpu] += length;
+}
+
+static void tracing_backend_ram_output(
+		const struct tracing_backend *backend,
+		uint8_t *data, uint32_t length)
+{
+	tracing_backend_ram_output_cpu(backend, 0, data, length);
 }
 
 static void tracing_backend_ram_init(void)
@@ -39,7 +57,10 @@ static void tracing_backend_ram_init(void)
 
 const struct tracing_backend_api tracing_backend_ram_api = {
 	.init = tracing_backend_ram_init,
-	.output  = tracing_backend_ram_output
+	.output  = tracing_backend_ram_output,
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+	.output_cpu = tracing_backend_ram_output_cpu,
+#endif
 };
 
 TRACING_BACKEND_DEFINE(tracing_backend_ram, tracing_backend_ram_api);
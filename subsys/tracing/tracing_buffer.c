@@ -4,12 +4,30 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <zephyr/kernel.h>
 #include <zephyr/sys/ring_buffer.h>
+#include <tracing_buffer.h>
 
-static struct ring_buf tracing_ring_buf;
-static uint8_t tracing_buffer[CONFIG_TRACING_BUFFER_SIZE + 1];
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+#define TRACING_BUFFERS CONFIG_MP_MAX_NUM_CPUS
+#else
+#define TRACING_BUFFERS 1
+#endif
+
+static struct ring_buf tracing_ring_buf[TRACING_BUFFERS];
+static uint8_t tracing_buffer[TRACING_BUFFERS][CONFIG_TRACING_BUFFER_SIZE + 1];
 static uint8_t tracing_cmd_buffer[CONFIG_TRACING_CMD_BUFFER_SIZE];
 
+/* Buffer of the current CPU, interrupts must be locked when it is used */
+static inline struct ring_buf *curr_ring_buf(void)
+{
+#if defined(CONFIG_TRACING_PER_CPU_BUFFERS) && defined(CONFIG_SMP)
+	return &tracing_ring_buf[arch_curr_cpu()->id];
+#else
+	return &tracing_ring_buf[0];
+#endif
+}
+
 uint32_t tracing_cmd_buffer_alloc(uint8_t **data)
 {
 	*data = &tracing_cmd_buffer[0];
@@ -19,51 +37,71 @@ uint32_t tracing_cmd_buffer_alloc(uint8_t **data)
 
 uint32_t tracing_buffer_put_claim(uint8_t **data, uint32_t size)
 {
-	return ring_buf_put_claim(&tracing_ring_buf, data, size);
+	return ring_buf_put_claim(curr_ring_buf(), data, size);
 }
 
 int tracing_buffer_put_finish(uint32_t size)
 {
-	return ring_buf_put_finish(&tracing_ring_buf, size);
+	return ring_buf_put_finish(curr_ring_buf(), size);
 }
 
 uint32_t tracing_buffer_put(uint8_t *data, uint32_t size)
 {
-	return ring_buf_put(&tracing_ring_buf, data, size);
+	return ring_buf_put(curr_ring_buf(), data, size);
 }
 
 uint32_t tracing_buffer_get_claim(uint8_t **data, uint32_t size)
 {
-	return ring_buf_get_claim(&tracing_ring_buf, data, size);
+	return ring_buf_get_claim(curr_ring_buf(), data, size);
 }
 
 int tracing_buffer_get_finish(uint32_t size)
 {
-	return ring_buf_get_finish(&tracing_ring_buf, size);
+	return ring_buf_get_finish(curr_ring_buf(), size);
 }
 
 uint32_t tracing_buffer_get(uint8_t *data, uint32_t size)
 {
-	return ring_buf_get(&tracing_ring_buf, data, size);
+	return ring_buf_get(curr_ring_buf(), data, size);
 }
 
 void tracing_buffer_init(void)
 {
-	ring_buf_init(&tracing_ring_buf,
-		      sizeof(tracing_buffer), tracing_buffer);
+	for (int i = 0; i < TRACING_BUFFERS; i++) {
+		ring_buf_init(&tracing_ring_buf[i],
+			      sizeof(tracing_buffer[i]), tracing_buffer[i]);
+	}
 }
 
 bool tracing_buffer_is_empty(void)
 {
-	return ring_buf_is_empty(&tracing_ring_buf);
+	return ring_buf_is_empty(curr_ring_buf());
 }
 
 uint32_t tracing_buffer_capacity_get(void)
 {
-	return ring_buf_capacity_get(&tracing_ring_buf);
+	return ring_buf_capacity_get(&tracing_ring_buf[0]);
 }
 
 uint32_t tracing_buffer_space_get(void)
 {
-	return ring_buf_space_get(&tracing_ring_buf);
+	return ring_buf_space_get(curr_ring_buf());
+}
+
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+bool tracing_buffer_cpu_is_empty(unsigned int cpu)
+{
+	return ring_buf_is_empty(&tracing_ring_buf[cpu]);
+}
+
+uint32_t tracing_buffer_cpu_get_claim(unsigned int cpu, uint8_t **data,
+				      uint32_t size)
+{
+	return ring_buf_get_claim(&tracing_ring_buf[cpu], data, size);
+}
+
+int tracing_buffer_cpu_get_finish(unsigned int cpu, uint32_t size)
+{
+	return ring_buf_get_finish(&tracing_ring_buf[cpu], size);
 }
+#endif /* CONFIG_TRACING_PER_CPU_BUFFERS */
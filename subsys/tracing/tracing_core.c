@@ -61,6 +61,30 @@ static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
 
 	tracing_buffer_max_length = tracing_buffer_capacity_get();
 
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+	while (true) {
+		bool empty = true;
+
+		for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+			if (tracing_buffer_cpu_is_empty(cpu)) {
+				continue;
+			}
+
+			empty = false;
+			transferring_length =
+				tracing_buffer_cpu_get_claim(
+						cpu, &transferring_buf,
+						tracing_buffer_max_length);
+			tracing_buffer_cpu_handle(cpu, transferring_buf,
+						  transferring_length);
+			tracing_buffer_cpu_get_finish(cpu, transferring_length);
+		}
+
+		if (empty) {
+			k_sem_take(&tracing_thread_sem, K_FOREVER);
+		}
+	}
+#else
 	while (true) {
 		if (tracing_buffer_is_empty()) {
 			k_sem_take(&tracing_thread_sem, K_FOREVER);
@@ -74,6 +98,7 @@ static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
 			tracing_buffer_get_finish(transferring_length);
 		}
 	}
+#endif
 }
 
 static void tracing_thread_timer_expiry_fn(struct k_timer *timer)
@@ -154,7 +179,17 @@ void tracing_buffer_handle(uint8_t *data, uint32_t length)
 	tracing_backend_output(working_backend, data, length);
 }
 
+void tracing_buffer_cpu_handle(unsigned int cpu, uint8_t *data, uint32_t length)
+{
+	tracing_backend_output_cpu(working_backend, cpu, data, length);
+}
+
 void tracing_packet_drop_handle(void)
 {
 	atomic_inc(&tracing_packet_drop_num);
 }
+
+uint32_t tracing_packet_drop_num_get(void)
+{
+	return (uint32_t)atomic_get(&tracing_packet_drop_num);
+}
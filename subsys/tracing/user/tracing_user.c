@@ -6,6 +6,7 @@
  */
 
 #include <tracing_user.h>
+#include <tracing_user_syscall.h>
 #include <zephyr/kernel.h>
 
 void __weak sys_trace_thread_create_user(struct k_thread *thread) {}
@@ -22,6 +23,8 @@ void __weak sys_trace_thread_priority_set_user(struct k_thread *thread, int prio
 void __weak sys_trace_isr_enter_user(void) {}
 void __weak sys_trace_isr_exit_user(void) {}
 void __weak sys_trace_idle_user(void) {}
+void __weak sys_trace_syscall_enter_user(uint32_t syscall_id, const char *syscall_name) {}
+void __weak sys_trace_syscall_exit_user(uint32_t syscall_id, const char *syscall_name) {}
 
 void sys_trace_thread_create(struct k_thread *thread)
 {
@@ -92,3 +95,13 @@ void sys_trace_idle(void)
 {
 	sys_trace_idle_user();
 }
+
+void sys_trace_syscall_enter(uint32_t syscall_id, const char *syscall_name)
+{
+	sys_trace_syscall_enter_user(syscall_id, syscall_name);
+}
+
+void sys_trace_syscall_exit(uint32_t syscall_id, const char *syscall_name)
+{
+	sys_trace_syscall_exit_user(syscall_id, syscall_name);
+}
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/storage/disk_access.h>
+
+#define SECTOR_SIZE 512
+#define SECTOR_COUNT 256
+#define HOT_SECTORS 4
+#define HOT_READS 1024
+#define SYNC_INTERVAL 32
+
+/* Latency of an SD card on a slow bus; adjust to model the target media */
+#define CMD_US 200
+#define SECTOR_US 20
+
+/* RAM backed disk that busy-waits for every command like real media does */
+static uint8_t slow_data[SECTOR_COUNT][SECTOR_SIZE];
+static uint32_t slow_cmds;
+
+static void slow_disk_delay(uint32_t num_sector)
+{
+	slow_cmds++;
+	k_busy_wait(CMD_US + num_sector * SECTOR_US);
+}
+
+static int slow_disk_init(struct disk_info *disk)
+{
+	return 0;
+}
+
+static int slow_disk_status(struct disk_info *disk)
+{
+	return DISK_STATUS_OK;
+}
+
+static int slow_disk_read(struct disk_info *disk, uint8_t *data_buf,
+			  uint32_t start_sector, uint32_t num_sector)
+{
+	if (start_sector + num_sector > SECTOR_COUNT) {
+		return -EIO;
+	}
+
+	slow_disk_delay(num_sector);
+	memcpy(data_buf, slow_data[start_sector], num_sector * SECTOR_SIZE);
+
+	return 0;
+}
+
+static int slow_disk_write(struct disk_info *disk, const uint8_t *data_buf,
+			   uint32_t start_sector, uint32_t num_sector)
+{
+	if (start_sector + num_sector > SECTOR_COUNT) {
+		return -EIO;
+	}
+
+	slow_disk_delay(num_sector);
+	memcpy(slow_data[start_sector], data_buf, num_sector * SECTOR_SIZE);
+
+	return 0;
+}
+
+static int slow_disk_ioctl(struct disk_info *disk, uint8_t cmd, void *buff)
+{
+	switch (cmd) {
+	case DISK_IOCTL_CTRL_SYNC:
+		break;
+	case DISK_IOCTL_GET_SECTOR_COUNT:
+		*(uint32_t *)buff = SECTOR_COUNT;
+		break;
+	case DISK_IOCTL_GET_SECTOR_SIZE:
+		*(uint32_t *)buff = SECTOR_SIZE;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static const struct disk_operations slow_disk_ops = {
+	.init = slow_disk_init,
+	.status = slow_disk_status,
+	.read = slow_disk_read,
+	.write = slow_disk_write,
+	.ioctl = slow_disk_ioctl,
+};
+
+static struct disk_info slow_disk = {
+	.name = "SLOW",
+	.ops = &slow_disk_ops,
+};
+
+static uint8_t buf[SECTOR_SIZE];
+
+/* Sector by sector reads, as done by a file system reading a file */
+static int sequential_read(const char *disk)
+{
+	for (uint32_t i = 0; i < SECTOR_COUNT; i++) {
+		int rc = disk_access_read(disk, buf, i, 1);
+
+		if (rc != 0) {
+			return rc;
+		}
+	}
+
+	return 0;
+}
+
+/* Repeated reads of a few sectors, like the FAT or a directory */
+static int hot_read(const char *disk)
+{
+	for (uint32_t i = 0; i < HOT_READS; i++) {
+		int rc = disk_access_read(disk, buf, (i * 3) % HOT_SECTORS, 1);
+
+		if (rc != 0) {
+			return rc;
+		}
+	}
+
+	return 0;
+}
+
+/* Sector by sector writes with a periodic sync, like appending to a file */
+static int small_writes(const char *disk)
+{
+	int rc;
+
+	for (uint32_t i = 0; i < SECTOR_COUNT; i++) {
+		memset(buf, i, sizeof(buf));
+		rc = disk_access_write(disk, buf, i, 1);
+		if (rc != 0) {
+			return rc;
+		}
+
+		if ((i + 1) % SYNC_INTERVAL == 0) {
+			rc = disk_access_ioctl(disk, DISK_IOCTL_CTRL_SYNC, NULL);
+			if (rc != 0) {
+				return rc;
+			}
+		}
+	}
+
+	return 0;
+}
+
+static int run(const char *disk, const char *name, int (*workload)(const char *))
+{
+	uint32_t start;
+	uint32_t us;
+	int rc;
+
+	/* Start every workload from a cold cache */
+	rc = disk_access_init(disk);
+	if (rc != 0) {
+		return rc;
+	}
+
+	slow_cmds = 0;
+	start = k_cycle_get_32();
+	rc = workload(disk);
+	us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+	if (rc != 0) {
+		return rc;
+	}
+
+	if (strcmp(disk, slow_disk.name) == 0) {
+		printk("%-4s %-16s %7u us, %4u commands\n", disk, name, us,
+		       slow_cmds);
+	} else {
+		printk("%-4s %-16s %7u us\n", disk, name, us);
+	}
+
+	return 0;
+}
+
+int main(void)
+{
+	static const char *const disks[] = { "RAM", "SLOW" };
+	int rc;
+
+	rc = disk_access_register(&slow_disk);
+	if (rc != 0) {
+		printk("disk_access_register failed: %d\n", rc);
+		return 0;
+	}
+
+	printk("%u sectors of %u bytes, SLOW disk takes %u us per command and "
+	       "%u us per sector\n", SECTOR_COUNT, SECTOR_SIZE, CMD_US, SECTOR_US);
+
+	for (int i = 0; rc == 0 && i < ARRAY_SIZE(disks); i++) {
+		rc = run(disks[i], "sequential read", sequential_read);
+		if (rc == 0) {
+			rc = run(disks[i], "hot read", hot_read);
+		}
+		if (rc == 0) {
+			rc = run(disks[i], "small writes", small_writes);
+		}
+	}
+	if (rc != 0) {
+		printk("run failed: %d\n", rc);
+	}
+
+#ifdef CONFIG_DISK_CACHE
+	struct disk_access_cache_stats stats;
+
+	disk_access_cache_stats_get(&stats);
+	printk("cache: %u hits, %u misses, %u read ahead, %u bypasses, "
+	       "%u sectors written back in %u commands\n", stats.hits,
+	       stats.misses, stats.read_ahead, stats.bypasses,
+	       stats.written_back, stats.write_backs);
+#endif
+
+	printk("fin\n");
+	return 0;
+}
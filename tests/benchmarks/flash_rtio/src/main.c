@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/storage/flash_map.h>
+
+#define IMAGE_SIZE (128 * 1024)
+#define BLOCK_SIZE 1024
+#define PAGE_SIZE 4096
+#define COMPUTE_US 1000
+#define MAX_DEPTH 4
+
+FLASH_DT_IODEV_DEFINE(flash_iodev, DT_CHOSEN(zephyr_flash_controller));
+
+RTIO_DEFINE(r_bench, 2 * MAX_DEPTH, 2 * MAX_DEPTH);
+
+static uint8_t blocks[MAX_DEPTH][BLOCK_SIZE];
+
+/* Stands for the processing needed before a block can be written */
+static void compute_block(uint8_t *block, size_t idx)
+{
+	memset(block, (uint8_t)idx, BLOCK_SIZE);
+	k_busy_wait(COMPUTE_US);
+}
+
+static void report(const char *name, uint32_t ms)
+{
+	printk("%-12s %u bytes in %5u ms, %7u B/s\n", name, IMAGE_SIZE, ms,
+	       (uint32_t)((uint64_t)IMAGE_SIZE * MSEC_PER_SEC / MAX(ms, 1)));
+}
+
+static int run_blocking(const struct device *dev, off_t base)
+{
+	uint32_t start = k_uptime_get_32();
+	int rc;
+
+	for (size_t i = 0; i < IMAGE_SIZE / BLOCK_SIZE; i++) {
+		off_t off = base + i * BLOCK_SIZE;
+
+		compute_block(blocks[0], i);
+
+		if ((off % PAGE_SIZE) == 0) {
+			rc = flash_erase(dev, off, PAGE_SIZE);
+			if (rc != 0) {
+				return rc;
+			}
+		}
+
+		rc = flash_write(dev, off, blocks[0], BLOCK_SIZE);
+		if (rc != 0) {
+			return rc;
+		}
+	}
+
+	report("blocking", k_uptime_get_32() - start);
+
+	return 0;
+}
+
+/* Consume the completions of the oldest block in flight */
+static int reap(int count)
+{
+	int rc = 0;
+
+	while (count-- > 0) {
+		struct rtio_cqe *cqe = rtio_cqe_consume_block(&r_bench);
+
+		if (cqe->result != 0) {
+			rc = cqe->result;
+		}
+		rtio_cqe_release(&r_bench, cqe);
+	}
+
+	return rc;
+}
+
+static int run_rtio(off_t base, int depth)
+{
+	int pending[MAX_DEPTH] = { 0 };
+	uint32_t start = k_uptime_get_32();
+	char name[16];
+	int rc;
+
+	for (size_t i = 0; i < IMAGE_SIZE / BLOCK_SIZE; i++) {
+		int slot = i % depth;
+		off_t off = base + i * BLOCK_SIZE;
+		struct rtio_sqe *sqe;
+
+		/* Reuse the buffer of the oldest block once it is written */
+		rc = reap(pending[slot]);
+		if (rc != 0) {
+			return rc;
+		}
+
+		compute_block(blocks[slot], i);
+
+		pending[slot] = 1;
+		if ((off % PAGE_SIZE) == 0) {
+			sqe = rtio_sqe_acquire(&r_bench);
+			rtio_sqe_prep_flash_erase(sqe, &flash_iodev, RTIO_PRIO_NORM,
+						  off, PAGE_SIZE, NULL);
+			sqe->flags |= RTIO_SQE_TRANSACTION;
+			pending[slot]++;
+		}
+
+		sqe = rtio_sqe_acquire(&r_bench);
+		rtio_sqe_prep_flash_write(sqe, &flash_iodev, RTIO_PRIO_NORM, off,
+					  blocks[slot], BLOCK_SIZE, NULL);
+
+		rtio_submit(&r_bench, 0);
+	}
+
+	for (size_t i = IMAGE_SIZE / BLOCK_SIZE; i < IMAGE_SIZE / BLOCK_SIZE + depth; i++) {
+		rc = reap(pending[i % depth]);
+		if (rc != 0) {
+			return rc;
+		}
+	}
+
+	snprintk(name, sizeof(name), "rtio depth %d", depth);
+	report(name, k_uptime_get_32() - start);
+
+	return 0;
+}
+
+int main(void)
+{
+	const struct flash_area *fa;
+	int rc;
+
+	rc = flash_area_open(FIXED_PARTITION_ID(slot1_partition), &fa);
+	if (rc != 0) {
+		printk("flash_area_open failed: %d\n", rc);
+		return 0;
+	}
+
+	printk("image %u bytes, blocks of %u bytes needing %u us of CPU time each\n",
+	       IMAGE_SIZE, BLOCK_SIZE, COMPUTE_US);
+
+	rc = run_blocking(flash_area_get_device(fa), fa->fa_off);
+	for (int depth = 1; rc == 0 && depth <= MAX_DEPTH; depth *= 2) {
+		rc = run_rtio(fa->fa_off, depth);
+	}
+	if (rc != 0) {
+		printk("run failed: %d\n", rc);
+	}
+
+	flash_area_close(fa);
+
+	printk("fin\n");
+	return 0;
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_ctrl.h>
+
+LOG_MODULE_REGISTER(bench, LOG_LEVEL_INF);
+
+/* Messages created between two flushes of the log buffer */
+#define BATCH 32
+#define BATCHES 32
+
+/* Backend discarding messages, only counts what reaches it */
+static uint32_t processed_cnt;
+
+static void bench_process(const struct log_backend *const backend,
+			  union log_msg_generic *msg)
+{
+	processed_cnt++;
+}
+
+static const struct log_backend_api bench_backend_api = {
+	.process = bench_process,
+};
+
+LOG_BACKEND_DEFINE(bench_backend, bench_backend_api, true);
+
+static char rw_str[] = "rw string";
+static volatile int val = 100;
+
+#define BENCH(name, ...) do { \
+	uint32_t total = 0; \
+	processed_cnt = 0; \
+	for (int b = 0; b < BATCHES; b++) { \
+		uint32_t start = k_cycle_get_32(); \
+		for (int i = 0; i < BATCH; i++) { \
+			LOG_INF(__VA_ARGS__); \
+		} \
+		total += k_cycle_get_32() - start; \
+		while (log_process()) { \
+		} \
+	} \
+	printk("%-14s %5u cycles per message, %u of %u processed\n", name, \
+	       total / (BATCH * BATCHES), processed_cnt, BATCH * BATCHES); \
+} while (false)
+
+int main(void)
+{
+	printk("%s message creation, format string validation %s, rate limiting %s\n",
+	       IS_ENABLED(CONFIG_LOG_ALWAYS_RUNTIME) ? "runtime" :
+	       (IS_ENABLED(CONFIG_LOG_SPEED) ? "zero copy" : "static"),
+	       IS_ENABLED(CONFIG_LOG_FMT_STRING_VALIDATE) ? "on" : "off",
+	       IS_ENABLED(CONFIG_LOG_RATELIMIT) ? "on" : "off");
+
+	BENCH("no arguments", "no arguments");
+	BENCH("1 integer", "integer %d", val);
+	BENCH("4 integers", "integers %d %d %d %d", val, val + 1, val + 2, val + 3);
+	BENCH("ro string", "string %s", "ro string");
+	BENCH("rw string", "string %s", rw_str);
+	BENCH("rw string, int", "string %s integer %d", rw_str, val);
+
+	printk("fin\n");
+	return 0;
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_ctrl.h>
+
+LOG_MODULE_REGISTER(bench, LOG_LEVEL_INF);
+
+#define MSGS_PER_CPU 2000
+#define STACK_SIZE 2048
+#define PRIORITY 5
+
+/* Backend discarding messages, only counts what reaches it */
+static uint32_t processed_cnt;
+
+static void bench_process(const struct log_backend *const backend,
+			  union log_msg_generic *msg)
+{
+	processed_cnt++;
+}
+
+static const struct log_backend_api bench_backend_api = {
+	.process = bench_process,
+};
+
+LOG_BACKEND_DEFINE(bench_backend, bench_backend_api, true);
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, CONFIG_MP_MAX_NUM_CPUS, STACK_SIZE);
+static struct k_thread threads[CONFIG_MP_MAX_NUM_CPUS];
+static uint32_t cycles[CONFIG_MP_MAX_NUM_CPUS];
+
+static void producer(void *p1, void *p2, void *p3)
+{
+	uintptr_t id = (uintptr_t)p1;
+	uint32_t start = k_cycle_get_32();
+
+	for (uint32_t i = 0; i < MSGS_PER_CPU; i++) {
+		LOG_INF("cpu %u message %u", (uint32_t)id, i);
+	}
+
+	cycles[id] = k_cycle_get_32() - start;
+}
+
+static void run(unsigned int cpus)
+{
+	uint32_t total_cycles = 0;
+
+	for (unsigned int i = 0; i < cpus; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, producer,
+				(void *)(uintptr_t)i, NULL, NULL, PRIORITY, 0,
+				K_FOREVER);
+		k_thread_cpu_pin(&threads[i], i);
+	}
+
+	/* Logging takes much longer than starting all producers */
+	for (unsigned int i = 0; i < cpus; i++) {
+		k_thread_start(&threads[i]);
+	}
+
+	for (unsigned int i = 0; i < cpus; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+		total_cycles += cycles[i];
+	}
+
+	/* Let the processing thread drain the buffers */
+	while (log_buffered_cnt() > 0) {
+		k_msleep(10);
+	}
+
+	printk("cpus %u: %5u cycles per message, %5u of %5u dropped\n", cpus,
+	       total_cycles / (cpus * MSGS_PER_CPU),
+	       cpus * MSGS_PER_CPU - processed_cnt, cpus * MSGS_PER_CPU);
+
+	processed_cnt = 0;
+}
+
+int main(void)
+{
+	printk("%u messages per CPU, %s\n", MSGS_PER_CPU,
+	       IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFERS) ?
+	       "per-CPU buffers" : "shared buffer");
+
+	for (unsigned int cpus = 1; cpus <= arch_num_cpus(); cpus++) {
+		run(cpus);
+	}
+
+	printk("fin\n");
+	return 0;
+}
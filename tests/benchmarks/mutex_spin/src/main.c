@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+#define ROUNDS 5000
+#define STACK_SIZE 1024
+#define MAX_THREADS CONFIG_MP_MAX_NUM_CPUS
+
+/* A short critical section, and some work outside of it */
+#define INSIDE_US 1
+#define OUTSIDE_US 2
+
+#define MAIN_PRIO K_PRIO_COOP(0)
+#define WORKER_PRIO K_PRIO_PREEMPT(1)
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, MAX_THREADS, STACK_SIZE);
+static struct k_thread threads[MAX_THREADS];
+static K_MUTEX_DEFINE(mutex);
+static struct k_sem sems[2];
+static volatile uint32_t counter;
+
+static void locker(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < ROUNDS; i++) {
+		k_mutex_lock(&mutex, K_FOREVER);
+		counter++;
+		k_busy_wait(INSIDE_US);
+		k_mutex_unlock(&mutex);
+
+		k_busy_wait(OUTSIDE_US);
+	}
+}
+
+/* Threads of the pair wake each other up through their semaphores */
+static void ping_pong(void *p1, void *p2, void *p3)
+{
+	struct k_sem *own = p1;
+	struct k_sem *peer = p2;
+	bool first = (bool)(uintptr_t)p3;
+
+	for (int i = 0; i < ROUNDS; i++) {
+		if (first) {
+			k_sem_give(peer);
+			k_sem_take(own, K_FOREVER);
+		} else {
+			k_sem_take(own, K_FOREVER);
+			k_sem_give(peer);
+		}
+	}
+}
+
+static void create(int idx, k_thread_entry_t entry, void *p1, void *p2,
+		   void *p3)
+{
+	k_thread_create(&threads[idx], stacks[idx], STACK_SIZE, entry, p1, p2,
+			p3, WORKER_PRIO, 0, K_FOREVER);
+#ifdef CONFIG_SCHED_CPU_MASK
+	(void)k_thread_cpu_pin(&threads[idx], idx % arch_num_cpus());
+#endif
+}
+
+/* Runs the threads, returns the number of rounds per second */
+static uint32_t run(int count)
+{
+	uint32_t start = k_cycle_get_32();
+	uint32_t cycles;
+
+	for (int i = 0; i < count; i++) {
+		k_thread_start(&threads[i]);
+	}
+
+	for (int i = 0; i < count; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	cycles = MAX(k_cycle_get_32() - start, 1);
+
+	return (uint32_t)((uint64_t)ROUNDS * sys_clock_hw_cycles_per_sec() /
+			  cycles);
+}
+
+int main(void)
+{
+	k_thread_priority_set(k_current_get(), MAIN_PRIO);
+
+	printk("%u CPUs, adaptive spinning %s\n", arch_num_cpus(),
+	       IS_ENABLED(CONFIG_SMP_ADAPTIVE_SPIN) ? "enabled" : "disabled");
+
+	for (int count = 2; count <= MIN(arch_num_cpus(), MAX_THREADS); count++) {
+		for (int i = 0; i < count; i++) {
+			create(i, locker, NULL, NULL, NULL);
+		}
+
+		printk("mutex, %d threads: %8u locks/s\n", count,
+		       run(count) * count);
+	}
+
+	k_sem_init(&sems[0], 0, 1);
+	k_sem_init(&sems[1], 0, 1);
+	create(0, ping_pong, &sems[0], &sems[1], (void *)true);
+	create(1, ping_pong, &sems[1], &sems[0], (void *)false);
+
+	printk("semaphore ping-pong: %8u round trips/s\n", run(2));
+
+	printk("fin\n");
+	return 0;
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+#define MAX_OBJECTS 256
+#define ROUNDS 1000
+#define STACK_SIZE 1024
+
+/* The waiter preempts the producer on every event */
+#define PRODUCER_PRIO K_PRIO_PREEMPT(2)
+#define WAITER_PRIO K_PRIO_PREEMPT(1)
+
+static struct k_sem sems[MAX_OBJECTS];
+static struct k_poll_event events[MAX_OBJECTS];
+static struct k_poll_set set;
+
+static K_THREAD_STACK_DEFINE(waiter_stack, STACK_SIZE);
+static struct k_thread waiter_thread;
+
+/* Waits for one of the first @p num semaphores, and takes it */
+static void poll_waiter(void *p1, void *p2, void *p3)
+{
+	int num = POINTER_TO_INT(p1);
+
+	for (int i = 0; i < ROUNDS; i++) {
+		(void)k_poll(events, num, K_FOREVER);
+
+		for (int j = 0; j < num; j++) {
+			if (events[j].state != K_POLL_STATE_NOT_READY) {
+				events[j].state = K_POLL_STATE_NOT_READY;
+				(void)k_sem_take(events[j].sem, K_NO_WAIT);
+			}
+		}
+	}
+}
+
+static void set_waiter(void *p1, void *p2, void *p3)
+{
+	struct k_poll_event *ready[1];
+
+	for (int i = 0; i < ROUNDS; i++) {
+		(void)k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_FOREVER);
+		(void)k_sem_take(ready[0]->sem, K_NO_WAIT);
+	}
+}
+
+/* Cycles from the give of a semaphore to the return of the next one,
+ * through a wakeup of the waiter
+ */
+static uint32_t run(k_thread_entry_t waiter, int num)
+{
+	uint32_t start;
+
+	k_thread_create(&waiter_thread, waiter_stack, STACK_SIZE, waiter,
+			INT_TO_POINTER(num), NULL, NULL, WAITER_PRIO, 0,
+			K_NO_WAIT);
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < ROUNDS; i++) {
+		k_sem_give(&sems[(i * 7) % num]);
+	}
+
+	k_thread_join(&waiter_thread, K_FOREVER);
+
+	return (k_cycle_get_32() - start) / ROUNDS;
+}
+
+int main(void)
+{
+	k_thread_priority_set(k_current_get(), PRODUCER_PRIO);
+
+	for (int i = 0; i < MAX_OBJECTS; i++) {
+		k_sem_init(&sems[i], 0, 1);
+		k_poll_event_init(&events[i], K_POLL_TYPE_SEM_AVAILABLE,
+				  K_POLL_MODE_NOTIFY_ONLY, &sems[i]);
+	}
+
+	printk("cycles per wakeup, waiting on semaphores\n");
+
+	for (int num = 1; num <= MAX_OBJECTS; num *= 2) {
+		uint32_t poll_cycles = run(poll_waiter, num);
+
+		k_poll_set_init(&set);
+		for (int i = 0; i < num; i++) {
+			(void)k_poll_set_add(&set, &events[i]);
+		}
+
+		printk("objects %3d: %8u cycles k_poll, %8u cycles k_poll_set\n",
+		       num, poll_cycles, run(set_waiter, num));
+
+		for (int i = 0; i < num; i++) {
+			(void)k_poll_set_remove(&set, &events[i]);
+		}
+	}
+
+	printk("fin\n");
+	return 0;
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/spsc_pbuf.h>
+
+#define MSG_SIZE 8
+#define MAX_MSGS 16
+#define ROUNDS 10000
+#define STACK_SIZE 1024
+
+/* A waiting consumer preempts the producer on every message */
+#define PRODUCER_PRIO K_PRIO_PREEMPT(2)
+#define CONSUMER_PRIO K_PRIO_PREEMPT(1)
+
+K_RINGQ_DEFINE(ringq, MSG_SIZE, MAX_MSGS, 0);
+K_MSGQ_DEFINE(msgq, MSG_SIZE, MAX_MSGS, 4);
+static uint32_t pbuf_mem[(MAX_MSGS * (MSG_SIZE + 4) + 64) / sizeof(uint32_t)];
+static struct spsc_pbuf *pbuf;
+
+static K_THREAD_STACK_DEFINE(consumer_stack, STACK_SIZE);
+static struct k_thread consumer_thread;
+
+/* Operations of a queue, with K_NO_WAIT unless a timeout is given */
+struct queue_ops {
+	const char *name;
+	int (*put)(const void *data);
+	int (*get)(void *data, k_timeout_t timeout);
+};
+
+static int ringq_put(const void *data)
+{
+	return k_ringq_put(&ringq, data, K_NO_WAIT);
+}
+
+static int ringq_get(void *data, k_timeout_t timeout)
+{
+	return k_ringq_get(&ringq, data, timeout);
+}
+
+static int msgq_put(const void *data)
+{
+	return k_msgq_put(&msgq, data, K_NO_WAIT);
+}
+
+static int msgq_get(void *data, k_timeout_t timeout)
+{
+	return k_msgq_get(&msgq, data, timeout);
+}
+
+static int pbuf_put(const void *data)
+{
+	return (spsc_pbuf_write(pbuf, data, MSG_SIZE) == MSG_SIZE) ? 0 : -ENOMEM;
+}
+
+static int pbuf_get(void *data, k_timeout_t timeout)
+{
+	return (spsc_pbuf_read(pbuf, data, MSG_SIZE) == MSG_SIZE) ? 0 : -EAGAIN;
+}
+
+static const struct queue_ops queues[] = {
+	{ "k_ringq", ringq_put, ringq_get },
+	{ "k_msgq", msgq_put, msgq_get },
+	{ "spsc_pbuf", pbuf_put, pbuf_get },
+};
+
+/* Nobody waits: the cost of the queue itself */
+static uint32_t uncontended(const struct queue_ops *ops)
+{
+	uint8_t msg[MSG_SIZE] = { 0 };
+	uint32_t start = k_cycle_get_32();
+
+	for (int i = 0; i < ROUNDS; i++) {
+		for (int j = 0; j < MAX_MSGS / 2; j++) {
+			msg[0] = j;
+			(void)ops->put(msg);
+		}
+		for (int j = 0; j < MAX_MSGS / 2; j++) {
+			(void)ops->get(msg, K_NO_WAIT);
+		}
+	}
+
+	return (k_cycle_get_32() - start) / (ROUNDS * (MAX_MSGS / 2));
+}
+
+static void consumer(void *p1, void *p2, void *p3)
+{
+	const struct queue_ops *ops = p1;
+	uint8_t msg[MSG_SIZE];
+
+	for (int i = 0; i < ROUNDS * (MAX_MSGS / 2); i++) {
+		(void)ops->get(msg, K_FOREVER);
+	}
+}
+
+/* The consumer blocks on the empty queue, and is woken by every message */
+static uint32_t blocking(const struct queue_ops *ops)
+{
+	uint8_t msg[MSG_SIZE] = { 0 };
+	uint32_t start = k_cycle_get_32();
+
+	k_thread_create(&consumer_thread, consumer_stack, STACK_SIZE, consumer,
+			(void *)ops, NULL, NULL, CONSUMER_PRIO, 0, K_NO_WAIT);
+
+	for (int i = 0; i < ROUNDS * (MAX_MSGS / 2); i++) {
+		(void)ops->put(msg);
+	}
+
+	k_thread_join(&consumer_thread, K_FOREVER);
+
+	return (k_cycle_get_32() - start) / (ROUNDS * (MAX_MSGS / 2));
+}
+
+int main(void)
+{
+	k_thread_priority_set(k_current_get(), PRODUCER_PRIO);
+
+	pbuf = spsc_pbuf_init(pbuf_mem, sizeof(pbuf_mem), 0);
+
+	printk("%u byte messages, bursts of %u\n", MSG_SIZE, MAX_MSGS / 2);
+
+	for (int i = 0; i < ARRAY_SIZE(queues); i++) {
+		printk("%-10s %6u cycles per message", queues[i].name,
+		       uncontended(&queues[i]));
+
+		/* The packet buffer has no way to wait for data */
+		if (queues[i].get != pbuf_get) {
+			printk(", %6u with a blocked consumer",
+			       blocking(&queues[i]));
+		}
+		printk("\n");
+	}
+
+	printk("fin\n");
+	return 0;
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+#define ROUNDS 20000
+#define STACK_SIZE 1024
+#define MAX_THREADS CONFIG_MP_MAX_NUM_CPUS
+#define TABLE_SIZE 16
+
+/* One write per this many operations in the read mostly runs */
+#define WRITE_EVERY 16
+
+#define MAIN_PRIO K_PRIO_COOP(0)
+#define WORKER_PRIO K_PRIO_PREEMPT(1)
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, MAX_THREADS, STACK_SIZE);
+static struct k_thread threads[MAX_THREADS];
+static K_MUTEX_DEFINE(mutex);
+static struct k_rwlock rwlock;
+
+/* The data protected by the locks, read by a lookup */
+static volatile uint32_t table[TABLE_SIZE];
+
+static uint32_t lookup(void)
+{
+	uint32_t sum = 0;
+
+	for (int i = 0; i < TABLE_SIZE; i++) {
+		sum += table[i];
+	}
+
+	return sum;
+}
+
+static void update(int round)
+{
+	table[round % TABLE_SIZE]++;
+}
+
+/* One lookup out of @p p2 is an update instead, none if zero */
+static void mutex_worker(void *p1, void *p2, void *p3)
+{
+	int write_every = POINTER_TO_INT(p2);
+
+	for (int i = 1; i <= ROUNDS; i++) {
+		k_mutex_lock(&mutex, K_FOREVER);
+		if ((write_every != 0) && ((i % write_every) == 0)) {
+			update(i);
+		} else {
+			(void)lookup();
+		}
+		k_mutex_unlock(&mutex);
+	}
+}
+
+static void rwlock_worker(void *p1, void *p2, void *p3)
+{
+	int write_every = POINTER_TO_INT(p2);
+
+	for (int i = 1; i <= ROUNDS; i++) {
+		if ((write_every != 0) && ((i % write_every) == 0)) {
+			k_rwlock_write_lock(&rwlock, K_FOREVER);
+			update(i);
+			k_rwlock_write_unlock(&rwlock);
+		} else {
+			k_rwlock_read_lock(&rwlock, K_FOREVER);
+			(void)lookup();
+			k_rwlock_read_unlock(&rwlock);
+		}
+	}
+}
+
+/* Runs the workers, returns the number of operations per second */
+static uint32_t run(int count, k_thread_entry_t entry, int write_every)
+{
+	uint32_t start;
+	uint32_t cycles;
+
+	for (int i = 0; i < count; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, entry,
+				INT_TO_POINTER(i), INT_TO_POINTER(write_every),
+				NULL, WORKER_PRIO, 0, K_FOREVER);
+#ifdef CONFIG_SCHED_CPU_MASK
+		(void)k_thread_cpu_pin(&threads[i], i % arch_num_cpus());
+#endif
+	}
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < count; i++) {
+		k_thread_start(&threads[i]);
+	}
+
+	for (int i = 0; i < count; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	cycles = MAX(k_cycle_get_32() - start, 1);
+
+	return (uint32_t)((uint64_t)ROUNDS * count *
+			  sys_clock_hw_cycles_per_sec() / cycles);
+}
+
+static void run_all(int count, int write_every)
+{
+	uint32_t mutex_ops = run(count, mutex_worker, write_every);
+	uint32_t rwlock_ops;
+	uint32_t fair_ops;
+
+	k_rwlock_init(&rwlock, 0);
+	rwlock_ops = run(count, rwlock_worker, write_every);
+	k_rwlock_init(&rwlock, K_RWLOCK_FAIR);
+	fair_ops = run(count, rwlock_worker, write_every);
+
+	printk("%d threads, %-12s %8u k_mutex, %8u k_rwlock, %8u k_rwlock fair\n",
+	       count, (write_every != 0) ? "read mostly:" : "read only:",
+	       mutex_ops, rwlock_ops, fair_ops);
+}
+
+int main(void)
+{
+	k_thread_priority_set(k_current_get(), MAIN_PRIO);
+
+	printk("%u CPUs, lock operations per second\n", arch_num_cpus());
+
+	for (int count = 1; count <= MIN(arch_num_cpus(), MAX_THREADS); count++) {
+		run_all(count, 0);
+		run_all(count, WRITE_EVERY);
+	}
+
+	printk("fin\n");
+	return 0;
+}
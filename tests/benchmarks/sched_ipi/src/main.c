@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+#define ROUNDS 500
+#define WORKERS 4
+#define STACK_SIZE 1024
+
+/* The producer preempts everything, the busy threads occupying the other
+ * CPUs can not be preempted by the workers it wakes up.
+ */
+#define PRODUCER_PRIO 1
+#define BUSY_PRIO 2
+#define WORKER_PRIO 3
+
+static K_THREAD_STACK_ARRAY_DEFINE(busy_stacks, CONFIG_MP_MAX_NUM_CPUS, STACK_SIZE);
+static struct k_thread busy_threads[CONFIG_MP_MAX_NUM_CPUS];
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, WORKERS, STACK_SIZE);
+static struct k_thread worker_threads[WORKERS];
+static struct k_sem worker_sems[WORKERS];
+static volatile bool done;
+
+static void busy(void *p1, void *p2, void *p3)
+{
+	while (!done) {
+		k_busy_wait(100);
+	}
+}
+
+static void worker(void *p1, void *p2, void *p3)
+{
+	struct k_sem *sem = p1;
+
+	while (true) {
+		k_sem_take(sem, K_FOREVER);
+	}
+}
+
+static uint32_t ipi_count(void)
+{
+	k_thread_runtime_stats_t stats;
+
+	k_thread_runtime_stats_all_get(&stats);
+
+	return stats.ipi_count;
+}
+
+int main(void)
+{
+	unsigned int num_cpus = arch_num_cpus();
+	uint32_t ipis;
+
+	k_thread_priority_set(k_current_get(), PRODUCER_PRIO);
+
+	for (int i = 0; i < WORKERS; i++) {
+		k_sem_init(&worker_sems[i], 0, 1);
+		k_thread_create(&worker_threads[i], worker_stacks[i], STACK_SIZE,
+				worker, &worker_sems[i], NULL, NULL, WORKER_PRIO, 0,
+				K_NO_WAIT);
+	}
+
+	for (unsigned int i = 0; i < num_cpus - 1; i++) {
+		k_thread_create(&busy_threads[i], busy_stacks[i], STACK_SIZE,
+				busy, NULL, NULL, NULL, BUSY_PRIO, 0, K_NO_WAIT);
+	}
+
+	/* Let the workers pend and the busy threads take the other CPUs */
+	k_msleep(10);
+
+	ipis = ipi_count();
+
+	for (int round = 0; round < ROUNDS; round++) {
+		for (int i = 0; i < WORKERS; i++) {
+			k_sem_give(&worker_sems[i]);
+		}
+
+		/* Workers run on this CPU while it sleeps */
+		k_msleep(1);
+	}
+
+	ipis = ipi_count() - ipis;
+
+	done = true;
+	for (unsigned int i = 0; i < num_cpus - 1; i++) {
+		k_thread_join(&busy_threads[i], K_FOREVER);
+	}
+
+	printk("%u CPUs, %s\n", num_cpus,
+	       IS_ENABLED(CONFIG_IPI_OPTIMIZE) ? "optimized IPIs" : "broadcast IPIs");
+	printk("%u wakeups, %5u IPIs\n", ROUNDS * WORKERS, ipis);
+
+	printk("fin\n");
+	return 0;
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+#define ROUNDS 1000
+#define MAX_FILLERS 64
+#define STACK_SIZE 1024
+
+/* The fillers are queued ahead of the waiter but pinned to another CPU,
+ * the waiter has to be found past them when the main thread blocks.
+ */
+#define MAIN_PRIO K_PRIO_PREEMPT(1)
+#define FILLER_PRIO K_PRIO_PREEMPT(2)
+#define WAITER_PRIO K_PRIO_PREEMPT(3)
+
+static K_THREAD_STACK_ARRAY_DEFINE(filler_stacks, MAX_FILLERS, STACK_SIZE);
+static struct k_thread filler_threads[MAX_FILLERS];
+static K_THREAD_STACK_DEFINE(waiter_stack, STACK_SIZE);
+static struct k_thread waiter_thread;
+static K_SEM_DEFINE(wake_sem, 0, 1);
+static K_SEM_DEFINE(ack_sem, 0, 1);
+static volatile bool done;
+
+static void filler(void *p1, void *p2, void *p3)
+{
+	while (!done) {
+		k_yield();
+	}
+}
+
+static void waiter(void *p1, void *p2, void *p3)
+{
+	while (true) {
+		k_sem_take(&wake_sem, K_FOREVER);
+		k_sem_give(&ack_sem);
+	}
+}
+
+static void start_pinned(struct k_thread *thread, k_thread_stack_t *stack,
+			 k_thread_entry_t entry, int prio, int cpu)
+{
+	k_thread_create(thread, stack, STACK_SIZE, entry, NULL, NULL, NULL,
+			prio, 0, K_FOREVER);
+	k_thread_cpu_pin(thread, cpu);
+	k_thread_start(thread);
+}
+
+static void run(int fillers)
+{
+	uint32_t start;
+	uint32_t cycles;
+
+	done = false;
+	for (int i = 0; i < fillers; i++) {
+		start_pinned(&filler_threads[i], filler_stacks[i], filler,
+			     FILLER_PRIO, 1);
+	}
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < ROUNDS; i++) {
+		k_sem_give(&wake_sem);
+		k_sem_take(&ack_sem, K_FOREVER);
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	done = true;
+	for (int i = 0; i < fillers; i++) {
+		k_thread_join(&filler_threads[i], K_FOREVER);
+	}
+
+	printk("%3d ready threads pinned elsewhere: %6u cycles per wakeup\n",
+	       fillers, cycles / ROUNDS);
+}
+
+int main(void)
+{
+	k_thread_priority_set(k_current_get(), MAIN_PRIO);
+
+	/* Main and waiter share CPU 0, the fillers all wait for CPU 1 */
+	start_pinned(&waiter_thread, waiter_stack, waiter, WAITER_PRIO, 0);
+	k_msleep(1);
+
+	printk("%u CPUs, %s run queue\n", arch_num_cpus(),
+	       IS_ENABLED(CONFIG_SCHED_DUMB) ? "dumb" :
+	       IS_ENABLED(CONFIG_SCHED_SCALABLE) ? "scalable" : "multiq");
+
+	for (int fillers = 0; fillers <= MAX_FILLERS; fillers = MAX(fillers * 4, 4)) {
+		run(fillers);
+	}
+
+	printk("fin\n");
+	return 0;
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+#define ROUNDS 2000
+#define STACK_SIZE 1024
+#define MAX_WORKERS (2 * CONFIG_MP_MAX_NUM_CPUS)
+
+/* The main thread preempts everything, the busy threads parking the CPUs
+ * not taking part in a run can not be preempted by the workers.
+ */
+#define MAIN_PRIO K_PRIO_COOP(0)
+#define BUSY_PRIO K_PRIO_COOP(1)
+#define WORKER_PRIO K_PRIO_PREEMPT(1)
+
+static K_THREAD_STACK_ARRAY_DEFINE(busy_stacks, CONFIG_MP_MAX_NUM_CPUS, STACK_SIZE);
+static struct k_thread busy_threads[CONFIG_MP_MAX_NUM_CPUS];
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, MAX_WORKERS, STACK_SIZE);
+static struct k_thread worker_threads[MAX_WORKERS];
+static struct k_sem sems[MAX_WORKERS];
+static volatile bool parked;
+
+static void busy(void *p1, void *p2, void *p3)
+{
+	while (parked) {
+		k_busy_wait(100);
+	}
+}
+
+/* Threads of a pair wake each other up through their semaphores */
+static void ping_pong(void *p1, void *p2, void *p3)
+{
+	struct k_sem *own = p1;
+	struct k_sem *peer = p2;
+	bool first = (bool)(uintptr_t)p3;
+
+	for (int i = 0; i < ROUNDS; i++) {
+		if (first) {
+			k_sem_give(peer);
+			k_sem_take(own, K_FOREVER);
+		} else {
+			k_sem_take(own, K_FOREVER);
+			k_sem_give(peer);
+		}
+	}
+}
+
+static void yielder(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < ROUNDS; i++) {
+		k_yield();
+	}
+}
+
+/* Runs the workers, returns the number of operations per second */
+static uint32_t run_workers(unsigned int count, uint32_t ops)
+{
+	uint32_t start = k_cycle_get_32();
+	uint32_t cycles;
+
+	for (unsigned int i = 0; i < count; i++) {
+		k_thread_start(&worker_threads[i]);
+	}
+
+	for (unsigned int i = 0; i < count; i++) {
+		k_thread_join(&worker_threads[i], K_FOREVER);
+	}
+
+	cycles = MAX(k_cycle_get_32() - start, 1);
+
+	return (uint32_t)((uint64_t)ops * sys_clock_hw_cycles_per_sec() / cycles);
+}
+
+static uint32_t wakeups(unsigned int cpus)
+{
+	for (unsigned int i = 0; i < 2 * cpus; i++) {
+		k_sem_init(&sems[i], 0, 1);
+	}
+
+	for (unsigned int i = 0; i < 2 * cpus; i++) {
+		k_thread_create(&worker_threads[i], worker_stacks[i], STACK_SIZE,
+				ping_pong, &sems[i], &sems[i ^ 1],
+				(void *)(uintptr_t)((i & 1) == 0), WORKER_PRIO, 0,
+				K_FOREVER);
+	}
+
+	return run_workers(2 * cpus, 2 * cpus * ROUNDS);
+}
+
+static uint32_t switches(unsigned int cpus)
+{
+	for (unsigned int i = 0; i < 2 * cpus; i++) {
+		k_thread_create(&worker_threads[i], worker_stacks[i], STACK_SIZE,
+				yielder, NULL, NULL, NULL, WORKER_PRIO, 0, K_FOREVER);
+	}
+
+	return run_workers(2 * cpus, 2 * cpus * ROUNDS);
+}
+
+static void run(unsigned int cpus)
+{
+	unsigned int num_parked = arch_num_cpus() - cpus;
+	uint32_t wakeup_rate;
+	uint32_t switch_rate;
+
+	parked = true;
+	for (unsigned int i = 0; i < num_parked; i++) {
+		k_thread_create(&busy_threads[i], busy_stacks[i], STACK_SIZE,
+				busy, NULL, NULL, NULL, BUSY_PRIO, 0, K_NO_WAIT);
+	}
+
+	/* Let the busy threads take the CPUs left out of this run */
+	k_msleep(10);
+
+	wakeup_rate = wakeups(cpus);
+	switch_rate = switches(cpus);
+
+	parked = false;
+	for (unsigned int i = 0; i < num_parked; i++) {
+		k_thread_join(&busy_threads[i], K_FOREVER);
+	}
+
+	printk("cpus %u: %8u wakeups/s, %8u switches/s\n", cpus, wakeup_rate,
+	       switch_rate);
+}
+
+int main(void)
+{
+	k_thread_priority_set(k_current_get(), MAIN_PRIO);
+
+	printk("%u CPUs, %s\n", arch_num_cpus(),
+	       IS_ENABLED(CONFIG_SCHED_CPU_RUNQ) ?
+	       "per-CPU run queues" : "global run queue");
+
+	for (unsigned int cpus = 1; cpus <= arch_num_cpus(); cpus++) {
+		run(cpus);
+	}
+
+	printk("fin\n");
+	return 0;
+}
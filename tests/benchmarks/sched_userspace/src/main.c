@@ -43,7 +43,27 @@ static inline int stamp(int state)
 	return t;
 }
 
+/* Locks shared by all the user threads */
+K_APPMEM_PARTITION_DEFINE(lock_partition);
+K_APP_BMEM(lock_partition) SYS_MUTEX_DEFINE(bench_sys_mutex);
+K_MUTEX_DEFINE(bench_k_mutex);
+
+#ifdef CONFIG_TRACING_SYSCALL
+/* Syscalls made by the user threads, counted from the tracing hook which
+ * runs in the calling thread before the syscall
+ */
+static K_APP_BMEM(lock_partition) atomic_t nb_syscalls;
+
+void sys_trace_syscall_enter_user(uint32_t syscall_id, const char *syscall_name)
+{
+	if (k_is_user_context()) {
+		atomic_inc(&nb_syscalls);
+	}
+}
+#endif
+
 static int yielder_status;
+static k_thread_entry_t user_entry;
 
 void yielder_entry(void *_thread, void *_tid, void *_nb_threads)
 {
@@ -52,6 +72,7 @@ void yielder_entry(void *_thread, void *_tid, void *_nb_threads)
 
 	struct k_mem_partition *parts[] = {
 		thread->partition,
+		&lock_partition,
 	};
 
 	ret = k_mem_domain_init(&thread->domain, ARRAY_SIZE(parts), parts);
@@ -63,20 +84,17 @@ void yielder_entry(void *_thread, void *_tid, void *_nb_threads)
 
 	k_mem_domain_add_thread(&thread->domain, k_current_get());
 
-	k_thread_user_mode_enter(context_switch_yield, _nb_threads, NULL, NULL);
+	k_thread_user_mode_enter(user_entry, _nb_threads, NULL, NULL);
 }
 
 
 static k_tid_t threads[MAX_NB_THREADS];
 
-static int exec_test(uint8_t nb_threads)
+/* Runs @p entry in @p nb_threads user threads, returns the cycles taken */
+static uint32_t exec_test(k_thread_entry_t entry, uint8_t nb_threads)
 {
-	if (nb_threads > MAX_NB_THREADS) {
-		printk("Too many threads\n");
-		return 1;
-	}
-
 	yielder_status = 0;
+	user_entry = entry;
 
 	for (size_t tid = 0; tid < nb_threads; tid++) {
 		app_threads[tid].partition = app_partitions[tid];
@@ -89,6 +107,7 @@ static int exec_test(uint8_t nb_threads)
 					APP_STACKSIZE, yielder_entry,
 					&app_threads[tid], _tid, (void *)(uintptr_t)nb_threads,
 					THREADS_PRIO, 0, K_FOREVER);
+		k_object_access_grant(&bench_k_mutex, threads[tid]);
 	}
 
 	/* make sure the main thread has a higher priority
@@ -106,7 +125,17 @@ static int exec_test(uint8_t nb_threads)
 	}
 	stamp(MEAS_END);
 
-	uint32_t full_time = stamps[MEAS_END] - stamps[MEAS_START];
+	return stamps[MEAS_END] - stamps[MEAS_START];
+}
+
+static int exec_yield_test(uint8_t nb_threads)
+{
+	if (nb_threads > MAX_NB_THREADS) {
+		printk("Too many threads\n");
+		return 1;
+	}
+
+	uint32_t full_time = exec_test(context_switch_yield, nb_threads);
 	uint64_t time_ms = k_cyc_to_ns_near64(full_time)/NB_YIELDS;
 
 	printk("Swapping %2u threads: %8" PRIu32 " cyc & %6" PRIu32 " rounds -> %6"
@@ -116,6 +145,30 @@ static int exec_test(uint8_t nb_threads)
 	return yielder_status;
 }
 
+/* k_mutex makes a syscall for each lock and unlock, sys_mutex only does
+ * when the mutex is contended, with TLS
+ */
+static int exec_mutex_test(const char *name, k_thread_entry_t entry,
+			   uint8_t nb_threads)
+{
+#ifdef CONFIG_TRACING_SYSCALL
+	atomic_clear(&nb_syscalls);
+#endif
+
+	uint32_t full_time = exec_test(entry, nb_threads);
+	uint64_t time_ns = k_cyc_to_ns_near64(full_time)/NB_LOCKS;
+
+	printk("%-9s %u threads: %8" PRIu32 " cyc & %6" PRIu32 " rounds -> %6"
+				PRIu64 " ns per lock/unlock\n", name, nb_threads,
+				full_time, NB_LOCKS, time_ns);
+#ifdef CONFIG_TRACING_SYSCALL
+	printk("%-9s %u threads: %8ld syscalls & %6" PRIu32 " rounds\n",
+	       name, nb_threads, atomic_get(&nb_syscalls), NB_LOCKS);
+#endif
+
+	return yielder_status;
+}
+
 
 int main(void)
 {
@@ -129,7 +182,20 @@ int main(void)
 	printk("user/user^n swapping (yield)\n");
 
 	for (size_t i = 0; nb_threads_list[i] > 0; i++) {
-		ret = exec_test(nb_threads_list[i]);
+		ret = exec_yield_test(nb_threads_list[i]);
+		if (ret != 0) {
+			printk("FAIL\n");
+			return 0;
+		}
+	}
+
+	printk("============================\n");
+	printk("user mutex lock/unlock (1 thread: uncontended)\n");
+
+	for (uint8_t nb_threads = 1; nb_threads <= 2; nb_threads++) {
+		ret = exec_mutex_test("k_mutex", k_mutex_lock_unlock, nb_threads);
+		ret |= exec_mutex_test("sys_mutex", sys_mutex_lock_unlock,
+				       nb_threads);
 		if (ret != 0) {
 			printk("FAIL\n");
 			return 0;
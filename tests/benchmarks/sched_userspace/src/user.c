@@ -19,3 +19,36 @@ void context_switch_yield(void *p1, void *p2, void *p3)
 		k_yield();
 	}
 }
+
+/* When contended, the owner yields while holding the mutex, so the other
+ * threads block on it and get it handed over on unlock
+ */
+void k_mutex_lock_unlock(void *p1, void *p2, void *p3)
+{
+	uint32_t nb_threads = (uint32_t)(uintptr_t) p1;
+	uint32_t rounds = NB_LOCKS / nb_threads;
+	bool contended = nb_threads > 1;
+
+	while (rounds--) {
+		k_mutex_lock(&bench_k_mutex, K_FOREVER);
+		if (contended) {
+			k_yield();
+		}
+		k_mutex_unlock(&bench_k_mutex);
+	}
+}
+
+void sys_mutex_lock_unlock(void *p1, void *p2, void *p3)
+{
+	uint32_t nb_threads = (uint32_t)(uintptr_t) p1;
+	uint32_t rounds = NB_LOCKS / nb_threads;
+	bool contended = nb_threads > 1;
+
+	while (rounds--) {
+		sys_mutex_lock(&bench_sys_mutex, K_FOREVER);
+		if (contended) {
+			k_yield();
+		}
+		sys_mutex_unlock(&bench_sys_mutex);
+	}
+}
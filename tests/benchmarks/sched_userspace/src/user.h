@@ -4,6 +4,15 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <zephyr/kernel.h>
+#include <zephyr/sys/mutex.h>
+
 #define NB_YIELDS UINT32_C(1000000)
+#define NB_LOCKS UINT32_C(100000)
+
+extern struct k_mutex bench_k_mutex;
+extern struct sys_mutex bench_sys_mutex;
 
 void context_switch_yield(void *p1, void *p2, void *p3);
+void k_mutex_lock_unlock(void *p1, void *p2, void *p3);
+void sys_mutex_lock_unlock(void *p1, void *p2, void *p3);
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_ctrl.h>
+
+#define INST_COUNT 1000
+#define ROUNDS 10
+
+#define INST_DEFINE(n, _) \
+	LOG_INSTANCE_REGISTER(bench, UTIL_CAT(i, n), LOG_LEVEL_INF)
+
+LISTIFY(INST_COUNT, INST_DEFINE, (;));
+
+/* Lookup as done before log sources were searched with a binary search */
+static int linear_source_id_get(const char *name)
+{
+	for (int i = 0; i < log_src_cnt_get(Z_LOG_LOCAL_DOMAIN_ID); i++) {
+		const char *sname = log_source_name_get(Z_LOG_LOCAL_DOMAIN_ID, i);
+
+		if ((sname != NULL) && (strcmp(sname, name) == 0)) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+static int run(const char *label, int (*id_get)(const char *name))
+{
+	uint32_t cycles = 0;
+	char name[16];
+
+	for (int round = 0; round < ROUNDS; round++) {
+		for (int i = 0; i < INST_COUNT; i++) {
+			uint32_t start;
+			int id;
+
+			snprintk(name, sizeof(name), "bench.i%d", i);
+
+			start = k_cycle_get_32();
+			id = id_get(name);
+			cycles += k_cycle_get_32() - start;
+
+			if (id < 0) {
+				printk("%s not found\n", name);
+				return -ENOENT;
+			}
+		}
+	}
+
+	printk("%-8s %5u cycles per lookup\n", label, cycles / (ROUNDS * INST_COUNT));
+
+	return 0;
+}
+
+int main(void)
+{
+	/* Sorting is done by the linker, the boot only initializes the sources */
+	uint32_t boot = k_cycle_get_32();
+	uint32_t start;
+	uint32_t first;
+
+	/* The order of the sources is verified once, by the first lookup */
+	start = k_cycle_get_32();
+	(void)log_source_id_get("bench.i0");
+	first = k_cycle_get_32() - start;
+
+	printk("%-8s %5u cycles\n", "boot", boot);
+	printk("%-8s %5u cycles\n", "check", first);
+	printk("%u log sources\n", log_src_cnt_get(Z_LOG_LOCAL_DOMAIN_ID));
+
+	if (run("bsearch", log_source_id_get) == 0) {
+		run("linear", linear_source_id_get);
+	}
+
+	printk("fin\n");
+	return 0;
+}
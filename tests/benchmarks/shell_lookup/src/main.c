@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/shell/shell.h>
+#include "shell_utils.h"
+
+#define CMD_COUNT 1000
+#define ROUNDS 10
+
+static int cmd_handler(const struct shell *sh, size_t argc, char **argv)
+{
+	return 0;
+}
+
+#define CMD_DEFINE(i, _) \
+	SHELL_CMD_REGISTER(UTIL_CAT(cmd_, i), NULL, NULL, cmd_handler)
+
+LISTIFY(CMD_COUNT, CMD_DEFINE, (;));
+
+/* Same filtering as the Tab completion */
+static size_t completion_count(const char *prefix)
+{
+	size_t len = strlen(prefix);
+	const struct shell_static_entry *entry;
+	size_t cnt = 0;
+	size_t idx;
+	size_t end;
+
+	z_shell_cmd_prefix_range(NULL, prefix, &idx, &end);
+
+	while ((idx < end) &&
+	       ((entry = z_shell_cmd_get(NULL, idx, NULL)) != NULL)) {
+		if (strncmp(entry->syntax, prefix, len) == 0) {
+			cnt++;
+		}
+		idx++;
+	}
+
+	return cnt;
+}
+
+static int run_lookup(void)
+{
+	uint32_t cycles = 0;
+	char name[16];
+
+	for (int round = 0; round < ROUNDS; round++) {
+		for (int i = 0; i < CMD_COUNT; i++) {
+			uint32_t start;
+			bool found;
+
+			snprintk(name, sizeof(name), "cmd_%d", i);
+
+			start = k_cycle_get_32();
+			found = (z_shell_find_cmd(NULL, name, NULL) != NULL);
+			cycles += k_cycle_get_32() - start;
+
+			if (!found) {
+				printk("%s not found\n", name);
+				return -ENOENT;
+			}
+		}
+	}
+
+	printk("lookup     %5u cycles per command\n", cycles / (ROUNDS * CMD_COUNT));
+
+	return 0;
+}
+
+static int run_completion(void)
+{
+	/* Prefixes of all, 111, 11, 1 and none of the commands */
+	static const char *const prefixes[] = {
+		"cmd_", "cmd_1", "cmd_12", "cmd_123", "cmd_x",
+	};
+	static const size_t expected[] = { CMD_COUNT, 111, 11, 1, 0 };
+	uint32_t cycles = 0;
+
+	for (int round = 0; round < ROUNDS; round++) {
+		for (int i = 0; i < ARRAY_SIZE(prefixes); i++) {
+			uint32_t start = k_cycle_get_32();
+			size_t cnt = completion_count(prefixes[i]);
+
+			cycles += k_cycle_get_32() - start;
+
+			if (cnt != expected[i]) {
+				printk("%s: %zu candidates instead of %zu\n",
+				       prefixes[i], cnt, expected[i]);
+				return -EINVAL;
+			}
+		}
+	}
+
+	printk("completion %5u cycles per prefix\n",
+	       cycles / (ROUNDS * ARRAY_SIZE(prefixes)));
+
+	return 0;
+}
+
+int main(void)
+{
+	printk("%u root commands, %s\n", CMD_COUNT,
+	       IS_ENABLED(CONFIG_SHELL_ROOT_CMD_BSEARCH) ?
+	       "binary search" : "linear search");
+
+	if (run_lookup() == 0) {
+		run_completion();
+	}
+
+	printk("fin\n");
+	return 0;
+}
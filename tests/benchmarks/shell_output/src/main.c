@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/shell/shell_dummy.h>
+#include <zephyr/shell/shell_uart.h>
+#include <zephyr/drivers/serial/uart_emul.h>
+
+#define DUMP_LINES 512
+#define LINE_FMT "%4u: 0123456789abcdef0123456789abcdef0123456789abcdef"
+/* Formatted line length, with the CRLF line ending */
+#define LINE_LEN (4 + 2 + 48 + 2)
+
+static const struct device *const emul = DEVICE_DT_GET(DT_CHOSEN(zephyr_shell_uart));
+static atomic_t received;
+
+/* Stands for the host reading the UART as fast as it is fed */
+static void tx_data_ready(const struct device *dev, size_t size, void *user_data)
+{
+	uint8_t buf[64];
+	uint32_t len;
+
+	while ((len = uart_emul_get_tx_data(dev, buf, sizeof(buf))) > 0) {
+		atomic_add(&received, len);
+	}
+}
+
+static int cmd_dump(const struct shell *sh, size_t argc, char **argv)
+{
+	for (unsigned int i = 0; i < DUMP_LINES; i++) {
+		shell_print(sh, LINE_FMT, i);
+	}
+
+	return 0;
+}
+
+SHELL_CMD_REGISTER(dump, NULL, "Print a large table", cmd_dump);
+
+static void run(const char *name, const struct shell *sh, bool wait_drained)
+{
+	uint32_t bytes = DUMP_LINES * LINE_LEN;
+	uint32_t start, returned, drained;
+
+	atomic_set(&received, 0);
+
+	start = k_cycle_get_32();
+	shell_execute_cmd(sh, "dump");
+	returned = k_cycle_get_32() - start;
+
+	while (wait_drained && atomic_get(&received) < bytes) {
+		k_yield();
+	}
+	drained = k_cycle_get_32() - start;
+
+	printk("%-6s %u bytes in %8u cycles, command returned after %8u cycles, %9llu B/s\n",
+	       name, bytes, drained, returned,
+	       (uint64_t)bytes * sys_clock_hw_cycles_per_sec() / MAX(drained, 1));
+}
+
+int main(void)
+{
+	const struct shell *sh_uart = shell_backend_uart_get_ptr();
+
+	uart_emul_callback_tx_data_ready_set(emul, tx_data_ready, NULL);
+
+	/* Let both backends finish printing their prompt */
+	k_msleep(100);
+	shell_backend_dummy_clear_output(shell_backend_dummy_get_ptr());
+
+	printk("%u lines of %u bytes, %s UART backend\n", DUMP_LINES, LINE_LEN,
+	       IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_ASYNC) ? "asynchronous" :
+	       IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN) ?
+	       "interrupt driven" : "polling");
+
+	run("dummy", shell_backend_dummy_get_ptr(), false);
+	run("uart", sh_uart, true);
+
+	printk("fin\n");
+	return 0;
+}
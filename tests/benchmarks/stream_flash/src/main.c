@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/storage/stream_flash.h>
+
+#define IMAGE_SIZE (128 * 1024)
+#define BUF_LEN 1024
+#define BUF_CNT 2
+#define PACKET_SIZE 256
+#define PACKET_INTERVAL_US 250
+
+static uint8_t bufs[BUF_LEN * BUF_CNT];
+static uint8_t packet[PACKET_SIZE];
+static struct stream_flash_ctx ctx;
+
+static void run(const struct flash_area *fa, size_t buf_cnt)
+{
+	uint32_t start;
+	uint32_t ms;
+	size_t off;
+	int rc;
+
+	rc = flash_area_erase(fa, 0, fa->fa_size);
+	if (rc != 0) {
+		printk("erase failed: %d\n", rc);
+		return;
+	}
+
+	if (buf_cnt > 1) {
+		rc = stream_flash_init_async(&ctx, flash_area_get_device(fa),
+					     bufs, BUF_LEN, buf_cnt,
+					     fa->fa_off, IMAGE_SIZE, NULL);
+	} else {
+		rc = stream_flash_init(&ctx, flash_area_get_device(fa), bufs,
+				       BUF_LEN, fa->fa_off, IMAGE_SIZE, NULL);
+	}
+	if (rc != 0) {
+		printk("init failed: %d\n", rc);
+		return;
+	}
+
+	start = k_uptime_get_32();
+
+	for (off = 0; off < IMAGE_SIZE; off += PACKET_SIZE) {
+		/* Wait for the next packet to arrive */
+		k_usleep(PACKET_INTERVAL_US);
+
+		rc = stream_flash_buffered_write(&ctx, packet, PACKET_SIZE,
+						 off + PACKET_SIZE == IMAGE_SIZE);
+		if (rc != 0) {
+			printk("write failed: %d\n", rc);
+			return;
+		}
+	}
+
+	ms = k_uptime_get_32() - start;
+
+	if (buf_cnt > 1) {
+		printk("async x%zu ", buf_cnt);
+	} else {
+		printk("sync     ");
+	}
+	printk("%u bytes in %5u ms, %7u B/s\n", IMAGE_SIZE, ms,
+	       (uint32_t)((uint64_t)IMAGE_SIZE * MSEC_PER_SEC / MAX(ms, 1)));
+}
+
+int main(void)
+{
+	const struct flash_area *fa;
+	int rc;
+
+	rc = flash_area_open(FIXED_PARTITION_ID(slot1_partition), &fa);
+	if (rc != 0) {
+		printk("flash_area_open failed: %d\n", rc);
+		return 0;
+	}
+
+	memset(packet, 0xa5, sizeof(packet));
+
+	printk("image %u bytes, packets of %u bytes every %u us, buffers of %u bytes\n",
+	       IMAGE_SIZE, PACKET_SIZE, PACKET_INTERVAL_US, BUF_LEN);
+
+	run(fa, 1);
+	run(fa, BUF_CNT);
+
+	flash_area_close(fa);
+
+	printk("fin\n");
+	return 0;
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+/* Calls made between two drains of the tracing buffers */
+#define BATCH 32
+#define BATCHES 32
+
+static K_SEM_DEFINE(bench_sem, 0, 1);
+
+#ifdef CONFIG_TRACING_BACKEND_RAM
+extern uint8_t ram_tracing[CONFIG_RAM_TRACING_BUFFER_SIZE];
+
+/* Bytes written to the RAM backend, which does not wrap */
+static uint32_t ram_tracing_used(void)
+{
+	uint32_t used = sizeof(ram_tracing);
+
+	while (used > 0 && ram_tracing[used - 1] == 0) {
+		used--;
+	}
+
+	return used;
+}
+#else
+static uint32_t ram_tracing_used(void)
+{
+	return 0;
+}
+#endif
+
+int main(void)
+{
+	uint32_t total = 0;
+	uint32_t used_start;
+
+	printk("tracing %s, %s header, %s buffers\n",
+	       IS_ENABLED(CONFIG_TRACING) ? "on" : "off",
+	       IS_ENABLED(CONFIG_TRACING_CTF_COMPACT_HEADER) ? "compact" : "default",
+	       IS_ENABLED(CONFIG_TRACING_PER_CPU_BUFFERS) ? "per-CPU" : "shared");
+
+	used_start = ram_tracing_used();
+
+	for (int b = 0; b < BATCHES; b++) {
+		uint32_t start = k_cycle_get_32();
+
+		for (int i = 0; i < BATCH; i++) {
+			k_sem_give(&bench_sem);
+		}
+		total += k_cycle_get_32() - start;
+
+		if (IS_ENABLED(CONFIG_TRACING_ASYNC)) {
+			k_msleep(10);
+		}
+	}
+
+	printk("%-12s %5u cycles per call\n", "k_sem_give",
+	       total / (BATCH * BATCHES));
+	if (IS_ENABLED(CONFIG_TRACING_BACKEND_RAM)) {
+		/* Includes the events of the tracing thread, if any */
+		printk("%-12s %5u bytes per call\n", "ram backend",
+		       (ram_tracing_used() - used_start) / (BATCH * BATCHES));
+	}
+
+	printk("fin\n");
+	return 0;
+}
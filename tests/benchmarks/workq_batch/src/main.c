@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+#define ITEMS 32
+#define ROUNDS 500
+#define STACK_SIZE 1024
+#define NOTIFY_DELAY_US 500
+
+/* The queue preempts the submitter, so every wakeup of the queue costs
+ * two context switches on top of the submission.
+ */
+#define MAIN_PRIO K_PRIO_PREEMPT(2)
+#define QUEUE_PRIO K_PRIO_PREEMPT(1)
+
+static K_THREAD_STACK_DEFINE(queue_stack, STACK_SIZE);
+static struct k_work_q queue;
+#ifdef CONFIG_WORKQUEUE_NOTIFY_DELAY
+static K_THREAD_STACK_DEFINE(delayed_stack, STACK_SIZE);
+static struct k_work_q delayed_queue;
+#endif
+static struct k_work items[ITEMS];
+static struct k_work *item_ptrs[ITEMS];
+static volatile uint32_t done_cnt;
+
+static void item_handler(struct k_work *work)
+{
+	done_cnt++;
+}
+
+static void submit_single(struct k_work_q *wq)
+{
+	for (int i = 0; i < ITEMS; i++) {
+		(void)k_work_submit_to_queue(wq, &items[i]);
+	}
+}
+
+static void submit_batch(struct k_work_q *wq)
+{
+	(void)k_work_submit_batch_to_queue(wq, item_ptrs, ITEMS);
+}
+
+/* Reports the cycles spent submitting, and until all items completed */
+static void run(const char *name, struct k_work_q *wq,
+		void (*submit)(struct k_work_q *wq))
+{
+	uint64_t submit_cycles = 0;
+	uint64_t total_cycles = 0;
+
+	done_cnt = 0;
+
+	for (int round = 0; round < ROUNDS; round++) {
+		uint32_t start = k_cycle_get_32();
+
+		submit(wq);
+		submit_cycles += k_cycle_get_32() - start;
+
+		/* Only delayed notifications leave work pending here */
+		while (done_cnt < (round + 1) * ITEMS) {
+			k_sleep(K_TICKS(1));
+		}
+		total_cycles += k_cycle_get_32() - start;
+	}
+
+	printk("%s: %6u cycles per item submitted, %6u per item completed\n",
+	       name, (uint32_t)(submit_cycles / (ROUNDS * ITEMS)),
+	       (uint32_t)(total_cycles / (ROUNDS * ITEMS)));
+}
+
+int main(void)
+{
+	struct k_work_queue_config cfg = {
+		.name = "bench_workq",
+		.no_yield = true,
+	};
+
+	k_thread_priority_set(k_current_get(), MAIN_PRIO);
+
+	for (int i = 0; i < ITEMS; i++) {
+		k_work_init(&items[i], item_handler);
+		item_ptrs[i] = &items[i];
+	}
+
+	k_work_queue_start(&queue, queue_stack, K_THREAD_STACK_SIZEOF(queue_stack),
+			   QUEUE_PRIO, &cfg);
+
+	printk("%u items per burst\n", ITEMS);
+
+	run("single", &queue, submit_single);
+	run("batch", &queue, submit_batch);
+
+#ifdef CONFIG_WORKQUEUE_NOTIFY_DELAY
+	cfg.notify_delay = K_USEC(NOTIFY_DELAY_US);
+	k_work_queue_start(&delayed_queue, delayed_stack,
+			   K_THREAD_STACK_SIZEOF(delayed_stack), QUEUE_PRIO, &cfg);
+
+	run("single delayed", &delayed_queue, submit_single);
+	run("batch delayed", &delayed_queue, submit_batch);
+#endif
+
+	printk("fin\n");
+	return 0;
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+#define MAX_THREADS 4
+#define ITEMS 64
+#define ROUNDS 100
+#define ITEM_US 20
+#define STACK_SIZE 1024
+#define QUEUE_PRIO K_PRIO_PREEMPT(1)
+
+/* One queue per thread count, as workers can't be removed */
+static K_THREAD_STACK_ARRAY_DEFINE(queue_stacks, MAX_THREADS, STACK_SIZE);
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, MAX_THREADS * (MAX_THREADS - 1),
+				   STACK_SIZE);
+static struct k_work_q queues[MAX_THREADS];
+static struct k_work_q_worker workers[MAX_THREADS][MAX_THREADS - 1];
+static struct k_work items[ITEMS];
+static atomic_t done_cnt;
+
+/* A short work item, as deferred by drivers and protocol stacks */
+static void item_handler(struct k_work *work)
+{
+	k_busy_wait(ITEM_US);
+	atomic_inc(&done_cnt);
+}
+
+static void start_queue(int idx, int threads)
+{
+	struct k_work_queue_config cfg = {
+		.name = "bench_workq",
+		.no_yield = true,
+	};
+
+	k_work_queue_start(&queues[idx], queue_stacks[idx],
+			   K_THREAD_STACK_SIZEOF(queue_stacks[idx]), QUEUE_PRIO,
+			   &cfg);
+
+	for (int i = 0; i < threads - 1; i++) {
+		int cpu = IS_ENABLED(CONFIG_SCHED_CPU_MASK) ?
+			  (i + 1) % arch_num_cpus() : -1;
+		k_thread_stack_t *stack = worker_stacks[idx * (MAX_THREADS - 1) + i];
+
+		(void)k_work_queue_add_worker(&queues[idx], &workers[idx][i],
+					      stack, STACK_SIZE, cpu);
+	}
+}
+
+static void run(int threads)
+{
+	struct k_work_q *queue = &queues[threads - 1];
+	uint32_t start;
+	uint32_t cycles;
+
+	start_queue(threads - 1, threads);
+	atomic_clear(&done_cnt);
+
+	start = k_cycle_get_32();
+
+	for (int round = 0; round < ROUNDS; round++) {
+		for (int i = 0; i < ITEMS; i++) {
+			(void)k_work_submit_to_queue(queue, &items[i]);
+		}
+		(void)k_work_queue_drain(queue, false);
+	}
+
+	cycles = MAX(k_cycle_get_32() - start, 1);
+
+	printk("threads %d: %8u items/s (%u run)\n", threads,
+	       (uint32_t)((uint64_t)ROUNDS * ITEMS * sys_clock_hw_cycles_per_sec() /
+			  cycles),
+	       (uint32_t)atomic_get(&done_cnt));
+}
+
+int main(void)
+{
+	for (int i = 0; i < ITEMS; i++) {
+		k_work_init(&items[i], item_handler);
+	}
+
+	printk("%u CPUs, %u items of %u us per round, workers %s\n",
+	       arch_num_cpus(), ITEMS, ITEM_US,
+	       IS_ENABLED(CONFIG_SCHED_CPU_MASK) ? "pinned" : "not pinned");
+
+	for (int threads = 1; threads <= MAX_THREADS; threads++) {
+		run(threads);
+	}
+
+	printk("fin\n");
+	return 0;
+}
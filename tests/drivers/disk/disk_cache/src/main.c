@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/ztest.h>
+#include <zephyr/storage/disk_access.h>
+
+#define DISK_NAME "TEST"
+#define SECTOR_SIZE 512
+#define SECTOR_COUNT 64
+#define CACHE_SECTORS CONFIG_DISK_CACHE_SECTORS
+#define XFER_SECTORS CONFIG_DISK_CACHE_XFER_SECTORS
+
+/* RAM backed disk counting the commands it receives */
+static uint8_t disk_data[SECTOR_COUNT][SECTOR_SIZE];
+static uint32_t read_cmds;
+static uint32_t write_cmds;
+static uint32_t last_write_sectors;
+
+static int test_disk_init(struct disk_info *disk)
+{
+	return 0;
+}
+
+static int test_disk_status(struct disk_info *disk)
+{
+	return DISK_STATUS_OK;
+}
+
+static int test_disk_read(struct disk_info *disk, uint8_t *data_buf,
+			  uint32_t start_sector, uint32_t num_sector)
+{
+	if (start_sector + num_sector > SECTOR_COUNT) {
+		return -EIO;
+	}
+
+	read_cmds++;
+	memcpy(data_buf, disk_data[start_sector], num_sector * SECTOR_SIZE);
+
+	return 0;
+}
+
+static int test_disk_write(struct disk_info *disk, const uint8_t *data_buf,
+			   uint32_t start_sector, uint32_t num_sector)
+{
+	if (start_sector + num_sector > SECTOR_COUNT) {
+		return -EIO;
+	}
+
+	write_cmds++;
+	last_write_sectors = num_sector;
+	memcpy(disk_data[start_sector], data_buf, num_sector * SECTOR_SIZE);
+
+	return 0;
+}
+
+static int test_disk_ioctl(struct disk_info *disk, uint8_t cmd, void *buff)
+{
+	switch (cmd) {
+	case DISK_IOCTL_CTRL_SYNC:
+		break;
+	case DISK_IOCTL_GET_SECTOR_COUNT:
+		*(uint32_t *)buff = SECTOR_COUNT;
+		break;
+	case DISK_IOCTL_GET_SECTOR_SIZE:
+		*(uint32_t *)buff = SECTOR_SIZE;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static const struct disk_operations test_disk_ops = {
+	.init = test_disk_init,
+	.status = test_disk_status,
+	.read = test_disk_read,
+	.write = test_disk_write,
+	.ioctl = test_disk_ioctl,
+};
+
+static struct disk_info test_disk = {
+	.name = DISK_NAME,
+	.ops = &test_disk_ops,
+};
+
+static uint8_t buf[CACHE_SECTORS][SECTOR_SIZE];
+
+static void fill_sector(uint8_t *sector, uint8_t pattern)
+{
+	memset(sector, pattern, SECTOR_SIZE);
+}
+
+static void read_sectors(uint32_t start_sector, uint32_t num_sector)
+{
+	zassert_ok(disk_access_read(DISK_NAME, buf[0], start_sector, num_sector));
+	zassert_mem_equal(buf[0], disk_data[start_sector],
+			  num_sector * SECTOR_SIZE);
+}
+
+ZTEST(disk_cache, test_read_hit)
+{
+	struct disk_access_cache_stats stats;
+
+	read_sectors(10, 1);
+	zassert_equal(read_cmds, 1);
+
+	read_sectors(10, 1);
+	zassert_equal(read_cmds, 1, "Cached sector read from disk");
+
+	disk_access_cache_stats_get(&stats);
+	zassert_equal(stats.misses, 1);
+	zassert_equal(stats.hits, 1);
+}
+
+ZTEST(disk_cache, test_read_ahead)
+{
+	struct disk_access_cache_stats stats;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_DISK_CACHE_READ_AHEAD);
+
+	read_sectors(0, 1);
+	zassert_equal(read_cmds, 1);
+
+	/* The second sequential read triggers a single read-ahead command */
+	read_sectors(1, 1);
+	zassert_equal(read_cmds, 3);
+	disk_access_cache_stats_get(&stats);
+	zassert_equal(stats.read_ahead, XFER_SECTORS);
+
+	for (uint32_t i = 2; i < 2 + XFER_SECTORS - 1; i++) {
+		read_sectors(i, 1);
+	}
+	zassert_equal(read_cmds, 3, "Read ahead sectors read from disk");
+}
+
+ZTEST(disk_cache, test_write)
+{
+	struct disk_access_cache_stats stats;
+
+	for (uint32_t i = 0; i < 4; i++) {
+		fill_sector(buf[0], 0xa0 + i);
+		zassert_ok(disk_access_write(DISK_NAME, buf[0], 4 + i, 1));
+	}
+
+	if (IS_ENABLED(CONFIG_DISK_CACHE_WRITE_BACK)) {
+		zassert_equal(write_cmds, 0, "Write not cached");
+		zassert_equal(disk_data[4][0], 0);
+	} else {
+		zassert_equal(write_cmds, 4);
+	}
+
+	/* Written data is visible before being synchronized */
+	zassert_ok(disk_access_read(DISK_NAME, buf[0], 4, 4));
+	for (uint32_t i = 0; i < 4; i++) {
+		zassert_equal(buf[i][0], 0xa0 + i);
+	}
+
+	zassert_ok(disk_access_ioctl(DISK_NAME, DISK_IOCTL_CTRL_SYNC, NULL));
+	for (uint32_t i = 0; i < 4; i++) {
+		zassert_equal(disk_data[4 + i][0], 0xa0 + i);
+	}
+
+	if (IS_ENABLED(CONFIG_DISK_CACHE_WRITE_BACK)) {
+		/* Consecutive sectors are merged into one command */
+		zassert_equal(write_cmds, 1);
+		zassert_equal(last_write_sectors, 4);
+		disk_access_cache_stats_get(&stats);
+		zassert_equal(stats.write_backs, 1);
+		zassert_equal(stats.written_back, 4);
+	}
+}
+
+ZTEST(disk_cache, test_eviction_write_back)
+{
+	struct disk_access_cache_stats stats;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_DISK_CACHE_WRITE_BACK);
+
+	for (uint32_t i = 0; i < CACHE_SECTORS; i++) {
+		fill_sector(buf[0], i + 1);
+		zassert_ok(disk_access_write(DISK_NAME, buf[0], i, 1));
+	}
+	zassert_equal(write_cmds, 0);
+
+	/* Evicting the oldest sector writes back all dirty sectors */
+	read_sectors(SECTOR_COUNT - 1, 1);
+	zassert_equal(write_cmds, DIV_ROUND_UP(CACHE_SECTORS, XFER_SECTORS));
+	for (uint32_t i = 0; i < CACHE_SECTORS; i++) {
+		zassert_equal(disk_data[i][0], i + 1);
+	}
+
+	disk_access_cache_stats_get(&stats);
+	zassert_equal(stats.written_back, CACHE_SECTORS);
+
+	/* Nothing is left to write back */
+	zassert_ok(disk_access_cache_flush(DISK_NAME));
+	zassert_equal(write_cmds, DIV_ROUND_UP(CACHE_SECTORS, XFER_SECTORS));
+}
+
+ZTEST(disk_cache, test_bypass)
+{
+	uint32_t large = CACHE_SECTORS / 2 + 1;
+	struct disk_access_cache_stats stats;
+
+	/* A bypassing read returns data written to the cache */
+	fill_sector(buf[0], 0x55);
+	zassert_ok(disk_access_write(DISK_NAME, buf[0], 3, 1));
+	memset(buf, 0, sizeof(buf));
+	zassert_ok(disk_access_read(DISK_NAME, buf[0], 0, large));
+	zassert_equal(buf[3][0], 0x55);
+
+	/* A bypassing write replaces the cached copies */
+	for (uint32_t i = 0; i < large; i++) {
+		fill_sector(buf[i], 0xaa);
+	}
+	zassert_ok(disk_access_write(DISK_NAME, buf[0], 0, large));
+	zassert_equal(last_write_sectors, large);
+	read_sectors(3, 1);
+	zassert_equal(buf[0][0], 0xaa);
+
+	disk_access_cache_stats_get(&stats);
+	zassert_equal(stats.bypasses, 2);
+}
+
+ZTEST(disk_cache, test_media_change)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_DISK_CACHE_WRITE_BACK);
+
+	fill_sector(buf[0], 0x5a);
+	zassert_ok(disk_access_write(DISK_NAME, buf[0], 2, 1));
+
+	/* Sectors of the previous media are dropped, not written back */
+	zassert_ok(disk_access_init(DISK_NAME));
+	zassert_equal(write_cmds, 0);
+	zassert_ok(disk_access_cache_flush(DISK_NAME));
+	zassert_equal(write_cmds, 0);
+	read_sectors(2, 1);
+	zassert_equal(buf[0][0], 0);
+}
+
+static void *disk_cache_setup(void)
+{
+	zassert_ok(disk_access_register(&test_disk));
+
+	return NULL;
+}
+
+static void disk_cache_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* Initializing the disk drops its cached sectors */
+	zassert_ok(disk_access_init(DISK_NAME));
+	memset(disk_data, 0, sizeof(disk_data));
+	read_cmds = 0;
+	write_cmds = 0;
+	last_write_sectors = 0;
+	disk_access_cache_stats_reset();
+}
+
+ZTEST_SUITE(disk_cache, NULL, disk_cache_setup, disk_cache_before, NULL, NULL);
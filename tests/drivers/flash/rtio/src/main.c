@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/ztest.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/storage/flash_map.h>
+
+#define TEST_OFFSET FIXED_PARTITION_OFFSET(storage_partition)
+#define TEST_ERASE_SIZE 4096
+#define TEST_BUF_LEN 256
+
+FLASH_DT_IODEV_DEFINE(sim_iodev, DT_CHOSEN(zephyr_flash_controller));
+
+/* Synchronous RAM backed flash driver, served by the RTIO adapter */
+static uint8_t fake_flash[2 * TEST_ERASE_SIZE];
+static const char *fake_flash_thread;
+
+static int fake_flash_read(const struct device *dev, off_t offset, void *data,
+			   size_t len)
+{
+	if (offset < 0 || offset + len > sizeof(fake_flash)) {
+		return -EINVAL;
+	}
+
+	memcpy(data, &fake_flash[offset], len);
+
+	return 0;
+}
+
+static int fake_flash_write(const struct device *dev, off_t offset,
+			    const void *data, size_t len)
+{
+	if (offset < 0 || offset + len > sizeof(fake_flash)) {
+		return -EINVAL;
+	}
+
+	fake_flash_thread = k_thread_name_get(k_current_get());
+	memcpy(&fake_flash[offset], data, len);
+
+	return 0;
+}
+
+static int fake_flash_erase(const struct device *dev, off_t offset, size_t size)
+{
+	if (offset < 0 || offset + size > sizeof(fake_flash)) {
+		return -EINVAL;
+	}
+
+	memset(&fake_flash[offset], 0xff, size);
+
+	return 0;
+}
+
+static const struct flash_driver_api fake_flash_api = {
+	.read = fake_flash_read,
+	.write = fake_flash_write,
+	.erase = fake_flash_erase,
+};
+
+DEVICE_DEFINE(fake_flash, "fake_flash", NULL, NULL, NULL, NULL, POST_KERNEL,
+	      CONFIG_KERNEL_INIT_PRIORITY_DEVICE, &fake_flash_api);
+
+RTIO_IODEV_DEFINE(fake_iodev, &flash_iodev_api, (void *)DEVICE_GET(fake_flash));
+
+RTIO_DEFINE(r_flash, 8, 8);
+
+static uint8_t wr_buf[TEST_BUF_LEN];
+static uint8_t rd_buf[TEST_BUF_LEN];
+
+static void test_erase_write_read(struct rtio_iodev *iodev, off_t offset)
+{
+	uint32_t userdata[3] = {0, 1, 2};
+	struct rtio_sqe *sqe;
+	struct rtio_cqe *cqe;
+
+	for (int i = 0; i < sizeof(wr_buf); i++) {
+		wr_buf[i] = i;
+	}
+	memset(rd_buf, 0, sizeof(rd_buf));
+
+	sqe = rtio_sqe_acquire(&r_flash);
+	rtio_sqe_prep_flash_erase(sqe, iodev, RTIO_PRIO_NORM, offset,
+				  TEST_ERASE_SIZE, &userdata[0]);
+	sqe->flags |= RTIO_SQE_CHAINED;
+	sqe = rtio_sqe_acquire(&r_flash);
+	rtio_sqe_prep_flash_write(sqe, iodev, RTIO_PRIO_NORM, offset, wr_buf,
+				  sizeof(wr_buf), &userdata[1]);
+	sqe->flags |= RTIO_SQE_CHAINED;
+	sqe = rtio_sqe_acquire(&r_flash);
+	rtio_sqe_prep_flash_read(sqe, iodev, RTIO_PRIO_NORM, offset, rd_buf,
+				 sizeof(rd_buf), &userdata[2]);
+
+	zassert_ok(rtio_submit(&r_flash, 3));
+
+	for (int i = 0; i < 3; i++) {
+		cqe = rtio_cqe_consume(&r_flash);
+		zassert_not_null(cqe);
+		zassert_ok(cqe->result, "Request %d failed: %d", i, cqe->result);
+		zassert_equal_ptr(cqe->userdata, &userdata[i],
+				  "Expected in order completions");
+		rtio_cqe_release(&r_flash, cqe);
+	}
+
+	zassert_mem_equal(rd_buf, wr_buf, sizeof(wr_buf));
+}
+
+ZTEST(flash_rtio, test_native_erase_write_read)
+{
+	zassert_true(flash_is_ready_iodev(&sim_iodev));
+
+	test_erase_write_read(&sim_iodev, TEST_OFFSET);
+}
+
+ZTEST(flash_rtio, test_native_error)
+{
+	struct rtio_sqe *sqe;
+	struct rtio_cqe *cqe;
+
+	/* Misaligned erase fails without stalling the following request */
+	sqe = rtio_sqe_acquire(&r_flash);
+	rtio_sqe_prep_flash_erase(sqe, &sim_iodev, RTIO_PRIO_NORM,
+				  TEST_OFFSET + 1, TEST_ERASE_SIZE, NULL);
+	sqe = rtio_sqe_acquire(&r_flash);
+	rtio_sqe_prep_flash_read(sqe, &sim_iodev, RTIO_PRIO_NORM, TEST_OFFSET,
+				 rd_buf, sizeof(rd_buf), rd_buf);
+
+	zassert_ok(rtio_submit(&r_flash, 2));
+
+	cqe = rtio_cqe_consume(&r_flash);
+	zassert_not_null(cqe);
+	zassert_is_null(cqe->userdata);
+	zassert_equal(cqe->result, -EINVAL);
+	rtio_cqe_release(&r_flash, cqe);
+
+	cqe = rtio_cqe_consume(&r_flash);
+	zassert_not_null(cqe);
+	zassert_equal_ptr(cqe->userdata, rd_buf);
+	zassert_ok(cqe->result);
+	rtio_cqe_release(&r_flash, cqe);
+}
+
+ZTEST(flash_rtio, test_native_transaction)
+{
+	struct rtio_sqe *sqe;
+	struct rtio_cqe *cqe;
+
+	memset(rd_buf, 0, sizeof(rd_buf));
+
+	/* Write both halves of the buffer and read them back as one unit */
+	sqe = rtio_sqe_acquire(&r_flash);
+	rtio_sqe_prep_flash_erase(sqe, &sim_iodev, RTIO_PRIO_NORM, TEST_OFFSET,
+				  TEST_ERASE_SIZE, NULL);
+	sqe->flags |= RTIO_SQE_TRANSACTION;
+	sqe = rtio_sqe_acquire(&r_flash);
+	rtio_sqe_prep_flash_write(sqe, &sim_iodev, RTIO_PRIO_NORM, TEST_OFFSET,
+				  wr_buf, sizeof(wr_buf) / 2, NULL);
+	sqe->flags |= RTIO_SQE_TRANSACTION;
+	sqe = rtio_sqe_acquire(&r_flash);
+	rtio_sqe_prep_flash_write(sqe, &sim_iodev, RTIO_PRIO_NORM,
+				  TEST_OFFSET + sizeof(wr_buf) / 2,
+				  &wr_buf[sizeof(wr_buf) / 2],
+				  sizeof(wr_buf) / 2, NULL);
+	sqe->flags |= RTIO_SQE_TRANSACTION;
+	sqe = rtio_sqe_acquire(&r_flash);
+	rtio_sqe_prep_flash_read(sqe, &sim_iodev, RTIO_PRIO_NORM, TEST_OFFSET,
+				 rd_buf, sizeof(rd_buf), NULL);
+
+	zassert_ok(rtio_submit(&r_flash, 4));
+
+	for (int i = 0; i < 4; i++) {
+		cqe = rtio_cqe_consume(&r_flash);
+		zassert_not_null(cqe);
+		zassert_ok(cqe->result);
+		rtio_cqe_release(&r_flash, cqe);
+	}
+
+	zassert_mem_equal(rd_buf, wr_buf, sizeof(wr_buf));
+}
+
+ZTEST(flash_rtio, test_fallback_erase_write_read)
+{
+	zassert_true(flash_is_ready_iodev(&fake_iodev));
+
+	fake_flash_thread = NULL;
+	test_erase_write_read(&fake_iodev, TEST_ERASE_SIZE);
+
+	zassert_mem_equal(&fake_flash[TEST_ERASE_SIZE], wr_buf, sizeof(wr_buf));
+	zassert_not_null(fake_flash_thread);
+	zassert_equal(strcmp(fake_flash_thread, "flash_rtio"), 0,
+		      "Blocking driver called from %s", fake_flash_thread);
+}
+
+ZTEST_SUITE(flash_rtio, NULL, NULL, NULL, NULL, NULL);
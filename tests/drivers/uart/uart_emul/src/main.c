@@ -75,4 +75,99 @@ ZTEST_F(uart_emul, test_polling_in)
 	zassert_equal(rc, -1, "RX buffer should be empty");
 }
 
+#ifdef CONFIG_UART_ASYNC_API
+#define ASYNC_RX_BUF_SIZE (SAMPLE_DATA_SIZE / 4)
+
+struct uart_emul_async_state {
+	struct k_sem tx_done;
+	size_t tx_len;
+	uint8_t rx_bufs[2][ASYNC_RX_BUF_SIZE];
+	int rx_buf_idx;
+	uint8_t rx_content[SAMPLE_DATA_SIZE];
+	size_t rx_len;
+	int released;
+	struct k_sem rx_disabled;
+};
+
+static struct uart_emul_async_state async_state;
+
+static void uart_emul_async_cb(const struct device *dev, struct uart_event *evt,
+			       void *user_data)
+{
+	struct uart_emul_async_state *state = user_data;
+
+	switch (evt->type) {
+	case UART_TX_DONE:
+		state->tx_len = evt->data.tx.len;
+		k_sem_give(&state->tx_done);
+		break;
+	case UART_RX_BUF_REQUEST:
+		zassert_ok(uart_rx_buf_rsp(dev, state->rx_bufs[state->rx_buf_idx],
+					   ASYNC_RX_BUF_SIZE));
+		state->rx_buf_idx ^= 1;
+		break;
+	case UART_RX_RDY:
+		memcpy(&state->rx_content[state->rx_len],
+		       &evt->data.rx.buf[evt->data.rx.offset], evt->data.rx.len);
+		state->rx_len += evt->data.rx.len;
+		break;
+	case UART_RX_BUF_RELEASED:
+		state->released++;
+		break;
+	case UART_RX_DISABLED:
+		k_sem_give(&state->rx_disabled);
+		break;
+	default:
+		break;
+	}
+}
+
+ZTEST_F(uart_emul, test_async_tx)
+{
+	uint8_t tx_content[SAMPLE_DATA_SIZE] = {0};
+	size_t tx_len;
+
+	memset(&async_state, 0, sizeof(async_state));
+	k_sem_init(&async_state.tx_done, 0, 1);
+	zassert_ok(uart_callback_set(fixture->dev, uart_emul_async_cb, &async_state));
+
+	zassert_ok(uart_tx(fixture->dev, fixture->sample_data, SAMPLE_DATA_SIZE,
+			   SYS_FOREVER_US));
+	zassert_equal(uart_tx(fixture->dev, fixture->sample_data, 1, SYS_FOREVER_US), -EBUSY);
+	zassert_ok(k_sem_take(&async_state.tx_done, K_SECONDS(1)));
+	zassert_equal(async_state.tx_len, SAMPLE_DATA_SIZE);
+
+	tx_len = uart_emul_get_tx_data(fixture->dev, tx_content, sizeof(tx_content));
+	zassert_equal(tx_len, SAMPLE_DATA_SIZE, "TX buffer length does not match");
+	zassert_mem_equal(tx_content, fixture->sample_data, SAMPLE_DATA_SIZE);
+}
+
+ZTEST_F(uart_emul, test_async_rx)
+{
+	memset(&async_state, 0, sizeof(async_state));
+	k_sem_init(&async_state.rx_disabled, 0, 1);
+	zassert_ok(uart_callback_set(fixture->dev, uart_emul_async_cb, &async_state));
+
+	zassert_ok(uart_rx_enable(fixture->dev, async_state.rx_bufs[0], ASYNC_RX_BUF_SIZE,
+				  SYS_FOREVER_US));
+	async_state.rx_buf_idx = 1;
+
+	/* Received data spans several buffers */
+	uart_emul_put_rx_data(fixture->dev, fixture->sample_data, SAMPLE_DATA_SIZE / 2);
+	uart_emul_put_rx_data(fixture->dev, &fixture->sample_data[SAMPLE_DATA_SIZE / 2],
+			      SAMPLE_DATA_SIZE / 2);
+	k_msleep(1);
+
+	zassert_equal(async_state.rx_len, SAMPLE_DATA_SIZE);
+	zassert_mem_equal(async_state.rx_content, fixture->sample_data, SAMPLE_DATA_SIZE);
+
+	zassert_ok(uart_rx_disable(fixture->dev));
+	zassert_ok(k_sem_take(&async_state.rx_disabled, K_SECONDS(1)));
+	zassert_equal(uart_rx_disable(fixture->dev), -EFAULT);
+
+	/* All full buffers, plus the current and the next one */
+	zassert_equal(async_state.released, SAMPLE_DATA_SIZE / ASYNC_RX_BUF_SIZE + 2);
+}
+#endif /* CONFIG_UART_ASYNC_API */
+
 ZTEST_SUITE(uart_emul, NULL, uart_emul_setup, uart_emul_before, NULL, NULL);
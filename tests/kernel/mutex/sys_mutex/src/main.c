@@ -48,6 +48,7 @@
 #include <zephyr/tc_util.h>
 #include <zephyr/kernel.h>
 #include <zephyr/ztest.h>
+#include <zephyr/ztest_error_hook.h>
 #include <zephyr/sys/mutex.h>
 
 #define STACKSIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
@@ -64,6 +65,25 @@ ZTEST_BMEM SYS_MUTEX_DEFINE(mutex_4);
 
 #ifdef CONFIG_USERSPACE
 static SYS_MUTEX_DEFINE(no_access_mutex);
+static ZTEST_BMEM SYS_MUTEX_DEFINE(forged_mutex);
+
+static void never_started(void *p1, void *p2, void *p3)
+{
+}
+
+/* User thread which cannot write the mutexes, from an empty memory domain */
+K_THREAD_DEFINE(no_access_thread, STACKSIZE, never_started, NULL, NULL, NULL,
+		K_PRIO_PREEMPT(14), K_USER, SYS_FOREVER_MS);
+static struct k_mem_domain no_access_domain;
+
+/* User threads which have no permission on each other */
+static ZTEST_BMEM SYS_MUTEX_DEFINE(shared_mutex);
+static ZTEST_BMEM int holder_prio;
+static ZTEST_BMEM int waiter_rv;
+K_THREAD_STACK_DEFINE(holder_stack_area, STACKSIZE);
+K_THREAD_STACK_DEFINE(waiter_stack_area, STACKSIZE);
+static struct k_thread holder_thread_data;
+static struct k_thread waiter_thread_data;
 #endif
 static ZTEST_BMEM SYS_MUTEX_DEFINE(not_my_mutex);
 static ZTEST_BMEM SYS_MUTEX_DEFINE(bad_count_mutex);
@@ -441,15 +461,98 @@ ZTEST(mutex_complex, test_supervisor_access)
 	zassert_true(rv == -EINVAL, "mutex wasn't locked");
 }
 
+/* User threads access the mutex directly, and fault on a mutex they have
+ * no access to
+ */
 ZTEST_USER_OR_NOT(mutex_complex, test_user_access)
 {
+#ifdef CONFIG_USERSPACE
+	ztest_set_fault_valid(true);
+	(void)sys_mutex_lock(&no_access_mutex, K_NO_WAIT);
+	ztest_test_fail();
+#else
+	ztest_test_skip();
+#endif /* CONFIG_USERSPACE */
+}
+
+ZTEST_USER_OR_NOT(mutex_complex, test_user_access_unlock)
+{
+#ifdef CONFIG_USERSPACE
+	ztest_set_fault_valid(true);
+	(void)sys_mutex_unlock(&no_access_mutex);
+	ztest_test_fail();
+#else
+	ztest_test_skip();
+#endif /* CONFIG_USERSPACE */
+}
+
+/* A user thread cannot have the priority of a thread raised by storing it as
+ * the owner of a mutex that thread cannot write to
+ */
+ZTEST_USER_OR_NOT(mutex_complex, test_user_forged_owner)
+{
 #ifdef CONFIG_USERSPACE
 	int rv;
 
-	rv = sys_mutex_lock(&no_access_mutex, K_NO_WAIT);
-	zassert_true(rv == -EACCES, "accessed mutex not in memory domain");
-	rv = sys_mutex_unlock(&no_access_mutex);
-	zassert_true(rv == -EACCES, "accessed mutex not in memory domain");
+	atomic_set(&forged_mutex.val, (atomic_val_t)no_access_thread);
+	rv = sys_mutex_lock(&forged_mutex, K_MSEC(10));
+	zassert_equal(rv, -EINVAL, "waited for an owner outside of the mutex");
+	zassert_equal(k_thread_priority_get(no_access_thread),
+		      K_PRIO_PREEMPT(14), "forged owner was boosted");
+	atomic_clear(&forged_mutex.val);
+#else
+	ztest_test_skip();
+#endif /* CONFIG_USERSPACE */
+}
+
+#ifdef CONFIG_USERSPACE
+static void holder_thread(void *p1, void *p2, void *p3)
+{
+	if (sys_mutex_lock(&shared_mutex, K_NO_WAIT) != 0) {
+		return;
+	}
+
+	/* Let the waiter block on the mutex */
+	k_sleep(K_MSEC(100));
+	holder_prio = k_thread_priority_get(k_current_get());
+
+	sys_mutex_unlock(&shared_mutex);
+}
+
+static void waiter_thread(void *p1, void *p2, void *p3)
+{
+	k_sleep(K_MSEC(10));
+
+	waiter_rv = sys_mutex_lock(&shared_mutex, K_SECONDS(1));
+	if (waiter_rv == 0) {
+		sys_mutex_unlock(&shared_mutex);
+	}
+}
+#endif /* CONFIG_USERSPACE */
+
+/* User threads created without permission on each other can contend on a
+ * mutex they share, with priority inheritance
+ */
+ZTEST(mutex_complex, test_user_contention_no_perms)
+{
+#ifdef CONFIG_USERSPACE
+	holder_prio = -1;
+	waiter_rv = -1;
+
+	k_thread_create(&holder_thread_data, holder_stack_area, STACKSIZE,
+			holder_thread, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(10), K_USER, K_NO_WAIT);
+	k_thread_create(&waiter_thread_data, waiter_stack_area, STACKSIZE,
+			waiter_thread, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(5), K_USER, K_NO_WAIT);
+
+	k_thread_join(&holder_thread_data, K_FOREVER);
+	k_thread_join(&waiter_thread_data, K_FOREVER);
+
+	zassert_equal(waiter_rv, 0, "waiter failed to lock the mutex: %d",
+		      waiter_rv);
+	zassert_equal(holder_prio, K_PRIO_PREEMPT(5),
+		      "holder not boosted, priority %d", holder_prio);
 #else
 	ztest_test_skip();
 #endif /* CONFIG_USERSPACE */
@@ -472,7 +575,17 @@ static void *sys_mutex_tests_setup(void)
 				&thread_08_thread_data, &thread_08_stack_area,
 				&thread_09_thread_data, &thread_09_stack_area,
 				&thread_11_thread_data, &thread_11_stack_area,
-				&thread_12_thread_data, &thread_12_stack_area);
+				&thread_12_thread_data, &thread_12_stack_area,
+				no_access_thread);
+
+	rv = k_mem_domain_init(&no_access_domain, 0, NULL);
+	if (rv == 0) {
+		rv = k_mem_domain_add_thread(&no_access_domain,
+					     no_access_thread);
+	}
+	if (rv != 0) {
+		TC_ERROR("Failed to set up the memory domain: %d\n", rv);
+	}
 #endif
 	rv = sys_mutex_lock(&not_my_mutex, K_NO_WAIT);
 	if (rv != 0) {
@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/irq_offload.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define TIMEOUT_MS 100
+#define MAX_EVENTS 8
+
+enum {
+	EV_SEM,
+	EV_FIFO,
+	EV_MSGQ,
+	EV_SIGNAL,
+#ifdef CONFIG_RINGQ
+	EV_RINGQ,
+#endif
+	NUM_EVENTS
+};
+
+static struct k_poll_set set;
+static struct k_sem sem;
+static struct k_fifo fifo;
+static struct k_poll_signal signal;
+K_MSGQ_DEFINE(msgq, sizeof(uint32_t), 4, 4);
+#ifdef CONFIG_RINGQ
+K_RINGQ_DEFINE(ringq, sizeof(uint32_t), 4, 0);
+#endif
+
+static struct k_poll_event events[NUM_EVENTS];
+static struct k_poll_event *ready[MAX_EVENTS];
+
+static K_THREAD_STACK_DEFINE(thread_stack, STACK_SIZE);
+static struct k_thread thread;
+
+static struct fifo_item {
+	void *fifo_reserved;
+} item;
+
+static void add_all(void)
+{
+	for (int i = 0; i < NUM_EVENTS; i++) {
+		zassert_ok(k_poll_set_add(&set, &events[i]));
+	}
+}
+
+static void expect_ready(int count, ...)
+{
+	va_list ap;
+
+	zassert_equal(k_poll_set_wait(&set, ready, MAX_EVENTS, K_NO_WAIT), count);
+
+	va_start(ap, count);
+	for (int i = 0; i < count; i++) {
+		int idx = va_arg(ap, int);
+
+		zassert_equal_ptr(ready[i], &events[idx], "event %d: expected %d",
+				  i, idx);
+	}
+	va_end(ap);
+}
+
+static void start_thread(k_thread_entry_t entry)
+{
+	k_thread_create(&thread, thread_stack, STACK_SIZE, entry, NULL, NULL,
+			NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+}
+
+ZTEST(poll_set, test_sem)
+{
+	add_all();
+	zassert_equal(k_poll_set_wait(&set, ready, MAX_EVENTS, K_NO_WAIT),
+		      -EAGAIN);
+
+	k_sem_give(&sem);
+	expect_ready(1, EV_SEM);
+	zassert_equal(events[EV_SEM].state, K_POLL_STATE_SEM_AVAILABLE);
+
+	/* Level triggered: still ready until taken */
+	expect_ready(1, EV_SEM);
+	zassert_ok(k_sem_take(&sem, K_NO_WAIT));
+	zassert_equal(k_poll_set_wait(&set, ready, MAX_EVENTS, K_NO_WAIT),
+		      -EAGAIN);
+	zassert_equal(events[EV_SEM].state, K_POLL_STATE_NOT_READY);
+}
+
+ZTEST(poll_set, test_objects)
+{
+	uint32_t val = 42;
+
+	add_all();
+
+	k_poll_signal_raise(&signal, 7);
+	k_fifo_put(&fifo, &item);
+	zassert_ok(k_msgq_put(&msgq, &val, K_NO_WAIT));
+
+	/* In the order they became ready */
+	expect_ready(3, EV_SIGNAL, EV_FIFO, EV_MSGQ);
+	zassert_equal(events[EV_SIGNAL].state, K_POLL_STATE_SIGNALED);
+	zassert_equal(events[EV_FIFO].state, K_POLL_STATE_FIFO_DATA_AVAILABLE);
+	zassert_equal(events[EV_MSGQ].state, K_POLL_STATE_MSGQ_DATA_AVAILABLE);
+
+	k_poll_signal_reset(&signal);
+	zassert_equal_ptr(k_fifo_get(&fifo, K_NO_WAIT), &item);
+	zassert_ok(k_msgq_get(&msgq, &val, K_NO_WAIT));
+	zassert_equal(k_poll_set_wait(&set, ready, MAX_EVENTS, K_NO_WAIT),
+		      -EAGAIN);
+}
+
+ZTEST(poll_set, test_round_robin)
+{
+	add_all();
+
+	k_sem_give(&sem);
+	k_poll_signal_raise(&signal, 0);
+
+	/* Events still ready go behind the others */
+	for (int i = 0; i < 4; i++) {
+		zassert_equal(k_poll_set_wait(&set, ready, 1, K_NO_WAIT), 1);
+		zassert_equal_ptr(ready[0], &events[(i % 2) ? EV_SIGNAL : EV_SEM]);
+	}
+}
+
+ZTEST(poll_set, test_ready_before_add)
+{
+	k_sem_give(&sem);
+	add_all();
+
+	expect_ready(1, EV_SEM);
+}
+
+ZTEST(poll_set, test_consumed_before_wait)
+{
+	add_all();
+
+	k_sem_give(&sem);
+	zassert_ok(k_sem_take(&sem, K_NO_WAIT));
+
+	zassert_equal(k_poll_set_wait(&set, ready, MAX_EVENTS, K_NO_WAIT),
+		      -EAGAIN);
+}
+
+ZTEST(poll_set, test_add_remove)
+{
+	add_all();
+	zassert_equal(k_poll_set_add(&set, &events[EV_SEM]), -EBUSY);
+
+	k_sem_give(&sem);
+	zassert_ok(k_poll_set_remove(&set, &events[EV_SEM]));
+	zassert_equal(k_poll_set_remove(&set, &events[EV_SEM]), -EINVAL);
+	zassert_equal(k_poll_set_wait(&set, ready, MAX_EVENTS, K_NO_WAIT),
+		      -EAGAIN);
+
+	/* The semaphore is not watched anymore */
+	k_sem_give(&sem);
+	zassert_equal(k_poll_set_wait(&set, ready, MAX_EVENTS, K_NO_WAIT),
+		      -EAGAIN);
+
+	zassert_ok(k_poll_set_add(&set, &events[EV_SEM]));
+	expect_ready(1, EV_SEM);
+}
+
+ZTEST(poll_set, test_timeout)
+{
+	int64_t start;
+
+	add_all();
+
+	start = k_uptime_get();
+	zassert_equal(k_poll_set_wait(&set, ready, MAX_EVENTS,
+				      K_MSEC(TIMEOUT_MS)), -EAGAIN);
+	zassert_true(k_uptime_get() - start >= TIMEOUT_MS - 1);
+}
+
+static void delayed_give(void *p1, void *p2, void *p3)
+{
+	k_msleep(TIMEOUT_MS / 2);
+	k_sem_give(&sem);
+}
+
+ZTEST(poll_set, test_wakeup)
+{
+	add_all();
+	start_thread(delayed_give);
+
+	zassert_equal(k_poll_set_wait(&set, ready, MAX_EVENTS,
+				      K_MSEC(2 * TIMEOUT_MS)), 1);
+	zassert_equal_ptr(ready[0], &events[EV_SEM]);
+	k_thread_join(&thread, K_FOREVER);
+}
+
+static void isr_raise(const void *arg)
+{
+	k_poll_signal_raise(&signal, 1);
+}
+
+static void delayed_isr_raise(void *p1, void *p2, void *p3)
+{
+	k_msleep(TIMEOUT_MS / 2);
+	irq_offload(isr_raise, NULL);
+}
+
+ZTEST(poll_set, test_wakeup_from_isr)
+{
+	add_all();
+	start_thread(delayed_isr_raise);
+
+	zassert_equal(k_poll_set_wait(&set, ready, MAX_EVENTS, K_FOREVER), 1);
+	zassert_equal_ptr(ready[0], &events[EV_SIGNAL]);
+	k_thread_join(&thread, K_FOREVER);
+}
+
+ZTEST(poll_set, test_ringq)
+{
+#ifdef CONFIG_RINGQ
+	uint32_t val = 3;
+
+	add_all();
+
+	zassert_ok(k_ringq_put(&ringq, &val, K_NO_WAIT));
+	expect_ready(1, EV_RINGQ);
+	zassert_equal(events[EV_RINGQ].state, K_POLL_STATE_RINGQ_DATA_AVAILABLE);
+
+	zassert_ok(k_ringq_get(&ringq, &val, K_NO_WAIT));
+	zassert_equal(k_poll_set_wait(&set, ready, MAX_EVENTS, K_NO_WAIT),
+		      -EAGAIN);
+
+	/* Producers see the set as a waiter until the event is removed */
+	zassert_equal(atomic_get(&ringq.get_waiters), 1);
+	zassert_ok(k_poll_set_remove(&set, &events[EV_RINGQ]));
+	zassert_equal(atomic_get(&ringq.get_waiters), 0);
+#else
+	ztest_test_skip();
+#endif
+}
+
+static void poll_set_before(void *fixture)
+{
+	k_poll_set_init(&set);
+	k_sem_init(&sem, 0, 1);
+	k_fifo_init(&fifo);
+	k_poll_signal_init(&signal);
+	k_msgq_purge(&msgq);
+
+	k_poll_event_init(&events[EV_SEM], K_POLL_TYPE_SEM_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &sem);
+	k_poll_event_init(&events[EV_FIFO], K_POLL_TYPE_FIFO_DATA_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &fifo);
+	k_poll_event_init(&events[EV_MSGQ], K_POLL_TYPE_MSGQ_DATA_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &msgq);
+	k_poll_event_init(&events[EV_SIGNAL], K_POLL_TYPE_SIGNAL,
+			  K_POLL_MODE_NOTIFY_ONLY, &signal);
+#ifdef CONFIG_RINGQ
+	k_poll_event_init(&events[EV_RINGQ], K_POLL_TYPE_RINGQ_DATA_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &ringq);
+#endif
+}
+
+static void poll_set_after(void *fixture)
+{
+	for (int i = 0; i < NUM_EVENTS; i++) {
+		(void)k_poll_set_remove(&set, &events[i]);
+	}
+}
+
+ZTEST_SUITE(poll_set, NULL, NULL, poll_set_before, poll_set_after, NULL);
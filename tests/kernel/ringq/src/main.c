@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/irq_offload.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define MAX_MSGS 4
+#define TIMEOUT_MS 100
+#define STRESS_MSGS 2000
+#define NUM_PRODUCERS 2
+#define NUM_CONSUMERS 2
+
+struct msg {
+	uint32_t seq;
+	uint8_t data[3];
+};
+
+K_RINGQ_DEFINE(static_q, sizeof(struct msg), MAX_MSGS, 0);
+K_RINGQ_DEFINE(mpmc_q, sizeof(uint32_t), MAX_MSGS, K_RINGQ_FLAG_MPMC);
+
+static atomic_t buffer[K_RINGQ_BUF_SIZE(sizeof(struct msg), MAX_MSGS) /
+		       sizeof(atomic_t)];
+static struct k_ringq q;
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, NUM_PRODUCERS + NUM_CONSUMERS,
+				   STACK_SIZE);
+static struct k_thread threads[NUM_PRODUCERS + NUM_CONSUMERS];
+
+static atomic_t consumed_sum;
+static atomic_t consumed_cnt;
+
+static void put_msg(struct k_ringq *rq, uint32_t seq, k_timeout_t timeout,
+		    int expected)
+{
+	struct msg m = { .seq = seq, .data = { seq, seq >> 8, 0xa5 } };
+
+	zassert_equal(k_ringq_put(rq, &m, timeout), expected);
+}
+
+static void get_msg(struct k_ringq *rq, uint32_t seq, k_timeout_t timeout)
+{
+	struct msg m;
+
+	zassert_ok(k_ringq_get(rq, &m, timeout));
+	zassert_equal(m.seq, seq, "got %u, expected %u", m.seq, seq);
+	zassert_equal(m.data[2], 0xa5);
+}
+
+static void start_thread(int idx, k_thread_entry_t entry, void *p1, int prio)
+{
+	k_thread_create(&threads[idx], stacks[idx], STACK_SIZE, entry, p1,
+			NULL, NULL, prio, 0, K_NO_WAIT);
+}
+
+ZTEST(ringq, test_put_get)
+{
+	struct msg m;
+
+	zassert_equal(k_ringq_get(&q, &m, K_NO_WAIT), -ENOMSG);
+
+	/* Several laps of the ring, going through the full state */
+	for (uint32_t lap = 0; lap < 5; lap++) {
+		for (uint32_t i = 0; i < MAX_MSGS; i++) {
+			put_msg(&q, lap * MAX_MSGS + i, K_NO_WAIT, 0);
+			zassert_equal(k_ringq_num_used_get(&q), i + 1);
+		}
+		put_msg(&q, 0, K_NO_WAIT, -ENOMSG);
+
+		for (uint32_t i = 0; i < MAX_MSGS; i++) {
+			get_msg(&q, lap * MAX_MSGS + i, K_NO_WAIT);
+		}
+		zassert_equal(k_ringq_num_used_get(&q), 0);
+		zassert_equal(k_ringq_get(&q, &m, K_NO_WAIT), -ENOMSG);
+	}
+}
+
+ZTEST(ringq, test_static)
+{
+	/* Interleaved use, the ring is never full */
+	for (uint32_t i = 0; i < 3 * MAX_MSGS; i++) {
+		put_msg(&static_q, i, K_NO_WAIT, 0);
+		put_msg(&static_q, i + 100, K_NO_WAIT, 0);
+		get_msg(&static_q, i, K_NO_WAIT);
+		get_msg(&static_q, i + 100, K_NO_WAIT);
+	}
+}
+
+ZTEST(ringq, test_timeout)
+{
+	struct msg m;
+
+	zassert_equal(k_ringq_get(&q, &m, K_MSEC(TIMEOUT_MS)), -EAGAIN);
+
+	for (uint32_t i = 0; i < MAX_MSGS; i++) {
+		put_msg(&q, i, K_NO_WAIT, 0);
+	}
+	put_msg(&q, 0, K_MSEC(TIMEOUT_MS), -EAGAIN);
+
+	for (uint32_t i = 0; i < MAX_MSGS; i++) {
+		get_msg(&q, i, K_NO_WAIT);
+	}
+}
+
+static void delayed_producer(void *p1, void *p2, void *p3)
+{
+	k_msleep(TIMEOUT_MS / 2);
+	put_msg(&q, POINTER_TO_UINT(p1), K_NO_WAIT, 0);
+}
+
+ZTEST(ringq, test_get_wakeup)
+{
+	start_thread(0, delayed_producer, UINT_TO_POINTER(42),
+		     K_PRIO_PREEMPT(1));
+
+	get_msg(&q, 42, K_MSEC(2 * TIMEOUT_MS));
+	zassert_equal(atomic_get(&q.get_waiters), 0);
+	k_thread_join(&threads[0], K_FOREVER);
+}
+
+static void isr_put(const void *arg)
+{
+	put_msg(&q, POINTER_TO_UINT(arg), K_NO_WAIT, 0);
+}
+
+static void isr_producer(void *p1, void *p2, void *p3)
+{
+	k_msleep(TIMEOUT_MS / 2);
+	irq_offload(isr_put, p1);
+}
+
+ZTEST(ringq, test_get_wakeup_from_isr)
+{
+	start_thread(0, isr_producer, UINT_TO_POINTER(7), K_PRIO_PREEMPT(1));
+
+	get_msg(&q, 7, K_MSEC(2 * TIMEOUT_MS));
+	k_thread_join(&threads[0], K_FOREVER);
+}
+
+static void delayed_consumer(void *p1, void *p2, void *p3)
+{
+	k_msleep(TIMEOUT_MS / 2);
+	get_msg(&q, 0, K_NO_WAIT);
+}
+
+ZTEST(ringq, test_put_wakeup)
+{
+	for (uint32_t i = 0; i < MAX_MSGS; i++) {
+		put_msg(&q, i, K_NO_WAIT, 0);
+	}
+
+	start_thread(0, delayed_consumer, NULL, K_PRIO_PREEMPT(1));
+
+	/* Blocks until the consumer made room */
+	put_msg(&q, MAX_MSGS, K_MSEC(2 * TIMEOUT_MS), 0);
+	zassert_equal(atomic_get(&q.put_waiters), 0);
+	k_thread_join(&threads[0], K_FOREVER);
+
+	for (uint32_t i = 1; i <= MAX_MSGS; i++) {
+		get_msg(&q, i, K_NO_WAIT);
+	}
+}
+
+ZTEST(ringq, test_poll)
+{
+#ifdef CONFIG_POLL
+	struct k_poll_event event = K_POLL_EVENT_INITIALIZER(
+		K_POLL_TYPE_RINGQ_DATA_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY, &q);
+
+	zassert_equal(k_poll(&event, 1, K_NO_WAIT), -EAGAIN);
+	zassert_equal(atomic_get(&q.get_waiters), 0);
+
+	/* Data put while polling */
+	start_thread(0, delayed_producer, UINT_TO_POINTER(3), K_PRIO_PREEMPT(1));
+	zassert_ok(k_poll(&event, 1, K_MSEC(2 * TIMEOUT_MS)));
+	zassert_equal(event.state, K_POLL_STATE_RINGQ_DATA_AVAILABLE);
+	k_thread_join(&threads[0], K_FOREVER);
+
+	/* Data already there */
+	event.state = K_POLL_STATE_NOT_READY;
+	zassert_ok(k_poll(&event, 1, K_FOREVER));
+	zassert_equal(event.state, K_POLL_STATE_RINGQ_DATA_AVAILABLE);
+	zassert_equal(atomic_get(&q.get_waiters), 0);
+
+	get_msg(&q, 3, K_NO_WAIT);
+#else
+	ztest_test_skip();
+#endif
+}
+
+static void mpmc_producer(void *p1, void *p2, void *p3)
+{
+	uint32_t base = POINTER_TO_UINT(p1) * STRESS_MSGS;
+
+	for (uint32_t i = 0; i < STRESS_MSGS; i++) {
+		uint32_t val = base + i;
+
+		zassert_ok(k_ringq_put(&mpmc_q, &val, K_FOREVER));
+		if ((i % 7) == 0) {
+			k_yield();
+		}
+	}
+}
+
+static void mpmc_consumer(void *p1, void *p2, void *p3)
+{
+	uint32_t val;
+
+	while (k_ringq_get(&mpmc_q, &val, K_MSEC(TIMEOUT_MS)) == 0) {
+		atomic_add(&consumed_sum, val);
+		atomic_inc(&consumed_cnt);
+		if ((val % 5) == 0) {
+			k_yield();
+		}
+	}
+}
+
+ZTEST(ringq, test_mpmc)
+{
+	uint32_t total = NUM_PRODUCERS * STRESS_MSGS;
+
+	for (int i = 0; i < NUM_CONSUMERS; i++) {
+		start_thread(NUM_PRODUCERS + i, mpmc_consumer, NULL,
+			     K_PRIO_PREEMPT(1));
+	}
+	for (int i = 0; i < NUM_PRODUCERS; i++) {
+		start_thread(i, mpmc_producer, UINT_TO_POINTER(i),
+			     K_PRIO_PREEMPT(1));
+	}
+
+	for (int i = 0; i < NUM_PRODUCERS + NUM_CONSUMERS; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	zassert_equal(atomic_get(&consumed_cnt), total);
+	zassert_equal(atomic_get(&consumed_sum), total * (total - 1) / 2);
+	zassert_equal(k_ringq_num_used_get(&mpmc_q), 0);
+}
+
+static void ringq_before(void *fixture)
+{
+	k_ringq_init(&q, buffer, sizeof(struct msg), MAX_MSGS, 0);
+	atomic_clear(&consumed_sum);
+	atomic_clear(&consumed_cnt);
+}
+
+ZTEST_SUITE(ringq, NULL, NULL, ringq_before, NULL, NULL);
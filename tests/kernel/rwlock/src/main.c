@@ -0,0 +1,331 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define NUM_THREADS 4
+#define TIMEOUT_MS 100
+#define STRESS_ROUNDS 2000
+
+#define MAIN_PRIO K_PRIO_PREEMPT(5)
+#define HIGH_PRIO K_PRIO_PREEMPT(2)
+#define LOW_PRIO K_PRIO_PREEMPT(8)
+
+K_RWLOCK_DEFINE(static_rwlock, 0);
+static struct k_rwlock rwlock;
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, NUM_THREADS, STACK_SIZE);
+static struct k_thread threads[NUM_THREADS];
+
+/* Order in which the threads got the lock */
+static atomic_t order_idx;
+static int order[NUM_THREADS];
+static int results[NUM_THREADS];
+
+static atomic_t readers;
+static atomic_t writers;
+static atomic_t writes;
+static uint32_t counter;
+static int writer_prio;
+
+/* Lets the thread run until it waits for the lock, even if it is not
+ * scheduled before the caller
+ */
+static void start_thread(int idx, k_thread_entry_t entry, void *p2, int prio)
+{
+	k_thread_create(&threads[idx], stacks[idx], STACK_SIZE, entry,
+			INT_TO_POINTER(idx), p2, NULL, prio, 0, K_NO_WAIT);
+	k_msleep(10);
+}
+
+static void join_threads(int count)
+{
+	for (int i = 0; i < count; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+}
+
+static void record(int idx)
+{
+	order[atomic_inc(&order_idx)] = idx;
+}
+
+/* Takes the lock for reading if p2 is NULL, else for writing */
+static void locker(void *p1, void *p2, void *p3)
+{
+	int idx = POINTER_TO_INT(p1);
+	bool write = p2 != NULL;
+
+	results[idx] = write ? k_rwlock_write_lock(&rwlock, K_FOREVER) :
+			       k_rwlock_read_lock(&rwlock, K_FOREVER);
+	record(idx);
+
+	if (write) {
+		zassert_ok(k_rwlock_write_unlock(&rwlock));
+	} else {
+		zassert_ok(k_rwlock_read_unlock(&rwlock));
+	}
+}
+
+static void timed_locker(void *p1, void *p2, void *p3)
+{
+	int idx = POINTER_TO_INT(p1);
+	bool write = p2 != NULL;
+
+	results[idx] = write ? k_rwlock_write_lock(&rwlock, K_MSEC(TIMEOUT_MS)) :
+			       k_rwlock_read_lock(&rwlock, K_MSEC(TIMEOUT_MS));
+	if (results[idx] == 0) {
+		record(idx);
+	}
+}
+
+/* Records the priority it holds the write lock with */
+static void prio_writer(void *p1, void *p2, void *p3)
+{
+	int idx = POINTER_TO_INT(p1);
+
+	results[idx] = k_rwlock_write_lock(&rwlock, K_FOREVER);
+	writer_prio = k_thread_priority_get(k_current_get());
+	zassert_ok(k_rwlock_write_unlock(&rwlock));
+}
+
+ZTEST_USER(rwlock, test_read_write)
+{
+	/* Several readers at once */
+	zassert_ok(k_rwlock_read_lock(&static_rwlock, K_NO_WAIT));
+	zassert_ok(k_rwlock_read_lock(&static_rwlock, K_FOREVER));
+	zassert_equal(k_rwlock_write_lock(&static_rwlock, K_NO_WAIT), -EBUSY);
+	zassert_equal(k_rwlock_write_unlock(&static_rwlock), -EPERM);
+	zassert_ok(k_rwlock_read_unlock(&static_rwlock));
+	zassert_ok(k_rwlock_read_unlock(&static_rwlock));
+	zassert_equal(k_rwlock_read_unlock(&static_rwlock), -EPERM);
+
+	/* A single writer */
+	zassert_ok(k_rwlock_write_lock(&static_rwlock, K_NO_WAIT));
+	zassert_equal(k_rwlock_write_lock(&static_rwlock, K_NO_WAIT), -EDEADLK);
+	zassert_equal(k_rwlock_read_lock(&static_rwlock, K_NO_WAIT), -EDEADLK);
+	zassert_equal(k_rwlock_read_unlock(&static_rwlock), -EPERM);
+	zassert_ok(k_rwlock_write_unlock(&static_rwlock));
+	zassert_equal(k_rwlock_write_unlock(&static_rwlock), -EPERM);
+
+	zassert_ok(k_rwlock_read_lock(&static_rwlock, K_NO_WAIT));
+	zassert_ok(k_rwlock_read_unlock(&static_rwlock));
+}
+
+ZTEST_USER(rwlock, test_init)
+{
+	zassert_equal(k_rwlock_init(&rwlock, BIT(7)), -EINVAL);
+	zassert_ok(k_rwlock_init(&rwlock, K_RWLOCK_FAIR));
+	zassert_ok(k_rwlock_write_lock(&rwlock, K_FOREVER));
+	zassert_ok(k_rwlock_write_unlock(&rwlock));
+}
+
+ZTEST(rwlock, test_writer_blocks_readers)
+{
+	zassert_ok(k_rwlock_read_lock(&rwlock, K_NO_WAIT));
+
+	/* A waiting writer keeps new readers out */
+	start_thread(0, locker, &rwlock, HIGH_PRIO);
+	zassert_equal(k_rwlock_read_lock(&rwlock, K_NO_WAIT), -EBUSY);
+	zassert_equal(atomic_get(&order_idx), 0);
+
+	/* The last reader hands the lock over to the writer */
+	zassert_ok(k_rwlock_read_unlock(&rwlock));
+	zassert_equal(atomic_get(&order_idx), 1);
+	zassert_ok(results[0]);
+
+	join_threads(1);
+	zassert_ok(k_rwlock_read_lock(&rwlock, K_NO_WAIT));
+	zassert_ok(k_rwlock_read_unlock(&rwlock));
+}
+
+/* A reader and then a writer wait for the write lock of this thread */
+static void wait_behind_writer(uint32_t flags)
+{
+	zassert_ok(k_rwlock_init(&rwlock, flags));
+	zassert_ok(k_rwlock_write_lock(&rwlock, K_NO_WAIT));
+
+	start_thread(0, locker, NULL, HIGH_PRIO);
+	start_thread(1, locker, &rwlock, HIGH_PRIO);
+	zassert_equal(atomic_get(&order_idx), 0);
+
+	zassert_ok(k_rwlock_write_unlock(&rwlock));
+	join_threads(2);
+	zassert_ok(results[0]);
+	zassert_ok(results[1]);
+}
+
+ZTEST(rwlock, test_writer_preference)
+{
+	wait_behind_writer(0);
+
+	zassert_equal(order[0], 1, "the writer goes first");
+	zassert_equal(order[1], 0);
+}
+
+ZTEST(rwlock, test_fair)
+{
+	wait_behind_writer(K_RWLOCK_FAIR);
+
+	zassert_equal(order[0], 0, "the readers go first");
+	zassert_equal(order[1], 1);
+}
+
+ZTEST(rwlock, test_timeout)
+{
+	zassert_ok(k_rwlock_write_lock(&rwlock, K_NO_WAIT));
+	start_thread(0, timed_locker, NULL, HIGH_PRIO);
+	join_threads(1);
+	zassert_equal(results[0], -EAGAIN);
+	zassert_ok(k_rwlock_write_unlock(&rwlock));
+
+	zassert_ok(k_rwlock_read_lock(&rwlock, K_NO_WAIT));
+	start_thread(0, timed_locker, &rwlock, HIGH_PRIO);
+	join_threads(1);
+	zassert_equal(results[0], -EAGAIN);
+
+	/* Nobody waits anymore */
+	zassert_ok(k_rwlock_read_lock(&rwlock, K_NO_WAIT));
+	zassert_ok(k_rwlock_read_unlock(&rwlock));
+	zassert_ok(k_rwlock_read_unlock(&rwlock));
+	zassert_ok(k_rwlock_write_lock(&rwlock, K_NO_WAIT));
+	zassert_ok(k_rwlock_write_unlock(&rwlock));
+}
+
+ZTEST(rwlock, test_writer_gives_up)
+{
+	zassert_ok(k_rwlock_read_lock(&rwlock, K_NO_WAIT));
+
+	/* The reader waits behind the writer, until the writer times out */
+	start_thread(0, timed_locker, &rwlock, HIGH_PRIO);
+	start_thread(1, locker, NULL, HIGH_PRIO);
+	zassert_equal(atomic_get(&order_idx), 0);
+
+	join_threads(2);
+	zassert_equal(results[0], -EAGAIN);
+	zassert_ok(results[1]);
+	zassert_equal(order[0], 1);
+
+	zassert_ok(k_rwlock_read_unlock(&rwlock));
+	zassert_ok(k_rwlock_write_lock(&rwlock, K_NO_WAIT));
+	zassert_ok(k_rwlock_write_unlock(&rwlock));
+}
+
+ZTEST(rwlock, test_priority_inheritance)
+{
+	zassert_ok(k_rwlock_write_lock(&rwlock, K_NO_WAIT));
+
+	/* Raised by a waiting reader, and back when it gives up */
+	start_thread(0, timed_locker, NULL, HIGH_PRIO);
+	zassert_equal(k_thread_priority_get(k_current_get()), HIGH_PRIO);
+	join_threads(1);
+	zassert_equal(results[0], -EAGAIN);
+	zassert_equal(k_thread_priority_get(k_current_get()), MAIN_PRIO);
+
+	/* Raised by a waiting writer, until the lock is released */
+	start_thread(0, locker, &rwlock, HIGH_PRIO);
+	zassert_equal(k_thread_priority_get(k_current_get()), HIGH_PRIO);
+	zassert_ok(k_rwlock_write_unlock(&rwlock));
+	zassert_equal(k_thread_priority_get(k_current_get()), MAIN_PRIO);
+	join_threads(1);
+	zassert_ok(results[0]);
+
+	/* A writer handed the lock by the last reader is raised by a reader
+	 * queued behind it
+	 */
+	zassert_ok(k_rwlock_read_lock(&rwlock, K_NO_WAIT));
+	start_thread(0, prio_writer, NULL, LOW_PRIO);
+	start_thread(1, locker, NULL, HIGH_PRIO);
+	zassert_ok(k_rwlock_read_unlock(&rwlock));
+	join_threads(2);
+	zassert_ok(results[0]);
+	zassert_ok(results[1]);
+	zassert_equal(writer_prio, HIGH_PRIO);
+}
+
+/* The odd threads give up waiting after a tick, racing their cleanup with
+ * the other lockers
+ */
+static void stress(void *p1, void *p2, void *p3)
+{
+	int idx = POINTER_TO_INT(p1);
+	k_timeout_t timeout = (idx & 1) ? K_TICKS(1) : K_FOREVER;
+	int ret;
+
+	for (int i = 0; i < STRESS_ROUNDS; i++) {
+		if ((i % (idx + 2)) == 0) {
+			ret = k_rwlock_write_lock(&rwlock, timeout);
+			if (ret == -EAGAIN) {
+				continue;
+			}
+			zassert_ok(ret);
+			zassert_equal(atomic_inc(&writers), 0);
+			zassert_equal(atomic_get(&readers), 0);
+			counter++;
+			atomic_inc(&writes);
+			if ((i % 3) == 0) {
+				k_yield();
+			}
+			atomic_dec(&writers);
+			zassert_ok(k_rwlock_write_unlock(&rwlock));
+		} else {
+			ret = k_rwlock_read_lock(&rwlock, timeout);
+			if (ret == -EAGAIN) {
+				continue;
+			}
+			zassert_ok(ret);
+			atomic_inc(&readers);
+			zassert_equal(atomic_get(&writers), 0);
+			if ((i % 5) == 0) {
+				k_yield();
+			}
+			atomic_dec(&readers);
+			zassert_ok(k_rwlock_read_unlock(&rwlock));
+		}
+	}
+}
+
+ZTEST(rwlock, test_stress)
+{
+	for (int i = 0; i < NUM_THREADS; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, stress,
+				INT_TO_POINTER(i), NULL, NULL, MAIN_PRIO, 0,
+				K_FOREVER);
+	}
+
+	for (int i = 0; i < NUM_THREADS; i++) {
+		k_thread_start(&threads[i]);
+	}
+
+	join_threads(NUM_THREADS);
+	zassert_equal(counter, atomic_get(&writes));
+
+	/* No waiter was left behind */
+	zassert_ok(k_rwlock_write_lock(&rwlock, K_NO_WAIT));
+	zassert_ok(k_rwlock_write_unlock(&rwlock));
+}
+
+static void *rwlock_setup(void)
+{
+#ifdef CONFIG_USERSPACE
+	k_thread_access_grant(k_current_get(), &static_rwlock, &rwlock);
+#endif
+	return NULL;
+}
+
+static void rwlock_before(void *fixture)
+{
+	k_thread_priority_set(k_current_get(), MAIN_PRIO);
+	zassert_ok(k_rwlock_init(&rwlock, 0));
+	atomic_clear(&order_idx);
+	atomic_clear(&readers);
+	atomic_clear(&writers);
+	atomic_clear(&writes);
+	counter = 0;
+}
+
+ZTEST_SUITE(rwlock, NULL, rwlock_setup, rwlock_before, NULL, NULL);
@@ -753,6 +753,43 @@ ZTEST(smp, test_smp_ipi)
 }
 #endif
 
+#ifdef CONFIG_ARCH_HAS_DIRECTED_IPIS
+/**
+ * @brief Test sending an IPI to a single CPU
+ *
+ * @ingroup kernel_smp_tests
+ *
+ * @see arch_sched_directed_ipi()
+ */
+ZTEST(smp, test_smp_directed_ipi)
+{
+#ifndef CONFIG_TRACE_SCHED_IPI
+	ztest_test_skip();
+#endif
+
+	unsigned int num_cpus = arch_num_cpus();
+
+	for (unsigned int cpu = 0; cpu < num_cpus; cpu++) {
+		unsigned int key = arch_irq_lock();
+
+		if (cpu == arch_curr_cpu()->id) {
+			arch_irq_unlock(key);
+			continue;
+		}
+
+		sched_ipi_has_called = 0;
+		arch_sched_directed_ipi(BIT(cpu));
+		arch_irq_unlock(key);
+
+		k_msleep(100);
+
+		/**TESTPOINT: check if the CPU entered the IPI handler */
+		zassert_true(sched_ipi_has_called != 0,
+			     "CPU %u did not receive IPI", cpu);
+	}
+}
+#endif
+
 void k_sys_fatal_error_handler(unsigned int reason, const z_arch_esf_t *esf)
 {
 	static int trigger;
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/irq.h>
+#include <zephyr/ztest.h>
+#ifdef CONFIG_SCHED_ISR_USAGE_HISTOGRAM
+#include <zephyr/interrupt_util.h>
+#endif
+
+#define BUCKETS CONFIG_SCHED_USAGE_HISTOGRAM_BUCKETS
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define WAKEUPS 10
+
+static K_THREAD_STACK_DEFINE(helper_stack, STACK_SIZE);
+static struct k_thread helper_thread;
+static K_SEM_DEFINE(wake_sem, 0, 1);
+
+static uint32_t hist_count(const uint32_t *hist)
+{
+	uint32_t count = 0;
+
+	for (int i = 0; i < BUCKETS; i++) {
+		count += hist[i];
+	}
+
+	return count;
+}
+
+static void helper(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < WAKEUPS; i++) {
+		k_sem_take(&wake_sem, K_FOREVER);
+		k_busy_wait(100);
+	}
+}
+
+static void start_helper(void)
+{
+	k_thread_create(&helper_thread, helper_stack, STACK_SIZE, helper,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+}
+
+ZTEST(usage_histogram, test_thread_histograms)
+{
+	k_thread_runtime_stats_t stats;
+
+	start_helper();
+
+	for (int i = 0; i < WAKEUPS; i++) {
+		k_sem_give(&wake_sem);
+		k_msleep(1);
+	}
+	k_thread_join(&helper_thread, K_FOREVER);
+
+	zassert_ok(k_thread_runtime_stats_get(&helper_thread, &stats));
+
+	/* Creation and every wakeup make the thread ready once */
+	zassert_true(hist_count(stats.latency_histogram) >= WAKEUPS,
+		     "%u latency samples", hist_count(stats.latency_histogram));
+	zassert_true(hist_count(stats.run_histogram) >= WAKEUPS,
+		     "%u run samples", hist_count(stats.run_histogram));
+
+	/* A 100 us busy wait can't land in the zero cycle bucket */
+	zassert_true(hist_count(stats.run_histogram) > stats.run_histogram[0]);
+
+	zassert_ok(k_thread_runtime_stats_all_get(&stats));
+	zassert_true(hist_count(stats.run_histogram) >= WAKEUPS);
+	zassert_true(hist_count(stats.latency_histogram) >= WAKEUPS);
+}
+
+ZTEST(usage_histogram, test_thread_histograms_reset)
+{
+	k_thread_runtime_stats_t stats;
+
+	/* Complete at least one run of the current thread */
+	k_msleep(1);
+	k_thread_runtime_stats_get(k_current_get(), &stats);
+	zassert_true(hist_count(stats.run_histogram) > 0);
+
+	zassert_ok(k_obj_core_stats_reset(K_OBJ_CORE(k_current_get())));
+	k_thread_runtime_stats_get(k_current_get(), &stats);
+	zassert_equal(hist_count(stats.run_histogram), 0);
+	zassert_equal(hist_count(stats.latency_histogram), 0);
+}
+
+#ifdef CONFIG_SCHED_ISR_USAGE_HISTOGRAM
+static void test_isr(const void *param)
+{
+	ARG_UNUSED(param);
+
+	k_busy_wait(10);
+}
+#endif
+
+ZTEST(usage_histogram, test_isr_histograms)
+{
+#ifdef CONFIG_SCHED_ISR_USAGE_HISTOGRAM
+	uint32_t hist[BUCKETS];
+	uint32_t count = 0;
+	unsigned int irq;
+
+	zassert_equal(k_isr_usage_histogram_get(CONFIG_NUM_IRQS, hist), -EINVAL);
+
+	k_isr_usage_histogram_reset();
+	for (unsigned int irq = 0; irq < CONFIG_NUM_IRQS; irq++) {
+		zassert_ok(k_isr_usage_histogram_get(irq, hist));
+		count += hist_count(hist);
+	}
+	zassert_equal(count, 0);
+
+	/* Interrupts raised by software go through the same wrapper as the
+	 * ones of devices, unlike the system timer exception on Cortex-M
+	 */
+#if defined(CONFIG_CPU_CORTEX_M)
+	irq = get_available_nvic_line(CONFIG_NUM_IRQS);
+#else
+	irq = CONFIG_NUM_IRQS - 1;
+#endif
+	zassert_equal(irq_connect_dynamic(irq, 1, test_isr, NULL, 0), irq);
+	irq_enable(irq);
+
+	for (int i = 0; i < WAKEUPS; i++) {
+		trigger_irq(irq);
+		k_msleep(1);
+	}
+	irq_disable(irq);
+
+	zassert_ok(k_isr_usage_histogram_get(irq, hist));
+	zassert_equal(hist_count(hist), WAKEUPS, "%u ISR samples",
+		      hist_count(hist));
+#else
+	ztest_test_skip();
+#endif
+}
+
+ZTEST_SUITE(usage_histogram, NULL, NULL, NULL, NULL, NULL);
@@ -120,6 +120,11 @@ static inline int preempt_counter(void)
 static K_THREAD_STACK_DEFINE(invalid_test_stack, STACK_SIZE);
 static struct k_work_q invalid_test_queue;
 
+#ifdef CONFIG_WORKQUEUE_NOTIFY_DELAY
+static K_THREAD_STACK_DEFINE(delayed_stack, STACK_SIZE);
+static struct k_work_q delayed_queue;
+#endif
+
 static atomic_t system_ctr;
 static inline int system_counter(void)
 {
@@ -267,6 +272,14 @@ static void test_queue_start(void)
 			    COOPLO_PRIORITY, &cfg);
 	zassert_equal(cooplo_queue.flags,
 		      K_WORK_QUEUE_STARTED | K_WORK_QUEUE_NO_YIELD, NULL);
+
+#ifdef CONFIG_WORKQUEUE_NOTIFY_DELAY
+	cfg.name = "wq.delayed";
+	cfg.no_yield = true;
+	cfg.notify_delay = DELAY_TIMEOUT;
+	k_work_queue_start(&delayed_queue, delayed_stack, STACK_SIZE,
+			    COOPHI_PRIORITY, &cfg);
+#endif
 }
 
 /* Check validation of submission without a destination queue. */
@@ -313,6 +326,102 @@ ZTEST(work_1cpu, test_1cpu_simple_queue)
 	zassert_equal(rc, 0);
 }
 
+/* Single-CPU check submitting several items at once. */
+ZTEST(work_1cpu, test_1cpu_batch_queue)
+{
+	struct k_work *works[] = { &common_work, &common_work1, &common_work };
+	int rc;
+
+	/* Reset state and use the non-blocking handler */
+	reset_counters();
+	k_work_init(&common_work, counter_handler);
+	k_work_init(&common_work1, counter_handler);
+
+	/* Items never submitted have no queue to fall back to */
+	rc = k_work_submit_batch_to_queue(NULL, works, ARRAY_SIZE(works));
+	zassert_equal(rc, 0);
+
+	/* The repeated item is only queued once */
+	rc = k_work_submit_batch_to_queue(&coophi_queue, works,
+					  ARRAY_SIZE(works));
+	zassert_equal(rc, 2);
+	zassert_equal(k_work_busy_get(&common_work), K_WORK_QUEUED);
+	zassert_equal(k_work_busy_get(&common_work1), K_WORK_QUEUED);
+
+	/* Shouldn't have been started since test thread is
+	 * cooperative.
+	 */
+	zassert_equal(coophi_counter(), 0);
+
+	/* Let them run, then check they finished. */
+	k_sleep(K_TICKS(1));
+	zassert_equal(coophi_counter(), 2);
+	zassert_equal(k_work_busy_get(&common_work), 0);
+	zassert_equal(k_work_busy_get(&common_work1), 0);
+
+	/* Flush the sync state from completion */
+	rc = k_sem_take(&sync_sem, K_NO_WAIT);
+	zassert_equal(rc, 0);
+
+	/* Resubmitting to the previous queue */
+	rc = k_work_submit_batch_to_queue(NULL, works, 2);
+	zassert_equal(rc, 2);
+	k_sleep(K_TICKS(1));
+	zassert_equal(coophi_counter(), 4);
+	rc = k_sem_take(&sync_sem, K_NO_WAIT);
+	zassert_equal(rc, 0);
+}
+
+/* Check that a queue with a notification delay processes the items
+ * submitted within the delay after it, and that flushes are not delayed.
+ */
+ZTEST(work_1cpu, test_1cpu_notify_delay)
+{
+#ifdef CONFIG_WORKQUEUE_NOTIFY_DELAY
+	uint32_t start_ms;
+	uint32_t elapsed_ms;
+	int rc;
+
+	/* Reset state and use the non-blocking handler */
+	reset_counters();
+	k_work_init(&common_work, counter_handler);
+	k_work_init(&common_work1, counter_handler);
+
+	/* Align to tick so the delay is not shortened */
+	k_sleep(K_TICKS(1));
+	start_ms = k_uptime_get_32();
+
+	zassert_equal(k_work_submit_to_queue(&delayed_queue, &common_work), 1);
+	k_sleep(K_MSEC(DELAY_MS / 2));
+	zassert_equal(k_work_submit_to_queue(&delayed_queue, &common_work1), 1);
+
+	/* Both items are still waiting for the queue to wake up */
+	zassert_equal(k_work_busy_get(&common_work), K_WORK_QUEUED);
+	zassert_equal(k_work_busy_get(&common_work1), K_WORK_QUEUED);
+
+	rc = k_sem_take(&sync_sem, K_MSEC(2 * DELAY_MS));
+	zassert_equal(rc, 0);
+	elapsed_ms = last_handle_ms - start_ms;
+	zassert_true(elapsed_ms >= DELAY_MS,
+		     "short %u < %u\n", elapsed_ms, DELAY_MS);
+	zassert_equal(k_work_busy_get(&common_work), 0);
+	zassert_equal(k_work_busy_get(&common_work1), 0);
+
+	/* Flushing wakes the queue immediately */
+	start_ms = k_uptime_get_32();
+	zassert_equal(k_work_submit_to_queue(&delayed_queue, &common_work), 1);
+	zassert_true(k_work_flush(&common_work, &work_sync));
+	elapsed_ms = k_uptime_get_32() - start_ms;
+	zassert_true(elapsed_ms < DELAY_MS,
+		     "long %u >= %u\n", elapsed_ms, DELAY_MS);
+
+	rc = k_sem_take(&sync_sem, K_NO_WAIT);
+	zassert_equal(rc, 0);
+#else
+	ztest_test_skip();
+#endif
+}
+
 /* Basic SMP check submitting with a non-blocking handler. */
 ZTEST(work, test_smp_simple_queue)
 {
@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define NUM_WORKERS 2
+#define NUM_THREADS (NUM_WORKERS + 1)
+#define QUEUE_PRIORITY K_PRIO_PREEMPT(1)
+#define RUN_MS 100
+#define NUM_ITEMS 6
+
+static K_THREAD_STACK_DEFINE(queue_stack, STACK_SIZE);
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, NUM_WORKERS, STACK_SIZE);
+static struct k_work_q_worker workers[NUM_WORKERS];
+static struct k_work_q pool_queue;
+
+static struct k_work items[NUM_ITEMS];
+static struct k_work_sync work_sync;
+static K_SEM_DEFINE(done_sem, 0, NUM_ITEMS);
+
+static atomic_t active;
+static atomic_t max_active;
+static atomic_t runs;
+static atomic_t overlaps;
+
+/* Threads which ran the items of a test */
+static k_tid_t runners[NUM_ITEMS];
+
+static void run_item(struct k_work *work, int ms)
+{
+	atomic_val_t now = atomic_inc(&active) + 1;
+	atomic_val_t max = atomic_get(&max_active);
+
+	while (now > max && !atomic_cas(&max_active, max, now)) {
+		max = atomic_get(&max_active);
+	}
+
+	runners[work - items] = k_current_get();
+	k_msleep(ms);
+
+	atomic_dec(&active);
+	atomic_inc(&runs);
+}
+
+static void slow_handler(struct k_work *work)
+{
+	run_item(work, RUN_MS);
+	k_sem_give(&done_sem);
+}
+
+/* Fails the test if two threads run the item at once */
+static void self_handler(struct k_work *work)
+{
+	static atomic_t self_active;
+
+	if (atomic_inc(&self_active) != 0) {
+		atomic_inc(&overlaps);
+	}
+
+	k_msleep(2);
+	atomic_inc(&runs);
+
+	atomic_dec(&self_active);
+	if (atomic_get(&runs) < 10) {
+		(void)k_work_submit_to_queue(&pool_queue, work);
+	}
+}
+
+/* Submits the other items from a thread of the queue */
+static void spawn_handler(struct k_work *work)
+{
+	for (int i = 1; i < NUM_ITEMS; i++) {
+		(void)k_work_submit_to_queue(&pool_queue, &items[i]);
+	}
+	run_item(work, RUN_MS);
+	k_sem_give(&done_sem);
+}
+
+static void wait_done(int count)
+{
+	for (int i = 0; i < count; i++) {
+		zassert_ok(k_sem_take(&done_sem, K_SECONDS(1)));
+	}
+}
+
+ZTEST(work_pool, test_concurrent)
+{
+	for (int i = 0; i < NUM_THREADS; i++) {
+		k_work_init(&items[i], slow_handler);
+		zassert_equal(k_work_submit_to_queue(&pool_queue, &items[i]), 1);
+	}
+
+	wait_done(NUM_THREADS);
+
+	zassert_equal(atomic_get(&runs), NUM_THREADS);
+	zassert_equal(atomic_get(&max_active), NUM_THREADS,
+		      "Items did not run concurrently");
+}
+
+ZTEST(work_pool, test_stealing)
+{
+	int distinct = 0;
+
+	k_work_init(&items[0], spawn_handler);
+	for (int i = 1; i < NUM_ITEMS; i++) {
+		k_work_init(&items[i], slow_handler);
+	}
+
+	/* All items are submitted to the thread running the first one */
+	zassert_equal(k_work_submit_to_queue(&pool_queue, &items[0]), 1);
+	wait_done(NUM_ITEMS);
+
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		bool seen = false;
+
+		for (int j = 0; j < i; j++) {
+			seen = seen || (runners[j] == runners[i]);
+		}
+		distinct += seen ? 0 : 1;
+	}
+
+	zassert_equal(atomic_get(&runs), NUM_ITEMS);
+	zassert_equal(distinct, NUM_THREADS, "Idle threads did not steal");
+}
+
+ZTEST(work_pool, test_no_self_concurrency)
+{
+	k_work_init(&items[0], self_handler);
+
+	/* The item resubmits itself while other threads are idle, and is
+	 * resubmitted from here while it runs.
+	 */
+	zassert_equal(k_work_submit_to_queue(&pool_queue, &items[0]), 1);
+	while (atomic_get(&runs) < 10) {
+		(void)k_work_submit_to_queue(&pool_queue, &items[0]);
+		k_msleep(1);
+	}
+
+	while (k_work_flush(&items[0], &work_sync)) {
+	}
+
+	zassert_equal(atomic_get(&overlaps), 0, "Item ran concurrently with itself");
+	zassert_equal(k_work_busy_get(&items[0]), 0);
+}
+
+ZTEST(work_pool, test_flush)
+{
+	k_work_init(&items[0], slow_handler);
+
+	zassert_equal(k_work_submit_to_queue(&pool_queue, &items[0]), 1);
+	k_msleep(RUN_MS / 4);
+	zassert_equal(k_work_busy_get(&items[0]), K_WORK_RUNNING);
+
+	/* Flushing waits for the run in progress and the queued one */
+	zassert_equal(k_work_submit_to_queue(&pool_queue, &items[0]), 2);
+	zassert_true(k_work_flush(&items[0], &work_sync));
+
+	zassert_equal(atomic_get(&runs), 2);
+	zassert_equal(k_work_busy_get(&items[0]), 0);
+	zassert_false(k_work_flush(&items[0], &work_sync));
+}
+
+ZTEST(work_pool, test_cancel_sync)
+{
+	k_work_init(&items[0], slow_handler);
+
+	zassert_equal(k_work_submit_to_queue(&pool_queue, &items[0]), 1);
+	k_msleep(RUN_MS / 4);
+	zassert_equal(k_work_submit_to_queue(&pool_queue, &items[0]), 2);
+
+	/* The queued run is dropped, the one in progress completes */
+	zassert_true(k_work_cancel_sync(&items[0], &work_sync));
+
+	zassert_equal(atomic_get(&runs), 1);
+	zassert_equal(k_work_busy_get(&items[0]), 0);
+}
+
+static void flusher_entry(void *p1, void *p2, void *p3)
+{
+	zassert_true(k_work_flush(&items[0], &work_sync));
+	k_sem_give(p1);
+}
+
+ZTEST(work_pool, test_flush_canceled)
+{
+	static K_THREAD_STACK_DEFINE(flusher_stack, STACK_SIZE);
+	static struct k_thread flusher_thread;
+	struct k_sem flushed;
+
+	k_sem_init(&flushed, 0, 1);
+	k_work_init(&items[0], slow_handler);
+
+	/* Keep every thread busy so that the item stays queued */
+	for (int i = 1; i <= NUM_THREADS; i++) {
+		k_work_init(&items[i], slow_handler);
+		zassert_equal(k_work_submit_to_queue(&pool_queue, &items[i]), 1);
+	}
+	k_msleep(RUN_MS / 4);
+	zassert_equal(k_work_submit_to_queue(&pool_queue, &items[0]), 1);
+
+	k_thread_create(&flusher_thread, flusher_stack, STACK_SIZE,
+			flusher_entry, &flushed, NULL, NULL,
+			K_PRIO_COOP(0), 0, K_NO_WAIT);
+	k_msleep(1);
+	zassert_equal(k_sem_take(&flushed, K_NO_WAIT), -EBUSY);
+
+	/* Canceling the queued item releases the flush waiting for it */
+	zassert_equal(k_work_cancel(&items[0]), 0);
+	zassert_ok(k_sem_take(&flushed, K_MSEC(RUN_MS / 4)));
+	k_thread_join(&flusher_thread, K_FOREVER);
+
+	wait_done(NUM_THREADS);
+	zassert_equal(atomic_get(&runs), NUM_THREADS);
+}
+
+ZTEST(work_pool, test_drain)
+{
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		k_work_init(&items[i], slow_handler);
+		zassert_equal(k_work_submit_to_queue(&pool_queue, &items[i]), 1);
+	}
+
+	zassert_equal(k_work_queue_drain(&pool_queue, true), 1);
+	zassert_equal(atomic_get(&runs), NUM_ITEMS);
+	zassert_equal(k_work_submit_to_queue(&pool_queue, &items[0]), -EBUSY);
+	zassert_ok(k_work_queue_unplug(&pool_queue));
+	k_sem_reset(&done_sem);
+}
+
+ZTEST(work_pool, test_add_worker_not_started)
+{
+	static struct k_work_q queue;
+	static struct k_work_q_worker worker;
+
+	k_work_queue_init(&queue);
+	zassert_equal(k_work_queue_add_worker(&queue, &worker, worker_stacks[0],
+					      STACK_SIZE, -1), -ENODEV);
+}
+
+static void *work_pool_setup(void)
+{
+	k_work_queue_start(&pool_queue, queue_stack,
+			   K_THREAD_STACK_SIZEOF(queue_stack), QUEUE_PRIORITY,
+			   NULL);
+
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		int cpu = IS_ENABLED(CONFIG_SCHED_CPU_MASK) ?
+			  (i + 1) % arch_num_cpus() : -1;
+
+		zassert_ok(k_work_queue_add_worker(&pool_queue, &workers[i],
+						   worker_stacks[i],
+						   K_THREAD_STACK_SIZEOF(worker_stacks[i]),
+						   cpu));
+	}
+
+	return NULL;
+}
+
+static void work_pool_before(void *fixture)
+{
+	atomic_clear(&active);
+	atomic_clear(&max_active);
+	atomic_clear(&runs);
+	atomic_clear(&overlaps);
+	k_sem_reset(&done_sem);
+}
+
+ZTEST_SUITE(work_pool, NULL, work_pool_setup, work_pool_before, NULL, NULL);
@@ -712,6 +712,45 @@ ZTEST(log_buffer, test_item_alloc_preemption)
 	item_alloc_preemption(false);
 }
 
+void item_free_clears_space(bool pow2)
+{
+	struct mpsc_pbuf_buffer buffer;
+	struct test_data_var *p;
+	uint32_t len = 7;
+
+	init(&buffer, 32 - !pow2, false);
+
+	/* Wrap a few times, to also have skip packets. */
+	for (int i = 0; i < 10; i++) {
+		p = (struct test_data_var *)mpsc_pbuf_alloc(&buffer, len, K_NO_WAIT);
+		zassert_true(p);
+		p->hdr.len = len;
+		p->hdr.data = i + 1;
+		for (int j = 0; j < len - 1; j++) {
+			p->data[j] = 0xAAAAAAAA;
+		}
+		mpsc_pbuf_commit(&buffer, (union mpsc_pbuf_generic *)p);
+
+		p = (struct test_data_var *)mpsc_pbuf_claim(&buffer);
+		zassert_true(p);
+		zassert_equal(p->hdr.data, i + 1);
+		mpsc_pbuf_free(&buffer, (union mpsc_pbuf_generic *)p);
+	}
+
+	/* Allocation without the lock relies on free space reading as an
+	 * invalid packet until the header is written.
+	 */
+	for (int i = 0; i < buffer.size; i++) {
+		zassert_equal(buf32[i], 0, "word %d not cleared", i);
+	}
+}
+
+ZTEST(log_buffer, test_item_free_clears_space)
+{
+	item_free_clears_space(true);
+	item_free_clears_space(false);
+}
+
 void overwrite(bool pow2)
 {
 	struct test_data_var *p;
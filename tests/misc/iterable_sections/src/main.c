@@ -163,4 +163,36 @@ ZTEST(iterable_sections, test_rom)
 	zassert_equal(out, ROM_EXPECT, "Check value incorrect (got: 0x%x)", out);
 }
 
+static int test_rom_cmp(const void *key, const void *elem)
+{
+	return *(const int *)key - ((const struct test_rom_named *)elem)->i;
+}
+
+/**
+ *
+ * @brief Test binary search in a section sorted by custom name.
+ *
+ */
+ZTEST(iterable_sections, test_bsearch)
+{
+	const struct test_rom_named *t;
+	int key;
+
+	for (key = 0x10; key <= 0x40; key += 0x10) {
+		STRUCT_SECTION_BSEARCH(test_rom_named, &key, test_rom_cmp, &t);
+		zassert_not_null(t, "0x%x not found", key);
+		zassert_equal(t->i, key, "Found 0x%x instead of 0x%x", t->i, key);
+	}
+
+	for (key = 0x08; key <= 0x48; key += 0x10) {
+		STRUCT_SECTION_BSEARCH(test_rom_named, &key, test_rom_cmp, &t);
+		zassert_is_null(t, "0x%x found", key);
+	}
+
+	key = 0x20;
+	STRUCT_SECTION_BSEARCH_ALTERNATE(test_rom_named, test_rom_named, &key,
+					 test_rom_cmp, &t);
+	zassert_equal_ptr(t, &rom9, "Unexpected element");
+}
+
 ZTEST_SUITE(iterable_sections, NULL, NULL, NULL, NULL, NULL);
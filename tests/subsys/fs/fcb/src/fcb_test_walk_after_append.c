@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "fcb_test.h"
+
+static void test_fcb_append_one(struct fcb *_fcb, int len)
+{
+	int rc;
+	struct fcb_entry loc;
+	uint8_t test_data[16];
+	int i;
+
+	for (i = 0; i < len; i++) {
+		test_data[i] = fcb_test_append_data(len, i);
+	}
+	rc = fcb_append(_fcb, len, &loc);
+	zassert_true(rc == 0, "fcb_append call failure");
+	rc = flash_area_write(_fcb->fap, FCB_ENTRY_FA_DATA_OFF(loc),
+			      test_data, len);
+	zassert_true(rc == 0, "flash_area_write call failure");
+	rc = fcb_append_finish(_fcb, &loc);
+	zassert_true(rc == 0, "fcb_append_finish call failure");
+}
+
+/*
+ * Walks have to see entries appended, and stop seeing entries cleared or
+ * rotated out, after the previous walk, regardless of what has been read
+ * from flash in advance.
+ */
+ZTEST(fcb_test_with_4sectors_set, test_fcb_walk_after_append)
+{
+	struct fcb *fcb;
+	int var_cnt;
+	int rc;
+	int i;
+
+	fcb = &test_fcb;
+
+	for (i = 0; i < 3; i++) {
+		test_fcb_append_one(fcb, i);
+	}
+
+	var_cnt = 0;
+	rc = fcb_walk(fcb, 0, fcb_test_data_walk_cb, &var_cnt);
+	zassert_true(rc == 0, "fcb_walk call failure");
+	zassert_equal(var_cnt, 3, "unexpected entry count");
+
+	test_fcb_append_one(fcb, 3);
+
+	var_cnt = 0;
+	rc = fcb_walk(fcb, 0, fcb_test_data_walk_cb, &var_cnt);
+	zassert_true(rc == 0, "fcb_walk call failure");
+	zassert_equal(var_cnt, 4, "appended entry not walked");
+
+	rc = fcb_clear(fcb);
+	zassert_true(rc == 0, "fcb_clear call failure");
+
+	rc = fcb_walk(fcb, 0, fcb_test_empty_walk_cb, NULL);
+	zassert_true(rc == 0, "fcb_walk call failure");
+
+	test_fcb_append_one(fcb, 0);
+
+	var_cnt = 0;
+	rc = fcb_walk(fcb, 0, fcb_test_data_walk_cb, &var_cnt);
+	zassert_true(rc == 0, "fcb_walk call failure");
+	zassert_equal(var_cnt, 1, "entry appended after clear not walked");
+}
+
+static void test_fcb_walk_cnt(struct fcb *_fcb, int *cnts)
+{
+	struct append_arg aa_arg = {
+		.elem_cnts = cnts
+	};
+	int rc;
+
+	(void)memset(cnts, 0, 4 * sizeof(cnts[0]));
+	rc = fcb_walk(_fcb, NULL, fcb_test_cnt_elems_cb, &aa_arg);
+	zassert_true(rc == 0, "fcb_walk call failure");
+}
+
+ZTEST(fcb_test_with_4sectors_set, test_fcb_walk_after_rotate)
+{
+	struct fcb *fcb;
+	int elem_cnt = 0;
+	int cnts[4];
+	int rc;
+
+	fcb = &test_fcb;
+
+	/* Fill the first sector, the last entry starts the second one */
+	do {
+		test_fcb_append_one(fcb, elem_cnt % 16);
+		elem_cnt++;
+	} while (fcb->f_active.fe_sector == &test_fcb_sector[0]);
+
+	test_fcb_walk_cnt(fcb, cnts);
+	zassert_equal(cnts[0], elem_cnt - 1, "unexpected entry count");
+	zassert_equal(cnts[1], 1, "unexpected entry count");
+
+	rc = fcb_rotate(fcb);
+	zassert_true(rc == 0, "fcb_rotate call failure");
+
+	test_fcb_walk_cnt(fcb, cnts);
+	zassert_equal(cnts[0], 0, "rotated out entries walked");
+	zassert_equal(cnts[1], 1, "unexpected entry count");
+
+	test_fcb_append_one(fcb, 1);
+
+	test_fcb_walk_cnt(fcb, cnts);
+	zassert_equal(cnts[0], 0, "rotated out entries walked");
+	zassert_equal(cnts[1], 2, "appended entry not walked");
+}
@@ -225,6 +225,31 @@ ZTEST(test_log_core_additional, test_log_domain_id)
 		      "Unexpected amount of messages received by the backend");
 }
 
+/* Instance names sorted differently than strcmp() does, as the linker sorts
+ * them with the dot replaced by an underscore.
+ */
+LOG_INSTANCE_REGISTER(log_test, a, LOG_LEVEL_INF);
+LOG_INSTANCE_REGISTER(log_test, a0, LOG_LEVEL_INF);
+LOG_INSTANCE_REGISTER(log_test, a_b, LOG_LEVEL_INF);
+LOG_INSTANCE_REGISTER(log_test, aa, LOG_LEVEL_INF);
+
+ZTEST(test_log_core_additional, test_log_source_id_get)
+{
+	uint32_t cnt = log_src_cnt_get(Z_LOG_LOCAL_DOMAIN_ID);
+
+	for (uint32_t i = 0; i < cnt; i++) {
+		const char *name = log_source_name_get(Z_LOG_LOCAL_DOMAIN_ID, i);
+
+		zassert_equal(log_source_id_get(name), i, "%s not found", name);
+	}
+
+	zassert_true(log_source_id_get("log_test.a_b") >= 0);
+	zassert_equal(log_source_id_get("log_test_a"), -1);
+	zassert_equal(log_source_id_get("log_test.a.b"), -1);
+	zassert_equal(log_source_id_get("log_tes"), -1);
+	zassert_equal(log_source_id_get(""), -1);
+}
+
 /**
  * @brief Synchronous processing of logging messages.
  *
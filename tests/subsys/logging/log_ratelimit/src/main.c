@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Module specific limits, must be defined before the logging header. */
+#define LOG_RATELIMIT_BURST 5
+#define LOG_RATELIMIT_RATE 10
+#define LOG_RATELIMIT_LEVEL LOG_LEVEL_WRN
+
+#include <string.h>
+
+#include <zephyr/ztest.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/sys/cbprintf.h>
+
+LOG_MODULE_REGISTER(test, LOG_LEVEL_INF);
+
+#define FLOOD_CNT 20
+
+static uint32_t msg_cnt;
+static char last_msg[64];
+static char summary_msg[64];
+static size_t out_len;
+
+static int out_func(int c, void *ctx)
+{
+	char *buf = ctx;
+
+	if (out_len < sizeof(last_msg) - 1) {
+		buf[out_len++] = (char)c;
+		buf[out_len] = '\0';
+	}
+
+	return c;
+}
+
+static void test_process(const struct log_backend *const backend,
+			 union log_msg_generic *msg)
+{
+	size_t len;
+	uint8_t *package = log_msg_get_package(&msg->log, &len);
+
+	msg_cnt++;
+	out_len = 0;
+	last_msg[0] = '\0';
+	(void)cbpprintf(out_func, last_msg, package);
+
+	if (strstr(last_msg, "suppressed") != NULL) {
+		strcpy(summary_msg, last_msg);
+	}
+}
+
+static const struct log_backend_api test_backend_api = {
+	.process = test_process,
+};
+
+LOG_BACKEND_DEFINE(test_backend, test_backend_api, true);
+
+static void flush(void)
+{
+	while (log_process()) {
+	}
+}
+
+ZTEST(log_ratelimit, test_burst)
+{
+	for (int i = 0; i < FLOOD_CNT; i++) {
+		LOG_WRN("flood %d", i);
+	}
+	flush();
+
+	zassert_equal(msg_cnt, LOG_RATELIMIT_BURST,
+		      "Unexpected number of messages: %u", msg_cnt);
+	zassert_equal(strcmp(last_msg, "flood 4"), 0, "Unexpected message: %s",
+		      last_msg);
+}
+
+ZTEST(log_ratelimit, test_refill_and_summary)
+{
+	for (int j = 0; j < 2; j++) {
+		for (int i = 0; i < FLOOD_CNT; i++) {
+			LOG_INF("flood %d", i);
+		}
+		flush();
+
+		if (j == 0) {
+			zassert_equal(msg_cnt, LOG_RATELIMIT_BURST);
+			zassert_equal(summary_msg[0], '\0');
+			/* Time for a single token */
+			k_msleep(MSEC_PER_SEC / LOG_RATELIMIT_RATE);
+			msg_cnt = 0;
+		}
+	}
+
+	/* One message passed, preceded by the summary */
+	zassert_equal(msg_cnt, 2, "Unexpected number of messages: %u", msg_cnt);
+	zassert_equal(strcmp(summary_msg, "15 messages suppressed"), 0,
+		      "Unexpected summary: %s", summary_msg);
+	zassert_equal(strcmp(last_msg, "flood 0"), 0, "Unexpected message: %s",
+		      last_msg);
+}
+
+ZTEST(log_ratelimit, test_independent_call_sites)
+{
+	for (int i = 0; i < FLOOD_CNT; i++) {
+		LOG_WRN("first %d", i);
+		LOG_WRN("second %d", i);
+	}
+	flush();
+
+	zassert_equal(msg_cnt, 2 * LOG_RATELIMIT_BURST,
+		      "Unexpected number of messages: %u", msg_cnt);
+}
+
+ZTEST(log_ratelimit, test_level_not_limited)
+{
+	for (int i = 0; i < FLOOD_CNT; i++) {
+		LOG_ERR("error %d", i);
+	}
+	flush();
+
+	zassert_equal(msg_cnt, FLOOD_CNT, "Unexpected number of messages: %u",
+		      msg_cnt);
+}
+
+static void before(void *unused)
+{
+	flush();
+	msg_cnt = 0;
+	summary_msg[0] = '\0';
+}
+
+ZTEST_SUITE(log_ratelimit, NULL, NULL, before, NULL, NULL);
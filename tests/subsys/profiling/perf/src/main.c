@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/ztest.h>
+#include <zephyr/profiling/perf.h>
+
+#define RECORD_MS 500
+#define FREQUENCY 500
+/* Upper bound of the size of the code of the busy function */
+#define BUSY_FUNC_SIZE 256
+
+static uint8_t dump_buf[sizeof(struct perf_dump_header) +
+			sizeof(struct perf_dump_cpu_header) * CONFIG_MP_MAX_NUM_CPUS +
+			sizeof(uintptr_t) * CONFIG_PROFILING_PERF_BUFFER_SIZE *
+			CONFIG_MP_MAX_NUM_CPUS];
+static size_t dump_len;
+
+static void dump_cb(const uint8_t *data, size_t len, void *user_data)
+{
+	zassert_true(dump_len + len <= sizeof(dump_buf));
+	memcpy(&dump_buf[dump_len], data, len);
+	dump_len += len;
+}
+
+static volatile uint32_t busy_cnt;
+
+static void __attribute__((noinline)) busy_func(uint32_t ms)
+{
+	int64_t end = k_uptime_get() + ms;
+
+	while (k_uptime_get() < end) {
+		for (int i = 0; i < 100; i++) {
+			busy_cnt++;
+		}
+		/* Simulated time only passes when waiting */
+		if (IS_ENABLED(CONFIG_ARCH_POSIX)) {
+			k_busy_wait(10);
+		}
+	}
+}
+
+static bool in_busy_func(uintptr_t addr)
+{
+	/* Clear the Thumb bit */
+	uintptr_t start = (uintptr_t)busy_func & ~(uintptr_t)1;
+
+	return addr >= start && addr < start + BUSY_FUNC_SIZE;
+}
+
+ZTEST(perf, test_record)
+{
+	const struct perf_dump_header *header = (const void *)dump_buf;
+	const struct perf_dump_cpu_header *cpu_header;
+	const uintptr_t *words;
+	uint32_t samples = 0;
+	uint32_t hits = 0;
+
+	zassert_ok(perf_start(FREQUENCY, K_FOREVER));
+	zassert_true(perf_is_running());
+	busy_func(RECORD_MS);
+	zassert_ok(perf_stop());
+
+	dump_len = 0;
+	zassert_ok(perf_dump(dump_cb, NULL));
+
+	zassert_equal(header->magic, PERF_DUMP_MAGIC);
+	zassert_equal(header->version, PERF_DUMP_VERSION);
+	zassert_equal(header->word_size, sizeof(uintptr_t));
+	zassert_equal(header->num_cpus, arch_num_cpus());
+	zassert_equal(header->frequency, FREQUENCY);
+
+	cpu_header = (const void *)&header[1];
+	for (unsigned int cpu = 0; cpu < header->num_cpus; cpu++) {
+		uint32_t pos = 0;
+
+		zassert_equal(cpu_header->cpu, cpu);
+		words = (const uintptr_t *)&cpu_header[1];
+
+		while (pos < cpu_header->words) {
+			uintptr_t depth = words[pos++];
+			bool hit = false;
+
+			zassert_true(depth > 0 && pos + depth <= cpu_header->words,
+				     "Corrupted sample");
+			for (uintptr_t i = 0; i < depth; i++) {
+				hit = hit || in_busy_func(words[pos + i]);
+			}
+			hits += hit ? 1 : 0;
+			samples++;
+			pos += depth;
+		}
+
+		zassert_equal(samples, cpu_header->samples);
+		cpu_header = (const void *)&words[cpu_header->words];
+	}
+
+	/* Allow for the ticks lost in the kernel and interrupt handling */
+	zassert_true(samples >= RECORD_MS * FREQUENCY / MSEC_PER_SEC / 2,
+		     "Only %u samples", samples);
+	zassert_true(hits >= samples / 2, "Only %u of %u samples in busy_func",
+		     hits, samples);
+}
+
+ZTEST(perf, test_duration)
+{
+	zassert_ok(perf_start(FREQUENCY, K_MSEC(50)));
+	zassert_equal(perf_start(FREQUENCY, K_FOREVER), -EALREADY);
+	zassert_equal(perf_dump(dump_cb, NULL), -EBUSY);
+
+	k_msleep(100);
+
+	zassert_false(perf_is_running());
+	zassert_equal(perf_stop(), -EALREADY);
+}
+
+ZTEST(perf, test_invalid_frequency)
+{
+	zassert_equal(perf_start(0, K_FOREVER), -EINVAL);
+	zassert_equal(perf_start(CONFIG_SYS_CLOCK_TICKS_PER_SEC + 1, K_FOREVER),
+		      -EINVAL);
+	zassert_false(perf_is_running());
+}
+
+ZTEST_SUITE(perf, NULL, NULL, NULL, NULL, NULL);
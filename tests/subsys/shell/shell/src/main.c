@@ -489,6 +489,40 @@ ZTEST(sh, test_section_cmd)
 	test_shell_execute_cmd("section_cmd cmd1 sub_cmd2", -EINVAL);
 }
 
+static int cmd_lookup_handler(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(sh);
+	ARG_UNUSED(argc);
+
+	return strlen(argv[0]);
+}
+
+/* The linker sorts root commands by name followed by an underscore, which
+ * orders these differently than strcmp() does.
+ */
+SHELL_CMD_REGISTER(lookup, NULL, NULL, cmd_lookup_handler);
+SHELL_CMD_REGISTER(lookup0, NULL, NULL, cmd_lookup_handler);
+SHELL_CMD_REGISTER(lookup_a, NULL, NULL, cmd_lookup_handler);
+SHELL_CMD_REGISTER(lookupA, NULL, NULL, cmd_lookup_handler);
+SHELL_CMD_REGISTER(lookupa, NULL, NULL, cmd_lookup_handler);
+SHELL_CMD_REGISTER(lookupa0, NULL, NULL, cmd_lookup_handler);
+
+ZTEST(sh, test_root_cmd_lookup)
+{
+	test_shell_execute_cmd("lookup", 6);
+	test_shell_execute_cmd("lookup0", 7);
+	test_shell_execute_cmd("lookup_a", 8);
+	test_shell_execute_cmd("lookupA", 7);
+	test_shell_execute_cmd("lookupa", 7);
+	test_shell_execute_cmd("lookupa0", 8);
+	test_shell_execute_cmd("lookup_", -ENOEXEC);
+	test_shell_execute_cmd("lookupb", -ENOEXEC);
+	test_shell_execute_cmd("lookupa_", -ENOEXEC);
+	test_shell_execute_cmd("looku", -ENOEXEC);
+	test_shell_execute_cmd("a", -ENOEXEC);
+	test_shell_execute_cmd("zzz", -ENOEXEC);
+}
+
 static void *shell_setup(void)
 {
 	const struct shell *sh = shell_backend_dummy_get_ptr();
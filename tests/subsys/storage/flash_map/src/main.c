@@ -190,4 +190,80 @@ ZTEST(flash_map, test_flash_area_erased_val)
 	flash_area_close(fa);
 }
 
+ZTEST(flash_map, test_flash_area_cache)
+{
+#ifdef CONFIG_FLASH_MAP_CACHE
+	struct flash_area_cache_stats stats;
+	const struct flash_area *fa;
+	uint8_t wd[CONFIG_FLASH_MAP_CACHE_PAGE_SIZE];
+	uint8_t rd[16];
+	off_t off;
+	int rc;
+
+	rc = flash_area_open(SLOT1_PARTITION_ID, &fa);
+	zassert_true(rc == 0, "flash_area_open() fail");
+
+	rc = flash_area_erase(fa, 0, fa->fa_size);
+	zassert_true(rc == 0, "flash_area_erase() fail");
+
+	for (off = 0; off < sizeof(wd); off++) {
+		wd[off] = (uint8_t)off;
+	}
+	rc = flash_area_write(fa, 0, wd, sizeof(wd));
+	zassert_true(rc == 0, "flash_area_write() fail");
+
+	flash_area_cache_invalidate();
+	flash_area_cache_stats_reset();
+
+	/* Small sequential reads within one page miss only once */
+	for (off = 0; off < sizeof(wd); off += sizeof(rd)) {
+		rc = flash_area_read(fa, off, rd, sizeof(rd));
+		zassert_true(rc == 0, "flash_area_read() fail");
+		zassert_mem_equal(rd, &wd[off], sizeof(rd), "read data != write data");
+	}
+
+	flash_area_cache_stats_get(&stats);
+	zassert_equal(stats.misses, 1, "unexpected number of misses");
+	zassert_equal(stats.hits, sizeof(wd) / sizeof(rd) - 1,
+		      "unexpected number of hits");
+
+	/* Read spanning two pages fetches the second one */
+	rc = flash_area_read(fa, sizeof(wd) - sizeof(rd) / 2, rd, sizeof(rd));
+	zassert_true(rc == 0, "flash_area_read() fail");
+	zassert_mem_equal(rd, &wd[sizeof(wd) - sizeof(rd) / 2], sizeof(rd) / 2,
+			  "read data != write data");
+	flash_area_cache_stats_get(&stats);
+	zassert_equal(stats.misses, 2, "unexpected number of misses");
+
+	/* Erase has to drop the cached copy */
+	rc = flash_area_erase(fa, 0, fa->fa_size);
+	zassert_true(rc == 0, "flash_area_erase() fail");
+	flash_area_cache_stats_get(&stats);
+	zassert_equal(stats.invalidations, 2, "pages not invalidated on erase");
+
+	rc = flash_area_read(fa, 0, rd, sizeof(rd));
+	zassert_true(rc == 0, "flash_area_read() fail");
+	for (off = 0; off < sizeof(rd); off++) {
+		zassert_equal(rd[off], flash_area_erased_val(fa), "stale data read");
+	}
+
+	/* Write has to drop the cached copy */
+	rc = flash_area_write(fa, 0, wd, sizeof(wd));
+	zassert_true(rc == 0, "flash_area_write() fail");
+	rc = flash_area_read(fa, 0, rd, sizeof(rd));
+	zassert_true(rc == 0, "flash_area_read() fail");
+	zassert_mem_equal(rd, wd, sizeof(rd), "stale data read");
+
+	/* Large reads go directly to the device */
+	rc = flash_area_read(fa, 0, wd, sizeof(wd));
+	zassert_true(rc == 0, "flash_area_read() fail");
+	flash_area_cache_stats_get(&stats);
+	zassert_equal(stats.bypasses, 1, "large read not bypassed");
+
+	flash_area_close(fa);
+#else
+	ztest_test_skip();
+#endif
+}
+
 ZTEST_SUITE(flash_map, NULL, NULL, NULL, NULL, NULL);
@@ -10,6 +10,7 @@
 #include <zephyr/ztest.h>
 #include <zephyr/drivers/flash.h>
 #include <zephyr/settings/settings.h>
+#include <zephyr/storage/flash_map.h>
 
 #include <zephyr/storage/stream_flash.h>
 
@@ -643,6 +644,93 @@ ZTEST(lib_stream_flash, test_stream_flash_progress_clear)
 #endif
 }
 
+ZTEST(lib_stream_flash, test_stream_flash_async_buffered_write)
+{
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	static uint8_t async_buf[BUF_LEN * 2];
+	int rc;
+
+	init_target();
+
+	rc = stream_flash_init_async(&ctx, fdev, async_buf, BUF_LEN, 1,
+				     FLASH_BASE, 0, NULL);
+	zassert_true(rc < 0, "should fail with single buffer");
+
+	rc = stream_flash_init_async(&ctx, fdev, async_buf, BUF_LEN,
+				     ARRAY_SIZE(async_buf) / BUF_LEN,
+				     FLASH_BASE, 0, NULL);
+	zassert_equal(rc, 0, "expected success");
+
+	/* Cross several buffer borders, leaving some data in the buffer */
+	rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN * 3 + 128,
+					 false);
+	zassert_equal(rc, 0, "expected success");
+
+	rc = stream_flash_wait(&ctx);
+	zassert_equal(rc, 0, "expected success");
+	zassert_equal(stream_flash_bytes_written(&ctx), BUF_LEN * 3,
+		      "queued buffers should be written");
+	VERIFY_WRITTEN(0, BUF_LEN * 3);
+	VERIFY_ERASED(BUF_LEN * 3, BUF_LEN);
+
+	/* Flush writes out the partially filled buffer and waits for it */
+	rc = stream_flash_buffered_write(&ctx, write_buf, 0, true);
+	zassert_equal(rc, 0, "expected success");
+	zassert_equal(stream_flash_bytes_written(&ctx), BUF_LEN * 3 + 128,
+		      "all data should be written");
+	VERIFY_WRITTEN(0, BUF_LEN * 3 + 128);
+
+	/* Re-initializing drops the buffers still queued */
+	rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN * 2, false);
+	zassert_equal(rc, 0, "expected success");
+
+	rc = stream_flash_init_async(&ctx, fdev, async_buf, BUF_LEN,
+				     ARRAY_SIZE(async_buf) / BUF_LEN,
+				     FLASH_BASE, 0, NULL);
+	zassert_equal(rc, 0, "expected success");
+	zassert_equal(stream_flash_bytes_written(&ctx), 0,
+		      "the new stream should start empty");
+
+	rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN, true);
+	zassert_equal(rc, 0, "expected success");
+	zassert_equal(stream_flash_bytes_written(&ctx), BUF_LEN,
+		      "only the new stream should be written");
+#else
+	ztest_test_skip();
+#endif
+}
+
+ZTEST(lib_stream_flash, test_stream_flash_cache_invalidate)
+{
+#ifdef CONFIG_FLASH_MAP_CACHE
+	const struct flash_area fa = {
+		.fa_dev = fdev,
+		.fa_off = FLASH_BASE,
+		.fa_size = TESTBUF_SIZE,
+	};
+	uint8_t byte;
+	int rc;
+
+	init_target();
+	/* The target was erased through the flash driver */
+	flash_area_cache_invalidate();
+
+	rc = flash_area_read(&fa, 0, &byte, sizeof(byte));
+	zassert_equal(rc, 0, "expected success");
+	zassert_equal(byte, erased_pattern[0], "should read erased flash");
+
+	/* The write must drop the page cached by the read above */
+	rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN, true);
+	zassert_equal(rc, 0, "expected success");
+
+	rc = flash_area_read(&fa, 0, &byte, sizeof(byte));
+	zassert_equal(rc, 0, "expected success");
+	zassert_equal(byte, written_pattern[0], "should read written flash");
+#else
+	ztest_test_skip();
+#endif
+}
+
 void lib_stream_flash_before(void *data)
 {
 	zassume_true(device_is_ready(fdev), "Device is not ready");
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/byteorder.h>
+#include <ctf_top.h>
+
+#define EXTENDED_HEADER_ID 0xFF
+#define SEM_GIVES 16
+/* Longer than the range of a compact timestamp */
+#define LONG_WAIT_US 100000
+
+extern uint8_t ram_tracing[CONFIG_RAM_TRACING_BUFFER_SIZE];
+
+static K_SEM_DEFINE(test_sem, 0, SEM_GIVES + 1);
+
+/* Size of the fields of events which can occur during the test */
+static int fields_size(uint8_t id)
+{
+	switch (id) {
+	case CTF_EVENT_THREAD_SWITCHED_OUT:
+	case CTF_EVENT_THREAD_SWITCHED_IN:
+	case CTF_EVENT_THREAD_READY:
+	case CTF_EVENT_THREAD_PENDING:
+		return sizeof(uint32_t) + sizeof(ctf_bounded_string_t);
+	case CTF_EVENT_ISR_ENTER:
+	case CTF_EVENT_ISR_EXIT:
+	case CTF_EVENT_ISR_EXIT_TO_SCHEDULER:
+	case CTF_EVENT_IDLE:
+		return 0;
+	case CTF_EVENT_SEMAPHORE_GIVE_ENTER:
+	case CTF_EVENT_SEMAPHORE_GIVE_EXIT:
+	case CTF_EVENT_TIMER_STOP:
+		return sizeof(uint32_t);
+	case CTF_EVENT_SEMAPHORE_TAKE_ENTER:
+	case CTF_EVENT_SEMAPHORE_TAKE_BLOCKING:
+		return 2 * sizeof(uint32_t);
+	case CTF_EVENT_SEMAPHORE_TAKE_EXIT:
+	case CTF_EVENT_TIMER_START:
+		return 3 * sizeof(uint32_t);
+	default:
+		return -1;
+	}
+}
+
+/* Find the first event of the test, giving the semaphore */
+static const uint8_t *find_start(void)
+{
+	uint32_t sem_id = (uint32_t)(uintptr_t)&test_sem;
+
+	for (size_t i = 6; i < sizeof(ram_tracing) - sizeof(sem_id); i++) {
+		const uint8_t *p = &ram_tracing[i];
+
+		if (sys_get_le32(p) != sem_id) {
+			continue;
+		}
+		if (p[-3] == CTF_EVENT_SEMAPHORE_GIVE_ENTER) {
+			return &p[-3];
+		}
+		if (p[-6] == EXTENDED_HEADER_ID &&
+		    p[-5] == CTF_EVENT_SEMAPHORE_GIVE_ENTER) {
+			return &p[-6];
+		}
+	}
+
+	return NULL;
+}
+
+ZTEST(tracing_ctf, test_compact_header)
+{
+	const uint8_t *p;
+	const uint8_t *end = &ram_tracing[sizeof(ram_tracing)];
+	uint32_t tstamp = 0;
+	uint32_t prev_tstamp = 0;
+	uint32_t long_wait_tstamp = 0;
+	int compact = 0;
+	int extended = 0;
+	int gives = 0;
+
+	for (int i = 0; i < SEM_GIVES; i++) {
+		if (i == SEM_GIVES / 2) {
+			long_wait_tstamp = k_cycle_get_32();
+			k_busy_wait(LONG_WAIT_US);
+		}
+		k_sem_give(&test_sem);
+	}
+
+	/* Let the tracing thread drain the buffers */
+	k_msleep(10);
+
+	p = find_start();
+	zassert_not_null(p, "Test events not found");
+
+	/* Reconstruct timestamps the way a CTF reader does */
+	while (p < end && p[0] != 0 && gives < SEM_GIVES) {
+		uint8_t id;
+		int size;
+
+		if (p[0] == EXTENDED_HEADER_ID) {
+			id = p[1];
+			tstamp = sys_get_le32(&p[2]);
+			p += 6;
+			extended++;
+		} else {
+			uint16_t low = sys_get_le16(&p[1]);
+
+			id = p[0];
+			tstamp = (tstamp & ~0xffffU) | low;
+			if (low < (prev_tstamp & 0xffffU)) {
+				tstamp += BIT(16);
+			}
+			p += 3;
+			compact++;
+		}
+
+		zassert_true(tstamp - prev_tstamp < BIT(31) || gives == 0,
+			     "Timestamp going backward");
+
+		size = fields_size(id);
+		zassert_true(size >= 0, "Unexpected event %x", id);
+
+		/* Asynchronous tracing also gives the semaphore of its thread */
+		if (id == CTF_EVENT_SEMAPHORE_GIVE_ENTER &&
+		    sys_get_le32(p) == (uint32_t)(uintptr_t)&test_sem) {
+			if (gives == SEM_GIVES / 2) {
+				zassert_true(tstamp - long_wait_tstamp >=
+					     k_us_to_cyc_floor32(LONG_WAIT_US),
+					     "Wrong timestamp after long wait");
+			}
+			gives++;
+		}
+
+		prev_tstamp = tstamp;
+		p += size;
+	}
+
+	zassert_equal(gives, SEM_GIVES, "Found %d of %d events", gives, SEM_GIVES);
+	zassert_true(compact > 0, "No compact header");
+	zassert_true(extended > 0, "No extended header");
+}
+
+ZTEST_SUITE(tracing_ctf, NULL, NULL, NULL, NULL, NULL);